@@ -0,0 +1,146 @@
+// pathfinder/benches/benches/hot_paths.rs
+//
+// Copyright © 2020 The Pathfinder Project Developers.
+//
+// Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+// http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+// <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+// option. This file may not be copied, modified, or distributed
+// except according to those terms.
+
+//! Benchmarks over the CPU hot paths: tiling, stroking, clipping, and paint assembly.
+//!
+//! The scene corpus comes from `resources/svg`, so the numbers track what real content does to
+//! each subsystem. Scene builds go through `Scene::build()` at the D3D9 level with the
+//! sequential executor; at that level nearly all of the build time is spent in the tiler, and
+//! using one thread keeps the numbers stable across machines.
+
+use criterion::{Criterion, criterion_group, criterion_main};
+use pathfinder_color::ColorU;
+use pathfinder_content::clip::clip_line_segment_to_rect;
+use pathfinder_content::gradient::Gradient;
+use pathfinder_content::outline::Outline;
+use pathfinder_content::stroke::{LineCap, LineJoin, OutlineStrokeToFill, StrokeStyle};
+use pathfinder_geometry::line_segment::LineSegment2F;
+use pathfinder_geometry::rect::RectF;
+use pathfinder_geometry::vector::vec2f;
+use pathfinder_renderer::concurrent::executor::SequentialExecutor;
+use pathfinder_renderer::gpu::options::RendererLevel;
+use pathfinder_renderer::options::{BuildOptions, RenderCommandListener};
+use pathfinder_renderer::paint::Paint;
+use pathfinder_renderer::scene::{DrawPathId, Scene, SceneSink};
+use pathfinder_resources::ResourceLoader;
+use pathfinder_resources::fs::FilesystemResourceLoader;
+use pathfinder_svg::SVGScene;
+use usvg::{Options as UsvgOptions, Tree};
+
+static SCENE_CORPUS: &[&str] = &["Ghostscript_Tiger.svg", "paper.svg", "nba-notext.svg"];
+
+fn load_svg_scene(virtual_path: &str) -> Scene {
+    let resource_loader = FilesystemResourceLoader::locate();
+    let data = resource_loader.slurp(&format!("svg/{}", virtual_path)).unwrap();
+    let tree = Tree::from_data(&data, &UsvgOptions::default()).unwrap();
+    SVGScene::from_tree(&tree).scene
+}
+
+fn outlines_of(scene: &Scene) -> Vec<Outline> {
+    (0..scene.draw_path_count())
+        .map(|index| (*scene.get_draw_path(DrawPathId(index)).outline()).clone())
+        .collect()
+}
+
+// Exercises `Tiler::generate_tiles()` on every path of each corpus scene. A fresh sink per
+// iteration keeps the scene build cache from turning later iterations into no-ops.
+fn bench_scene_build(criterion: &mut Criterion) {
+    let mut group = criterion.benchmark_group("scene_build");
+    for &svg_name in SCENE_CORPUS {
+        let mut scene = load_svg_scene(svg_name);
+        group.bench_function(svg_name, |bencher| {
+            bencher.iter(|| {
+                let listener = RenderCommandListener::new(Box::new(|_| {}));
+                let mut sink = SceneSink::new(listener, RendererLevel::D3D9);
+                scene.build(BuildOptions::default(), &mut sink, &SequentialExecutor);
+            })
+        });
+    }
+    group.finish();
+}
+
+// Exercises `OutlineStrokeToFill::offset()` on every outline of each corpus scene.
+fn bench_stroke(criterion: &mut Criterion) {
+    let stroke_style = StrokeStyle {
+        line_width: 4.0,
+        line_cap: LineCap::Round,
+        line_join: LineJoin::Miter(10.0),
+    };
+
+    let mut group = criterion.benchmark_group("stroke");
+    for &svg_name in SCENE_CORPUS {
+        let outlines = outlines_of(&load_svg_scene(svg_name));
+        group.bench_function(svg_name, |bencher| {
+            bencher.iter(|| {
+                for outline in &outlines {
+                    let mut stroke_to_fill = OutlineStrokeToFill::new(outline, stroke_style);
+                    stroke_to_fill.offset();
+                    criterion::black_box(stroke_to_fill.into_outline());
+                }
+            })
+        });
+    }
+    group.finish();
+}
+
+// Exercises segment clipping on every edge of the tiger against its view box. The contour-level
+// polygon clipper is crate-private, so this pins the line-segment primitive it and the tiler
+// are built on.
+fn bench_clip(criterion: &mut Criterion) {
+    let scene = load_svg_scene("Ghostscript_Tiger.svg");
+    let clip_rect = RectF::new(vec2f(100.0, 100.0), vec2f(300.0, 300.0));
+
+    let mut segments = vec![];
+    for outline in outlines_of(&scene) {
+        for contour in outline.contours() {
+            for point_index in 1..contour.len() {
+                segments.push(LineSegment2F::new(contour.position_of(point_index - 1),
+                                                 contour.position_of(point_index)));
+            }
+        }
+    }
+
+    criterion.bench_function("clip/line_segments", |bencher| {
+        bencher.iter(|| {
+            for &segment in &segments {
+                criterion::black_box(clip_line_segment_to_rect(segment, clip_rect));
+            }
+        })
+    });
+}
+
+// Exercises `Palette::push_paint()` deduplication with a mix of solid colors and gradients.
+fn bench_paint(criterion: &mut Criterion) {
+    let mut gradients = vec![];
+    for index in 0..64 {
+        let mut gradient =
+            Gradient::linear_from_points(vec2f(0.0, 0.0), vec2f(index as f32 + 1.0, 256.0));
+        gradient.add_color_stop(ColorU::new(index as u8, 0x80, 0xff - index as u8, 0xff), 0.0);
+        gradient.add_color_stop(ColorU::new(0xff, index as u8, 0x00, 0xff), 1.0);
+        gradients.push(Paint::from_gradient(gradient));
+    }
+
+    criterion.bench_function("paint/push_paint", |bencher| {
+        bencher.iter(|| {
+            let mut scene = Scene::new();
+            // Push each paint twice: once to build it and once to hit the deduplication path.
+            for _ in 0..2 {
+                for (index, gradient) in gradients.iter().enumerate() {
+                    let color = ColorU::new(index as u8, index as u8, 0x00, 0xff);
+                    criterion::black_box(scene.push_paint(&Paint::from_color(color)));
+                    criterion::black_box(scene.push_paint(gradient));
+                }
+            }
+        })
+    });
+}
+
+criterion_group!(benches, bench_scene_build, bench_stroke, bench_clip, bench_paint);
+criterion_main!(benches);
@@ -0,0 +1,15 @@
+// pathfinder/benches/src/lib.rs
+//
+// Copyright © 2020 The Pathfinder Project Developers.
+//
+// Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+// http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+// <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+// option. This file may not be copied, modified, or distributed
+// except according to those terms.
+
+//! Criterion benchmarks for the Pathfinder CPU hot paths.
+//!
+//! This crate has no library code; the benchmarks live in `benches/`. Run them with
+//! `cargo bench -p pathfinder_benchmarks`, optionally passing a filter such as `stroke` or
+//! `scene_build` to bisect a single subsystem.
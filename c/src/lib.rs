@@ -13,7 +13,7 @@
 use font_kit::handle::Handle;
 use gl;
 use pathfinder_canvas::{Canvas, CanvasFontContext, CanvasRenderingContext2D, FillStyle, LineJoin};
-use pathfinder_canvas::{Path2D, TextAlign, TextBaseline, TextMetrics};
+use pathfinder_canvas::{Path2D, PathVerb, TextAlign, TextBaseline, TextMetrics};
 use pathfinder_color::{ColorF, ColorU};
 use pathfinder_content::fill::FillRule;
 use pathfinder_content::outline::ArcDirection;
@@ -74,6 +74,12 @@ pub const PF_TEXT_BASELINE_MIDDLE:      u8 = 3;
 pub const PF_TEXT_BASELINE_IDEOGRAPHIC: u8 = 4;
 pub const PF_TEXT_BASELINE_BOTTOM:      u8 = 5;
 
+pub const PF_PATH_VERB_MOVE_TO:            u8 = 0;
+pub const PF_PATH_VERB_LINE_TO:            u8 = 1;
+pub const PF_PATH_VERB_QUADRATIC_CURVE_TO: u8 = 2;
+pub const PF_PATH_VERB_BEZIER_CURVE_TO:    u8 = 3;
+pub const PF_PATH_VERB_CLOSE_PATH:         u8 = 4;
+
 // `content`
 
 pub const PF_ARC_DIRECTION_CW:  u8 = 0;
@@ -101,11 +107,43 @@ pub type FKHandleRef = *mut Handle;
 // `canvas`
 pub type PFCanvasRef = *mut CanvasRenderingContext2D;
 pub type PFPathRef = *mut Path2D;
+
+/// A single recorded canvas operation.
+///
+/// Values are stored in their Rust forms, so recording pays the FFI conversion cost once and
+/// replaying is just method calls.
+pub enum CanvasCommand {
+    FillRect(RectF),
+    StrokeRect(RectF),
+    FillText(String, Vector2F),
+    StrokeText(String, Vector2F),
+    SetLineWidth(f32),
+    SetLineCap(LineCap),
+    SetLineJoin(LineJoin),
+    SetMiterLimit(f32),
+    SetLineDash(Vec<f32>),
+    SetLineDashOffset(f32),
+    SetTransform(Transform2F),
+    ResetTransform,
+    Save,
+    Restore,
+    SetFontByPostScriptName(String),
+    SetFontSize(f32),
+    SetTextAlign(TextAlign),
+    SetTextBaseline(TextBaseline),
+    SetFillStyle(FillStyle),
+    SetStrokeStyle(FillStyle),
+    FillPath(Path2D, FillRule),
+    StrokePath(Path2D),
+}
+
+pub type PFCommandListRef = *mut Vec<CanvasCommand>;
 pub type PFCanvasFontContextRef = *mut CanvasFontContext;
 pub type PFFillStyleRef = *mut FillStyle;
 pub type PFLineCap = u8;
 pub type PFLineJoin = u8;
 pub type PFArcDirection = u8;
+pub type PFPathVerb = u8;
 pub type PFTextAlign = u8;
 pub type PFTextBaseline = u8;
 #[repr(C)]
@@ -318,22 +356,12 @@ pub unsafe extern "C" fn PFCanvasSetLineWidth(canvas: PFCanvasRef, new_line_widt
 
 #[no_mangle]
 pub unsafe extern "C" fn PFCanvasSetLineCap(canvas: PFCanvasRef, new_line_cap: PFLineCap) {
-    (*canvas).set_line_cap(match new_line_cap {
-        PF_LINE_CAP_BUTT   => LineCap::Butt,
-        PF_LINE_CAP_SQUARE => LineCap::Square,
-        PF_LINE_CAP_ROUND  => LineCap::Round,
-        _                  => panic!("Invalid Pathfinder line cap style!"),
-    });
+    (*canvas).set_line_cap(to_rust_line_cap(new_line_cap));
 }
 
 #[no_mangle]
 pub unsafe extern "C" fn PFCanvasSetLineJoin(canvas: PFCanvasRef, new_line_join: PFLineJoin) {
-    (*canvas).set_line_join(match new_line_join {
-        PF_LINE_JOIN_MITER => LineJoin::Miter,
-        PF_LINE_JOIN_BEVEL => LineJoin::Bevel,
-        PF_LINE_JOIN_ROUND => LineJoin::Round,
-        _                  => panic!("Invalid Pathfinder line join style!"),
-    });
+    (*canvas).set_line_join(to_rust_line_join(new_line_join));
 }
 
 #[no_mangle]
@@ -388,24 +416,13 @@ pub unsafe extern "C" fn PFCanvasSetFontSize(canvas: PFCanvasRef, new_font_size:
 
 #[no_mangle]
 pub unsafe extern "C" fn PFCanvasSetTextAlign(canvas: PFCanvasRef, new_text_align: PFTextAlign) {
-    (*canvas).set_text_align(match new_text_align {
-        PF_TEXT_ALIGN_CENTER => TextAlign::Center,
-        PF_TEXT_ALIGN_RIGHT  => TextAlign::Right,
-        _                    => TextAlign::Left,
-    });
+    (*canvas).set_text_align(to_rust_text_align(new_text_align));
 }
 
 #[no_mangle]
 pub unsafe extern "C" fn PFCanvasSetTextBaseline(canvas: PFCanvasRef,
                                                  new_text_baseline: PFTextBaseline) {
-    (*canvas).set_text_baseline(match new_text_baseline {
-        PF_TEXT_BASELINE_ALPHABETIC => TextBaseline::Alphabetic,
-        PF_TEXT_BASELINE_TOP => TextBaseline::Top,
-        PF_TEXT_BASELINE_HANGING => TextBaseline::Hanging,
-        PF_TEXT_BASELINE_MIDDLE => TextBaseline::Middle,
-        PF_TEXT_BASELINE_IDEOGRAPHIC => TextBaseline::Ideographic,
-        _ => TextBaseline::Bottom,
-    });
+    (*canvas).set_text_baseline(to_rust_text_baseline(new_text_baseline));
 }
 
 #[no_mangle]
@@ -436,6 +453,230 @@ pub unsafe extern "C" fn PFCanvasStrokePath(canvas: PFCanvasRef, path: PFPathRef
     (*canvas).stroke_path(*Box::from_raw(path))
 }
 
+// Command lists
+
+/// Creates a new, empty command list.
+///
+/// Command lists record canvas operations into a compact buffer without touching a canvas, so
+/// they can be built on worker threads and replayed serially with `PFCommandListReplay`.
+#[no_mangle]
+pub unsafe extern "C" fn PFCommandListCreate() -> PFCommandListRef {
+    Box::into_raw(Box::new(vec![]))
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn PFCommandListDestroy(command_list: PFCommandListRef) {
+    drop(Box::from_raw(command_list))
+}
+
+/// Appends the contents of `other` to `command_list`, leaving `other` empty.
+#[no_mangle]
+pub unsafe extern "C" fn PFCommandListAppend(command_list: PFCommandListRef,
+                                             other: PFCommandListRef) {
+    (*command_list).append(&mut *other)
+}
+
+/// Replays the recorded commands against `canvas`, in order.
+///
+/// The command list is not consumed and may be replayed again.
+#[no_mangle]
+pub unsafe extern "C" fn PFCommandListReplay(command_list: PFCommandListRef,
+                                             canvas: PFCanvasRef) {
+    for command in &*command_list {
+        match *command {
+            CanvasCommand::FillRect(rect) => (*canvas).fill_rect(rect),
+            CanvasCommand::StrokeRect(rect) => (*canvas).stroke_rect(rect),
+            CanvasCommand::FillText(ref string, position) => {
+                (*canvas).fill_text(&**string, position)
+            }
+            CanvasCommand::StrokeText(ref string, position) => {
+                (*canvas).stroke_text(&**string, position)
+            }
+            CanvasCommand::SetLineWidth(new_line_width) => {
+                (*canvas).set_line_width(new_line_width)
+            }
+            CanvasCommand::SetLineCap(new_line_cap) => (*canvas).set_line_cap(new_line_cap),
+            CanvasCommand::SetLineJoin(new_line_join) => (*canvas).set_line_join(new_line_join),
+            CanvasCommand::SetMiterLimit(new_miter_limit) => {
+                (*canvas).set_miter_limit(new_miter_limit)
+            }
+            CanvasCommand::SetLineDash(ref new_line_dashes) => {
+                (*canvas).set_line_dash(new_line_dashes.clone())
+            }
+            CanvasCommand::SetLineDashOffset(new_offset) => {
+                (*canvas).set_line_dash_offset(new_offset)
+            }
+            CanvasCommand::SetTransform(ref transform) => (*canvas).set_transform(transform),
+            CanvasCommand::ResetTransform => (*canvas).reset_transform(),
+            CanvasCommand::Save => (*canvas).save(),
+            CanvasCommand::Restore => (*canvas).restore(),
+            CanvasCommand::SetFontByPostScriptName(ref name) => (*canvas).set_font(&**name),
+            CanvasCommand::SetFontSize(new_font_size) => (*canvas).set_font_size(new_font_size),
+            CanvasCommand::SetTextAlign(new_text_align) => {
+                (*canvas).set_text_align(new_text_align)
+            }
+            CanvasCommand::SetTextBaseline(new_text_baseline) => {
+                (*canvas).set_text_baseline(new_text_baseline)
+            }
+            CanvasCommand::SetFillStyle(ref fill_style) => {
+                (*canvas).set_fill_style(fill_style.clone())
+            }
+            CanvasCommand::SetStrokeStyle(ref stroke_style) => {
+                (*canvas).set_stroke_style(stroke_style.clone())
+            }
+            CanvasCommand::FillPath(ref path, fill_rule) => {
+                (*canvas).fill_path(path.clone(), fill_rule)
+            }
+            CanvasCommand::StrokePath(ref path) => (*canvas).stroke_path(path.clone()),
+        }
+    }
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn PFCommandListFillRect(command_list: PFCommandListRef,
+                                               rect: *const PFRectF) {
+    (*command_list).push(CanvasCommand::FillRect((*rect).to_rust()))
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn PFCommandListStrokeRect(command_list: PFCommandListRef,
+                                                 rect: *const PFRectF) {
+    (*command_list).push(CanvasCommand::StrokeRect((*rect).to_rust()))
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn PFCommandListFillText(command_list: PFCommandListRef,
+                                               string: *const c_char,
+                                               string_len: usize,
+                                               position: *const PFVector2F) {
+    (*command_list).push(CanvasCommand::FillText(to_rust_string(&string, string_len).to_owned(),
+                                                 (*position).to_rust()))
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn PFCommandListStrokeText(command_list: PFCommandListRef,
+                                                 string: *const c_char,
+                                                 string_len: usize,
+                                                 position: *const PFVector2F) {
+    (*command_list).push(CanvasCommand::StrokeText(to_rust_string(&string, string_len).to_owned(),
+                                                   (*position).to_rust()))
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn PFCommandListSetLineWidth(command_list: PFCommandListRef,
+                                                   new_line_width: f32) {
+    (*command_list).push(CanvasCommand::SetLineWidth(new_line_width))
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn PFCommandListSetLineCap(command_list: PFCommandListRef,
+                                                 new_line_cap: PFLineCap) {
+    (*command_list).push(CanvasCommand::SetLineCap(to_rust_line_cap(new_line_cap)))
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn PFCommandListSetLineJoin(command_list: PFCommandListRef,
+                                                  new_line_join: PFLineJoin) {
+    (*command_list).push(CanvasCommand::SetLineJoin(to_rust_line_join(new_line_join)))
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn PFCommandListSetMiterLimit(command_list: PFCommandListRef,
+                                                    new_miter_limit: f32) {
+    (*command_list).push(CanvasCommand::SetMiterLimit(new_miter_limit))
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn PFCommandListSetLineDash(command_list: PFCommandListRef,
+                                                  new_line_dashes: *const f32,
+                                                  new_line_dash_count: usize) {
+    let new_line_dashes = slice::from_raw_parts(new_line_dashes, new_line_dash_count).to_vec();
+    (*command_list).push(CanvasCommand::SetLineDash(new_line_dashes))
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn PFCommandListSetLineDashOffset(command_list: PFCommandListRef,
+                                                        new_offset: f32) {
+    (*command_list).push(CanvasCommand::SetLineDashOffset(new_offset))
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn PFCommandListSetTransform(command_list: PFCommandListRef,
+                                                   transform: *const PFTransform2F) {
+    (*command_list).push(CanvasCommand::SetTransform((*transform).to_rust()))
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn PFCommandListResetTransform(command_list: PFCommandListRef) {
+    (*command_list).push(CanvasCommand::ResetTransform)
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn PFCommandListSave(command_list: PFCommandListRef) {
+    (*command_list).push(CanvasCommand::Save)
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn PFCommandListRestore(command_list: PFCommandListRef) {
+    (*command_list).push(CanvasCommand::Restore)
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn PFCommandListSetFontByPostScriptName(command_list: PFCommandListRef,
+                                                              postscript_name: *const c_char,
+                                                              postscript_name_len: usize) {
+    let name = to_rust_string(&postscript_name, postscript_name_len).to_owned();
+    (*command_list).push(CanvasCommand::SetFontByPostScriptName(name))
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn PFCommandListSetFontSize(command_list: PFCommandListRef,
+                                                  new_font_size: f32) {
+    (*command_list).push(CanvasCommand::SetFontSize(new_font_size))
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn PFCommandListSetTextAlign(command_list: PFCommandListRef,
+                                                   new_text_align: PFTextAlign) {
+    (*command_list).push(CanvasCommand::SetTextAlign(to_rust_text_align(new_text_align)))
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn PFCommandListSetTextBaseline(command_list: PFCommandListRef,
+                                                      new_text_baseline: PFTextBaseline) {
+    (*command_list).push(CanvasCommand::SetTextBaseline(
+        to_rust_text_baseline(new_text_baseline)))
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn PFCommandListSetFillStyle(command_list: PFCommandListRef,
+                                                   fill_style: PFFillStyleRef) {
+    // FIXME(pcwalton): Avoid the copy?
+    (*command_list).push(CanvasCommand::SetFillStyle((*fill_style).clone()))
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn PFCommandListSetStrokeStyle(command_list: PFCommandListRef,
+                                                     stroke_style: PFFillStyleRef) {
+    // FIXME(pcwalton): Avoid the copy?
+    (*command_list).push(CanvasCommand::SetStrokeStyle((*stroke_style).clone()))
+}
+
+/// This function automatically destroys the path. If you wish to use the path again, clone it
+/// first.
+#[no_mangle]
+pub unsafe extern "C" fn PFCommandListFillPath(command_list: PFCommandListRef, path: PFPathRef) {
+    // TODO(pcwalton): Expose fill rules to the C API.
+    (*command_list).push(CanvasCommand::FillPath(*Box::from_raw(path), FillRule::Winding))
+}
+
+/// This function automatically destroys the path. If you wish to use the path again, clone it
+/// first.
+#[no_mangle]
+pub unsafe extern "C" fn PFCommandListStrokePath(command_list: PFCommandListRef, path: PFPathRef) {
+    (*command_list).push(CanvasCommand::StrokePath(*Box::from_raw(path)))
+}
+
 #[no_mangle]
 pub unsafe extern "C" fn PFPathCreate() -> PFPathRef {
     Box::into_raw(Box::new(Path2D::new()))
@@ -519,6 +760,46 @@ pub unsafe extern "C" fn PFPathClosePath(path: PFPathRef) {
     (*path).close_path()
 }
 
+/// Reserves space for at least `additional` more points in the path's current subpath.
+///
+/// Call this before `PFPathAppendSegments()` when the number of incoming points is known in
+/// advance, to avoid reallocation.
+#[no_mangle]
+pub unsafe extern "C" fn PFPathReserve(path: PFPathRef, additional: usize) {
+    (*path).reserve(additional)
+}
+
+/// Appends a packed buffer of path commands to the path in a single call.
+///
+/// Each verb consumes points from `points` in order: one point for `PF_PATH_VERB_MOVE_TO` and
+/// `PF_PATH_VERB_LINE_TO`, two for `PF_PATH_VERB_QUADRATIC_CURVE_TO`, three for
+/// `PF_PATH_VERB_BEZIER_CURVE_TO`, and none for `PF_PATH_VERB_CLOSE_PATH`. This is equivalent to
+/// issuing the corresponding sequence of `PFPathMoveTo()`/`PFPathLineTo()`/etc. calls but crosses
+/// the FFI boundary only once.
+#[no_mangle]
+pub unsafe extern "C" fn PFPathAppendSegments(path: PFPathRef,
+                                              points: *const PFVector2F,
+                                              point_count: usize,
+                                              verbs: *const PFPathVerb,
+                                              verb_count: usize) {
+    let points: Vec<Vector2F> = slice::from_raw_parts(points, point_count)
+        .iter()
+        .map(PFVector2F::to_rust)
+        .collect();
+    let verbs: Vec<PathVerb> = slice::from_raw_parts(verbs, verb_count)
+        .iter()
+        .map(|&verb| match verb {
+            PF_PATH_VERB_MOVE_TO            => PathVerb::MoveTo,
+            PF_PATH_VERB_LINE_TO            => PathVerb::LineTo,
+            PF_PATH_VERB_QUADRATIC_CURVE_TO => PathVerb::QuadraticCurveTo,
+            PF_PATH_VERB_BEZIER_CURVE_TO    => PathVerb::BezierCurveTo,
+            PF_PATH_VERB_CLOSE_PATH         => PathVerb::ClosePath,
+            _                               => panic!("Invalid Pathfinder path verb!"),
+        })
+        .collect();
+    (*path).append_segments(&points, &verbs)
+}
+
 #[no_mangle]
 pub unsafe extern "C" fn PFFillStyleCreateColor(color: *const PFColorU) -> PFFillStyleRef {
     Box::into_raw(Box::new(FillStyle::Color((*color).to_rust())))
@@ -841,6 +1122,43 @@ unsafe fn to_rust_string(ptr: &*const c_char, mut len: usize) -> &str {
     str::from_utf8(slice::from_raw_parts(*ptr as *const u8, len)).unwrap()
 }
 
+fn to_rust_line_cap(line_cap: PFLineCap) -> LineCap {
+    match line_cap {
+        PF_LINE_CAP_BUTT => LineCap::Butt,
+        PF_LINE_CAP_SQUARE => LineCap::Square,
+        PF_LINE_CAP_ROUND => LineCap::Round,
+        _ => panic!("Invalid Pathfinder line cap style!"),
+    }
+}
+
+fn to_rust_line_join(line_join: PFLineJoin) -> LineJoin {
+    match line_join {
+        PF_LINE_JOIN_MITER => LineJoin::Miter,
+        PF_LINE_JOIN_BEVEL => LineJoin::Bevel,
+        PF_LINE_JOIN_ROUND => LineJoin::Round,
+        _ => panic!("Invalid Pathfinder line join style!"),
+    }
+}
+
+fn to_rust_text_align(text_align: PFTextAlign) -> TextAlign {
+    match text_align {
+        PF_TEXT_ALIGN_CENTER => TextAlign::Center,
+        PF_TEXT_ALIGN_RIGHT => TextAlign::Right,
+        _ => TextAlign::Left,
+    }
+}
+
+fn to_rust_text_baseline(text_baseline: PFTextBaseline) -> TextBaseline {
+    match text_baseline {
+        PF_TEXT_BASELINE_ALPHABETIC => TextBaseline::Alphabetic,
+        PF_TEXT_BASELINE_TOP => TextBaseline::Top,
+        PF_TEXT_BASELINE_HANGING => TextBaseline::Hanging,
+        PF_TEXT_BASELINE_MIDDLE => TextBaseline::Middle,
+        PF_TEXT_BASELINE_IDEOGRAPHIC => TextBaseline::Ideographic,
+        _ => TextBaseline::Bottom,
+    }
+}
+
 trait TextMetricsExt {
     fn to_c(&self) -> PFTextMetrics;
 }
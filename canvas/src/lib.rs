@@ -22,7 +22,7 @@ pub use pathfinder_geometry::vector::{IntoVector2F, Vector2F, Vector2I, vec2f, v
 use pathfinder_content::dash::OutlineDash;
 use pathfinder_content::effects::{BlendMode, BlurDirection, PatternFilter};
 use pathfinder_content::gradient::Gradient;
-use pathfinder_content::outline::{Contour, Outline};
+use pathfinder_content::outline::{Contour, Outline, OutlineArena, PointFlags};
 use pathfinder_content::pattern::{Image, Pattern};
 use pathfinder_content::render_target::RenderTargetId;
 use pathfinder_content::stroke::{LineJoin as StrokeLineJoin};
@@ -122,6 +122,7 @@ impl Canvas {
             current_state: State::default(default_font_collection),
             saved_states: vec![],
             canvas_font_context,
+            outline_arena: OutlineArena::new(),
         }
     }
 
@@ -143,6 +144,7 @@ pub struct CanvasRenderingContext2D {
     saved_states: Vec<State>,
     #[allow(dead_code)]
     canvas_font_context: CanvasFontContext,
+    outline_arena: OutlineArena,
 }
 
 impl CanvasRenderingContext2D {
@@ -170,6 +172,22 @@ impl CanvasRenderingContext2D {
         drop(self.canvas.take_scene())
     }
 
+    /// Merges the given arena's pooled contour storage into this context's, so that path
+    /// construction can reuse it.
+    ///
+    /// Typically the arena comes from `SceneProxy::take_outline_arena()`, closing the loop:
+    /// storage from scenes this context built in previous frames flows back in here.
+    #[inline]
+    pub fn set_outline_arena(&mut self, arena: OutlineArena) {
+        self.outline_arena.append(arena);
+    }
+
+    /// Takes this context's pool of contour storage, leaving an empty one behind.
+    #[inline]
+    pub fn take_outline_arena(&mut self) -> OutlineArena {
+        mem::take(&mut self.outline_arena)
+    }
+
     // Drawing rectangles
 
     #[inline]
@@ -342,14 +360,17 @@ impl CanvasRenderingContext2D {
                                             &self.current_state.line_dash,
                                             self.current_state.line_dash_offset);
             dash.dash();
-            outline = dash.into_outline();
+            let dashed_outline = dash.into_outline();
+            self.outline_arena.recycle_outline(mem::replace(&mut outline, dashed_outline));
         }
 
-        let mut stroke_to_fill = OutlineStrokeToFill::new(&outline, stroke_style);
+        let mut stroke_to_fill =
+            OutlineStrokeToFill::with_arena(&outline, stroke_style, &mut self.outline_arena);
         stroke_to_fill.offset();
-        outline = stroke_to_fill.into_outline();
+        let stroked_outline = stroke_to_fill.into_outline();
+        self.outline_arena.recycle_outline(outline);
 
-        self.push_path(outline, PathOp::Stroke, FillRule::Winding);
+        self.push_path(stroked_outline, PathOp::Stroke, FillRule::Winding);
     }
 
     pub fn clip_path(&mut self, path: Path2D, fill_rule: FillRule) {
@@ -809,6 +830,68 @@ impl Path2D {
         }
     }
 
+    /// Reserves capacity for at least `additional` more points in the current subpath.
+    ///
+    /// Call this before `append_segments()` to avoid reallocation when the number of incoming
+    /// points is known in advance.
+    #[inline]
+    pub fn reserve(&mut self, additional: usize) {
+        self.current_contour.reserve(additional);
+    }
+
+    /// Appends a packed buffer of path commands to this path in bulk.
+    ///
+    /// Each verb consumes points from `points` in order: one point for `MoveTo` and `LineTo`,
+    /// two for `QuadraticCurveTo`, three for `BezierCurveTo`, and none for `ClosePath`. This is
+    /// equivalent to issuing the corresponding sequence of individual calls but pushes each run
+    /// of segments between `MoveTo`s into the underlying contour storage in one pass.
+    ///
+    /// Panics if the points buffer is too short for the given verbs.
+    pub fn append_segments(&mut self, points: &[Vector2F], verbs: &[PathVerb]) {
+        let (mut run_start, mut point_index) = (0, 0);
+        let mut run_flags = Vec::with_capacity(points.len());
+        for &verb in verbs {
+            match verb {
+                PathVerb::MoveTo => {
+                    self.push_segment_run(&points[run_start..point_index], &run_flags);
+                    run_flags.clear();
+                    run_start = point_index;
+                    self.flush_current_contour();
+                    run_flags.push(PointFlags::empty());
+                    point_index += 1;
+                }
+                PathVerb::LineTo => {
+                    run_flags.push(PointFlags::empty());
+                    point_index += 1;
+                }
+                PathVerb::QuadraticCurveTo => {
+                    run_flags.push(PointFlags::CONTROL_POINT_0);
+                    run_flags.push(PointFlags::empty());
+                    point_index += 2;
+                }
+                PathVerb::BezierCurveTo => {
+                    run_flags.push(PointFlags::CONTROL_POINT_0);
+                    run_flags.push(PointFlags::CONTROL_POINT_1);
+                    run_flags.push(PointFlags::empty());
+                    point_index += 3;
+                }
+                PathVerb::ClosePath => {
+                    self.push_segment_run(&points[run_start..point_index], &run_flags);
+                    run_flags.clear();
+                    run_start = point_index;
+                    self.current_contour.close();
+                }
+            }
+        }
+        self.push_segment_run(&points[run_start..point_index], &run_flags);
+    }
+
+    fn push_segment_run(&mut self, points: &[Vector2F], flags: &[PointFlags]) {
+        if !points.is_empty() {
+            self.current_contour.push_points(points, flags);
+        }
+    }
+
     // https://html.spec.whatwg.org/multipage/canvas.html#dom-path2d-addpath
     pub fn add_path(&mut self, mut path: Path2D, transform: &Transform2F) {
         self.flush_current_contour();
@@ -833,6 +916,22 @@ impl Path2D {
     }
 }
 
+/// A single path-building command, for use with `Path2D::append_segments()`.
+#[derive(Clone, Copy, Debug, PartialEq)]
+#[repr(u8)]
+pub enum PathVerb {
+    /// Starts a new subpath at the given point, consuming one point.
+    MoveTo,
+    /// Adds a line segment, consuming one point.
+    LineTo,
+    /// Adds a quadratic Bézier curve, consuming a control point and an endpoint.
+    QuadraticCurveTo,
+    /// Adds a cubic Bézier curve, consuming two control points and an endpoint.
+    BezierCurveTo,
+    /// Closes the current subpath, consuming no points.
+    ClosePath,
+}
+
 #[derive(Clone)]
 pub enum FillStyle {
     Color(ColorU),
@@ -4,7 +4,7 @@
 // https://creativecommons.org/publicdomain/zero/1.0/
 
 use pathfinder_geometry::vector::{Vector2F, vec2f};
-use super::Path2D;
+use super::{Path2D, PathVerb};
 
 #[test]
 pub fn test_path2d_formatting() {
@@ -17,3 +17,36 @@ pub fn test_path2d_formatting() {
     path.close_path();
     assert_eq!(format!("{:?}", path), "M 0 1 L 2 3 L 4 5 z");
 }
+
+#[test]
+pub fn test_path2d_append_segments() {
+    let points: Vec<Vector2F> = vec![
+        vec2f(0.0, 1.0),
+        vec2f(2.0, 3.0),
+        vec2f(4.0, 5.0), vec2f(6.0, 7.0),
+        vec2f(8.0, 9.0),
+        vec2f(10.0, 11.0),
+    ];
+    let verbs = [
+        PathVerb::MoveTo,
+        PathVerb::LineTo,
+        PathVerb::QuadraticCurveTo,
+        PathVerb::ClosePath,
+        PathVerb::MoveTo,
+        PathVerb::LineTo,
+    ];
+
+    let mut bulk_path = Path2D::new();
+    bulk_path.reserve(points.len());
+    bulk_path.append_segments(&points, &verbs);
+
+    let mut individual_path = Path2D::new();
+    individual_path.move_to(points[0]);
+    individual_path.line_to(points[1]);
+    individual_path.quadratic_curve_to(points[2], points[3]);
+    individual_path.close_path();
+    individual_path.move_to(points[4]);
+    individual_path.line_to(points[5]);
+
+    assert_eq!(format!("{:?}", bulk_path), format!("{:?}", individual_path));
+}
@@ -11,6 +11,7 @@
 //! Transforms a stroke into a dashed stroke.
 
 use crate::outline::{Contour, ContourIterFlags, Outline, PushSegmentFlags};
+use crate::segment::Segment;
 use std::mem;
 
 const EPSILON: f32 = 0.0001;
@@ -59,6 +60,79 @@ impl<'a> OutlineDash<'a> {
     }
 }
 
+/// Dashes an outline repeatedly with varying dash offsets, reusing a cached arc-length
+/// parameterization of the input.
+///
+/// `OutlineDash` measures every segment's arc length anew on each dashing pass. When only the
+/// dash offset animates—marching-ants selections, for instance—those measurements are invariant,
+/// and they dominate the cost of the pass. This type measures the input once at construction;
+/// each `dash()` call then just walks the cached lengths, evaluating curve parameterizations only
+/// at the O(number of dashes) points where a dash boundary actually splits a segment.
+pub struct CachedOutlineDash<'a> {
+    dashes: &'a [f32],
+    contours: Vec<MeasuredContour>,
+}
+
+struct MeasuredContour {
+    // Each segment of the contour, paired with its arc length.
+    segments: Vec<(Segment, f32)>,
+}
+
+impl<'a> CachedOutlineDash<'a> {
+    /// Measures the given stroke, to be dashed with the given dash pattern.
+    ///
+    /// The arguments have the same meaning as those of `OutlineDash::new()`.
+    pub fn new(input: &Outline, dashes: &'a [f32]) -> CachedOutlineDash<'a> {
+        let contours = input.contours.iter().map(|contour| {
+            let segments = contour.iter(ContourIterFlags::empty()).map(|segment| {
+                let length = segment.arc_length();
+                (segment, length)
+            }).collect();
+            MeasuredContour { segments }
+        }).collect();
+        CachedOutlineDash { dashes, contours }
+    }
+
+    /// Dashes the measured stroke with the given dash offset (phase), returning the dashed
+    /// outline.
+    pub fn dash(&self, offset: f32) -> Outline {
+        let mut output = Outline::new();
+        let mut state = DashState::new(self.dashes, offset);
+
+        for contour in &self.contours {
+            for &(segment, length) in &contour.segments {
+                let (mut segment, mut length) = (segment, length);
+
+                // Split off as many complete dash intervals as end within this segment.
+                while state.distance_left < length - EPSILON {
+                    let t = segment.time_for_distance(state.distance_left);
+                    let (prev_segment, next_segment) = segment.split(t);
+                    if state.is_on() {
+                        state.output.push_segment(&prev_segment, PushSegmentFlags::empty());
+                    }
+                    length -= state.distance_left;
+                    segment = next_segment;
+                    state.advance_dash(&mut output);
+                }
+
+                // The rest of the segment lies within the current dash interval.
+                if state.is_on() {
+                    state.output.push_segment(&segment, PushSegmentFlags::empty());
+                }
+                state.distance_left -= length;
+                if state.distance_left < EPSILON {
+                    state.advance_dash(&mut output);
+                }
+            }
+        }
+
+        if state.is_on() {
+            output.push_contour(state.output);
+        }
+        output
+    }
+}
+
 struct ContourDash<'a, 'b, 'c> {
     input: &'a Contour,
     output: &'b mut Outline,
@@ -100,16 +174,7 @@ impl<'a, 'b, 'c> ContourDash<'a, 'b, 'c> {
 
             self.state.distance_left -= distance;
             if self.state.distance_left < EPSILON {
-                if self.state.is_on() {
-                    self.output.push_contour(mem::replace(&mut self.state.output, Contour::new()));
-                }
-
-                self.state.current_dash_index += 1;
-                if self.state.current_dash_index == self.state.dashes.len() {
-                    self.state.current_dash_index = 0;
-                }
-
-                self.state.distance_left = self.state.dashes[self.state.current_dash_index];
+                self.state.advance_dash(self.output);
             }
         }
     }
@@ -145,6 +210,21 @@ impl<'a> DashState<'a> {
         }
     }
 
+    // Finishes the current dash interval: flushes the in-progress dash contour if any and moves
+    // on to the next interval in the pattern.
+    fn advance_dash(&mut self, output: &mut Outline) {
+        if self.is_on() {
+            output.push_contour(mem::replace(&mut self.output, Contour::new()));
+        }
+
+        self.current_dash_index += 1;
+        if self.current_dash_index == self.dashes.len() {
+            self.current_dash_index = 0;
+        }
+
+        self.distance_left = self.dashes[self.current_dash_index];
+    }
+
     #[inline]
     fn is_on(&self) -> bool {
         self.current_dash_index % 2 == 0
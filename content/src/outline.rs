@@ -550,6 +550,29 @@ impl Contour {
         self.closed = true;
     }
 
+    /// Reserves capacity for at least `additional` more points in this contour.
+    #[inline]
+    pub fn reserve(&mut self, additional: usize) {
+        self.points.reserve(additional);
+        self.flags.reserve(additional);
+    }
+
+    /// Appends a run of points, with their associated flags, to this contour in bulk.
+    ///
+    /// The two slices must have the same length. This is equivalent to pushing each point
+    /// individually but lands the data in the point and flag arrays in one pass, which is
+    /// considerably faster for long runs.
+    pub fn push_points(&mut self, points: &[Vector2F], flags: &[PointFlags]) {
+        assert_eq!(points.len(), flags.len());
+        let first = self.is_empty();
+        for (point_index, point) in points.iter().enumerate() {
+            debug_assert!(!point.x().is_nan() && !point.y().is_nan());
+            union_rect(&mut self.bounds, *point, first && point_index == 0);
+        }
+        self.points.extend_from_slice(points);
+        self.flags.extend_from_slice(flags);
+    }
+
     #[inline]
     pub(crate) fn push_point(&mut self,
                              point: Vector2F,
@@ -1084,3 +1107,76 @@ pub(crate) fn union_rect(bounds: &mut RectF, new_point: Vector2F, first: bool) {
         *bounds = bounds.union_point(new_point)
     }
 }
+
+/// The maximum number of contours an `OutlineArena` holds onto. Beyond this, recycled contours
+/// are simply dropped.
+const OUTLINE_ARENA_MAX_POOLED_CONTOURS: usize = 256;
+
+/// A pool of contour point storage that can be reused across outlines, cutting malloc/free
+/// traffic when paths are rebuilt every frame.
+///
+/// This isn't a true bump arena: contours handed out still own their buffers, so they can be
+/// moved into scenes and across threads freely. The arena just holds onto the buffers of
+/// recycled contours and hands them back out in place of fresh allocations.
+pub struct OutlineArena {
+    free_contours: Vec<Contour>,
+}
+
+impl OutlineArena {
+    /// Creates a new, empty arena.
+    #[inline]
+    pub fn new() -> OutlineArena {
+        OutlineArena { free_contours: vec![] }
+    }
+
+    /// Returns an empty contour with space for at least the given number of points, reusing
+    /// pooled storage if any is available.
+    pub fn allocate_contour(&mut self, capacity: usize) -> Contour {
+        match self.free_contours.pop() {
+            Some(mut contour) => {
+                let present_capacity = contour.points.capacity();
+                if capacity > present_capacity {
+                    contour.reserve(capacity - present_capacity);
+                }
+                contour
+            }
+            None => Contour::with_capacity(capacity),
+        }
+    }
+
+    /// Returns the given contour's storage to the pool.
+    pub fn recycle_contour(&mut self, mut contour: Contour) {
+        if self.free_contours.len() >= OUTLINE_ARENA_MAX_POOLED_CONTOURS {
+            return;
+        }
+        contour.clear();
+        self.free_contours.push(contour);
+    }
+
+    /// Returns the storage of every contour in the given outline to the pool.
+    pub fn recycle_outline(&mut self, outline: Outline) {
+        for contour in outline.contours {
+            self.recycle_contour(contour);
+        }
+    }
+
+    /// Moves all pooled storage out of `other` and into this arena.
+    pub fn append(&mut self, mut other: OutlineArena) {
+        let available = OUTLINE_ARENA_MAX_POOLED_CONTOURS - self.free_contours.len();
+        other.free_contours.truncate(available);
+        self.free_contours.append(&mut other.free_contours);
+    }
+
+    /// Returns the number of contours currently pooled.
+    #[inline]
+    pub fn pooled_contour_count(&self) -> usize {
+        self.free_contours.len()
+    }
+}
+
+impl Default for OutlineArena {
+    #[inline]
+    fn default() -> OutlineArena {
+        OutlineArena::new()
+    }
+}
@@ -46,6 +46,17 @@ pub enum PatternSource {
         id: RenderTargetId,
         /// The device pixel size of the render target.
         size: Vector2I,
+    },
+    /// A texture owned by the embedder, referenced directly with no CPU copy.
+    ///
+    /// The texture itself lives in the renderer; register it there with the same ID before
+    /// rendering a scene that uses this pattern. This is the way to efficiently composite
+    /// content, such as video frames, that another system decodes straight into GPU memory.
+    ExternalTexture {
+        /// The ID under which the texture was registered with the renderer.
+        id: ExternalTextureId,
+        /// The device pixel size of the texture.
+        size: Vector2I,
     }
 }
 
@@ -65,6 +76,13 @@ pub struct Image {
 #[derive(Clone, Copy, PartialEq, Eq, Hash, Debug)]
 pub struct ImageHash(pub u64);
 
+/// Unique identifier for a texture owned by the embedder.
+///
+/// The embedder chooses these IDs and registers the corresponding device textures with the
+/// renderer.
+#[derive(Clone, Copy, PartialEq, Eq, Hash, Debug)]
+pub struct ExternalTextureId(pub u32);
+
 bitflags! {
     /// Various flags that determine behavior of a pattern.
     pub struct PatternFlags: u8 {
@@ -106,6 +124,15 @@ impl Pattern {
         Pattern::from_source(PatternSource::RenderTarget { id, size })
     }
 
+    /// Creates a new pattern from the external texture with the given ID and size.
+    ///
+    /// The texture must be registered with the renderer under the same ID before rendering. The
+    /// transform is initialized to the identity transform. There is no filter.
+    #[inline]
+    pub fn from_external_texture(id: ExternalTextureId, size: Vector2I) -> Pattern {
+        Pattern::from_source(PatternSource::ExternalTexture { id, size })
+    }
+
     /// Returns the affine transform applied to this pattern.
     #[inline]
     pub fn transform(&self) -> Transform2F {
@@ -126,6 +153,7 @@ impl Pattern {
         match self.source {
             PatternSource::Image(ref image) => image.size(),
             PatternSource::RenderTarget { size, .. } => size,
+            PatternSource::ExternalTexture { size, .. } => size,
         }
     }
 
@@ -268,6 +296,10 @@ impl PatternSource {
                 // TODO(pcwalton): Maybe do something smarter here?
                 false
             }
+            PatternSource::ExternalTexture { .. } => {
+                // We can't inspect the pixels, so be conservative.
+                false
+            }
         }
     }
 }
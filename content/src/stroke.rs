@@ -10,7 +10,8 @@
 
 //! Utilities for converting path strokes to fills.
 
-use crate::outline::{ArcDirection, Contour, ContourIterFlags, Outline, PushSegmentFlags};
+use crate::outline::{ArcDirection, Contour, ContourIterFlags, Outline, OutlineArena};
+use crate::outline::PushSegmentFlags;
 use crate::segment::Segment;
 use pathfinder_geometry::line_segment::LineSegment2F;
 use pathfinder_geometry::rect::RectF;
@@ -34,6 +35,7 @@ pub struct OutlineStrokeToFill<'a> {
     input: &'a Outline,
     output: Outline,
     style: StrokeStyle,
+    arena: Option<&'a mut OutlineArena>,
 }
 
 /// How an outline should be stroked.
@@ -80,24 +82,35 @@ impl<'a> OutlineStrokeToFill<'a> {
     /// given stroke style.
     #[inline]
     pub fn new(input: &Outline, style: StrokeStyle) -> OutlineStrokeToFill {
-        OutlineStrokeToFill { input, output: Outline::new(), style }
+        OutlineStrokeToFill { input, output: Outline::new(), style, arena: None }
+    }
+
+    /// Like `new()`, but output contours draw their point storage from the given arena instead
+    /// of allocating afresh.
+    #[inline]
+    pub fn with_arena(input: &'a Outline, style: StrokeStyle, arena: &'a mut OutlineArena)
+                      -> OutlineStrokeToFill<'a> {
+        OutlineStrokeToFill { input, output: Outline::new(), style, arena: Some(arena) }
     }
 
     /// Performs the stroke operation.
     pub fn offset(&mut self) {
+        let input_outline = self.input;
         let mut new_contours = vec![];
-        for input in &self.input.contours {
+        for input in &input_outline.contours {
             let closed = input.closed;
+            let output = self.new_output_contour(input.len() as usize);
             let mut stroker = ContourStrokeToFill::new(input,
-                                                       Contour::new(),
+                                                       output,
                                                        self.style.line_width * 0.5,
                                                        self.style.line_join);
 
             stroker.offset_forward();
             if closed {
                 self.push_stroked_contour(&mut new_contours, stroker, true);
+                let output = self.new_output_contour(input.len() as usize);
                 stroker = ContourStrokeToFill::new(input,
-                                                   Contour::new(),
+                                                   output,
                                                    self.style.line_width * 0.5,
                                                    self.style.line_join);
             } else {
@@ -125,6 +138,13 @@ impl<'a> OutlineStrokeToFill<'a> {
         self.output
     }
 
+    fn new_output_contour(&mut self, capacity: usize) -> Contour {
+        match self.arena {
+            Some(ref mut arena) => arena.allocate_contour(capacity),
+            None => Contour::with_capacity(capacity),
+        }
+    }
+
     fn push_stroked_contour(&mut self,
                             new_contours: &mut Vec<Contour>,
                             mut stroker: ContourStrokeToFill,
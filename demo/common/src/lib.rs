@@ -277,6 +277,7 @@ impl<W> DemoApp<W> where W: Window {
                 Vector2F::zero()
             },
             subpixel_aa_enabled: self.ui_model.subpixel_aa_effect_enabled,
+            dirty_rects: vec![],
         };
 
         self.scene_proxy.build(build_options);
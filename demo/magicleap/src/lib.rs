@@ -29,21 +29,22 @@ use pathfinder_demo::BackgroundColor;
 use pathfinder_demo::Mode;
 use pathfinder_demo::window::Event;
 use pathfinder_demo::window::SVGPath;
+use pathfinder_geometry::rect::RectF;
 use pathfinder_geometry::rect::RectI;
 use pathfinder_geometry::transform2d::Transform2F;
-use pathfinder_geometry::vector::Vector2F;
 use pathfinder_geometry::vector::Vector2I;
 use pathfinder_geometry::vector::vec2i;
 use pathfinder_color::ColorF;
 use pathfinder_gl::GLDevice;
 use pathfinder_gl::GLVersion;
-use pathfinder_gpu::ClearParams;
-use pathfinder_gpu::Device;
-use pathfinder_renderer::concurrent::executor::SequentialExecutor;
+use pathfinder_renderer::concurrent::rayon::RayonExecutor;
 use pathfinder_renderer::concurrent::scene_proxy::SceneProxy;
+use pathfinder_renderer::gpu::options::DestFramebuffer;
+use pathfinder_renderer::gpu::options::RendererLevel;
+use pathfinder_renderer::gpu::options::RendererMode;
+use pathfinder_renderer::gpu::options::RendererOptions;
 use pathfinder_renderer::gpu::renderer::Renderer;
-use pathfinder_renderer::gpu::renderer::DestFramebuffer;
-use pathfinder_renderer::options::RenderOptions;
+use pathfinder_renderer::options::BuildOptions;
 use pathfinder_renderer::options::RenderTransform;
 use pathfinder_resources::ResourceLoader;
 use pathfinder_resources::fs::FilesystemResourceLoader;
@@ -55,6 +56,7 @@ use std::ffi::CStr;
 use std::ffi::CString;
 use std::os::raw::c_char;
 use std::os::raw::c_void;
+use std::slice;
 
 use usvg::Options as UsvgOptions;
 use usvg::Tree;
@@ -135,10 +137,21 @@ pub unsafe extern "C" fn magicleap_pathfinder_demo_load(app: *mut c_void, svg_fi
 
 struct MagicLeapPathfinder {
     renderers: HashMap<(EGLSurface, EGLDisplay), Renderer<GLDevice>>,
-    svgs: HashMap<String, SVGScene>,
+    views: HashMap<String, MagicLeapView>,
     resources: FilesystemResourceLoader,
 }
 
+/// A single SVG panel.
+///
+/// Each panel owns a long-lived scene proxy, so its scene is built on the proxy's worker thread
+/// and the parallel work inside each build is spread over the process-wide Rayon pool. Building
+/// every panel before submitting any of them lets the builds for all panels overlap instead of
+/// running back to back on the render thread.
+struct MagicLeapView {
+    proxy: SceneProxy,
+    scene_bounds: RectF,
+}
+
 #[repr(C)]
 pub struct MagicLeapPathfinderRenderOptions {
     display: EGLDisplay,
@@ -166,7 +179,7 @@ pub extern "C" fn magicleap_pathfinder_init() -> *mut c_void {
 
     let pf = MagicLeapPathfinder {
         renderers: HashMap::new(),
-        svgs: HashMap::new(),
+        views: HashMap::new(),
         resources: FilesystemResourceLoader::locate(),
     };
     info!("Initialized pf");
@@ -174,19 +187,43 @@ pub extern "C" fn magicleap_pathfinder_init() -> *mut c_void {
     Box::into_raw(Box::new(pf)) as *mut c_void
 }
 
-#[no_mangle]
-pub unsafe extern "C" fn magicleap_pathfinder_render(pf: *mut c_void, options: *const MagicLeapPathfinderRenderOptions) {
-    let pf = pf as *mut MagicLeapPathfinder;
-    if let (Some(pf), Some(options)) = (pf.as_mut(), options.as_ref()) {
-        let resources = &pf.resources;
+impl MagicLeapPathfinder {
+    /// Kicks off a scene build for one view and returns immediately. The command stream is
+    /// consumed later by `submit_view`.
+    unsafe fn build_view(&mut self, options: &MagicLeapPathfinderRenderOptions) {
+        let resources = &self.resources;
 
         let svg_filename = CStr::from_ptr(options.svg_filename).to_string_lossy().into_owned();
-        let svg = pf.svgs.entry(svg_filename).or_insert_with(|| {
+        let view = self.views.entry(svg_filename).or_insert_with(|| {
             let svg_filename = CStr::from_ptr(options.svg_filename).to_string_lossy();
             let data = resources.slurp(&*svg_filename).unwrap();
             let tree = Tree::from_data(&data, &UsvgOptions::default()).unwrap();
-            SVGScene::from_tree(tree)
+            let svg = SVGScene::from_tree(tree);
+            let scene_bounds = svg.scene.bounds();
+            let proxy = SceneProxy::from_scene(svg.scene, RendererLevel::D3D9, RayonExecutor);
+            MagicLeapView { proxy, scene_bounds }
+        });
+
+        let viewport_origin = vec2i(options.viewport[0] as i32, options.viewport[1] as i32);
+        let viewport_size = vec2i(options.viewport[2] as i32, options.viewport[3] as i32);
+        let viewport = RectI::new(viewport_origin, viewport_size);
+        view.proxy.set_view_box(viewport.to_f32());
+
+        let scale = i32::min(viewport_size.x(), viewport_size.y()) as f32 /
+            f32::max(view.scene_bounds.size().x(), view.scene_bounds.size().y());
+        let transform = Transform2F::from_translation(viewport_size.to_f32() * 0.5) *
+            Transform2F::from_scale(scale) *
+            Transform2F::from_translation(view.scene_bounds.size() * -0.5);
+
+        view.proxy.build(BuildOptions {
+            transform: RenderTransform::Transform2D(transform),
+            ..BuildOptions::default()
         });
+    }
+
+    /// Sends the render commands queued up by the matching `build_view` call to the GPU.
+    unsafe fn submit_view(&mut self, options: &MagicLeapPathfinderRenderOptions) {
+        let resources = &self.resources;
 
         let mut width = 0;
         let mut height = 0;
@@ -198,40 +235,65 @@ pub unsafe extern "C" fn magicleap_pathfinder_render(pf: *mut c_void, options: *
         let viewport_size = vec2i(options.viewport[2] as i32, options.viewport[3] as i32);
         let viewport = RectI::new(viewport_origin, viewport_size);
 
-        let bg_color = ColorF(F32x4::new(options.bg_color[0], options.bg_color[1], options.bg_color[2], options.bg_color[3]));
+        let bg_color = ColorF(F32x4::new(options.bg_color[0],
+                                         options.bg_color[1],
+                                         options.bg_color[2],
+                                         options.bg_color[3]));
 
-        let renderer = pf.renderers.entry((options.display, options.surface)).or_insert_with(|| {
+        let renderer = self.renderers.entry((options.surface, options.display)).or_insert_with(|| {
             let mut fbo = 0;
             gl::GetIntegerv(gl::DRAW_FRAMEBUFFER_BINDING, &mut fbo);
             let device = GLDevice::new(GLVersion::GLES3, fbo as GLuint);
-            let dest_framebuffer = DestFramebuffer::Default { viewport, window_size: size };
-            Renderer::new(device, resources, dest_framebuffer)
+            let mode = RendererMode { level: RendererLevel::D3D9 };
+            let renderer_options = RendererOptions {
+                dest: DestFramebuffer::Default { viewport, window_size: size },
+                background_color: Some(bg_color),
+                show_debug_ui: false,
+            };
+            Renderer::new(device, resources, mode, renderer_options)
         });
 
-        renderer.set_main_framebuffer_size(size);
-        renderer.device.bind_default_framebuffer(viewport);
-        renderer.device.clear(&ClearParams { color: Some(bg_color), ..ClearParams::default() });
-        renderer.disable_depth();
+        renderer.options_mut().dest = DestFramebuffer::Default { viewport, window_size: size };
+        renderer.options_mut().background_color = Some(bg_color);
+        renderer.dest_framebuffer_size_changed();
 
-        svg.scene.set_view_box(viewport.to_f32());
-
-        let scale = i32::min(viewport_size.x(), viewport_size.y()) as f32 /
-            f32::max(svg.scene.bounds().size().x(), svg.scene.bounds().size().y());
-        let transform = Transform2F::from_translation(svg.scene.bounds().size().scale(-0.5))
-            .post_mul(&Transform2F::from_scale(scale))
-            .post_mul(&Transform2F::from_translation(viewport_size.to_f32().scale(0.5)));
-
-        let render_options = RenderOptions {
-            transform: RenderTransform::Transform2D(transform),
-            dilation: Vector2F::zero(),
-            subpixel_aa_enabled: false,
-        };
+        let svg_filename = CStr::from_ptr(options.svg_filename).to_string_lossy();
+        if let Some(view) = self.views.get_mut(&*svg_filename) {
+            view.proxy.render(renderer);
+        }
+    }
+}
 
-        let scene_proxy = SceneProxy::from_scene(svg.scene.clone(), SequentialExecutor);
-        scene_proxy.build_and_render(renderer, render_options);
+/// Renders several views in one call.
+///
+/// All of the scene builds are kicked off up front, so they run concurrently on the Rayon pool,
+/// and then the resulting command streams are submitted to the GPU in the order given. Callers
+/// should group the options by EGL surface (typically one call per eye) so that the draw calls
+/// for each surface form one contiguous batch.
+#[no_mangle]
+pub unsafe extern "C" fn magicleap_pathfinder_render_all(pf: *mut c_void,
+                                                         options: *const MagicLeapPathfinderRenderOptions,
+                                                         option_count: usize) {
+    let pf = pf as *mut MagicLeapPathfinder;
+    if let Some(pf) = pf.as_mut() {
+        if options.is_null() {
+            return;
+        }
+        let all_options = slice::from_raw_parts(options, option_count);
+        for options in all_options {
+            pf.build_view(options);
+        }
+        for options in all_options {
+            pf.submit_view(options);
+        }
     }
 }
 
+#[no_mangle]
+pub unsafe extern "C" fn magicleap_pathfinder_render(pf: *mut c_void, options: *const MagicLeapPathfinderRenderOptions) {
+    magicleap_pathfinder_render_all(pf, options, 1);
+}
+
 #[no_mangle]
 pub unsafe extern "C" fn magicleap_pathfinder_deinit(pf: *mut c_void) {
     Box::from_raw(pf as *mut MagicLeapPathfinder);
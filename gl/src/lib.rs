@@ -20,14 +20,17 @@ use pathfinder_geometry::rect::RectI;
 use pathfinder_geometry::vector::Vector2I;
 use pathfinder_gpu::{BlendFactor, BlendOp, BufferData, BufferTarget, BufferUploadMode, ClearOps};
 use pathfinder_gpu::{ComputeDimensions, ComputeState, DepthFunc, Device, FeatureLevel};
-use pathfinder_gpu::{ImageAccess, ImageBinding, Primitive, ProgramKind, RenderOptions};
+use pathfinder_gpu::{ImageAccess, ImageBinding, Primitive, ProgramBinary, ProgramBinaryCache};
+use pathfinder_gpu::{ProgramKind, RenderOptions};
 use pathfinder_gpu::{RenderState, RenderTarget, ShaderKind, StencilFunc, TextureBinding};
 use pathfinder_gpu::{TextureData, TextureDataRef, TextureFormat, TextureSamplingFlags, UniformData};
 use pathfinder_gpu::{VertexAttrClass, VertexAttrDescriptor, VertexAttrType};
 use pathfinder_resources::ResourceLoader;
 use pathfinder_simd::default::F32x4;
 use std::cell::RefCell;
+use std::collections::hash_map::DefaultHasher;
 use std::ffi::{CStr, CString};
+use std::hash::{Hash, Hasher};
 use std::mem;
 use std::ops::Range;
 use std::os::raw::c_char;
@@ -38,10 +41,26 @@ use std::time::Duration;
 
 const DUMMY_TEXTURE_LENGTH: i32 = 16;
 
+// The number of sections in a persistently-mapped ring buffer. Three sections allow the CPU to
+// write a new frame's data while the GPU reads the previous one, without ever blocking on an
+// in-flight frame.
+const RING_BUFFER_SECTIONS: usize = 3;
+
 pub struct GLDevice {
     version: GLVersion,
     default_framebuffer: GLuint,
     dummy_texture: GLTexture,
+    // Ring buffer sections written since the last `end_commands`, awaiting a fence.
+    dirty_ring_sections: RefCell<Vec<(Rc<GLBufferObject>, usize)>>,
+    // Persistent program binary cache, if the embedder supplied one.
+    program_binary_cache: Option<ProgramBinaryCacheState>,
+}
+
+struct ProgramBinaryCacheState {
+    cache: ProgramBinaryCache,
+    // Hash of the GL vendor, renderer, and version strings, so that cached binaries are
+    // invalidated when the driver changes.
+    device_id: u64,
 }
 
 impl GLDevice {
@@ -53,7 +72,13 @@ impl GLDevice {
             format: TextureFormat::RGBA8,
         };
 
-        let mut device = GLDevice { version, default_framebuffer, dummy_texture };
+        let mut device = GLDevice {
+            version,
+            default_framebuffer,
+            dummy_texture,
+            dirty_ring_sections: RefCell::new(vec![]),
+            program_binary_cache: None,
+        };
         let dummy_texture_data =
             [0; DUMMY_TEXTURE_LENGTH as usize * DUMMY_TEXTURE_LENGTH as usize * 4];
         device.dummy_texture =
@@ -248,7 +273,57 @@ impl GLDevice {
         unsafe {
             gl::BindBufferBase(gl::SHADER_STORAGE_BUFFER,
                                storage_buffer.location as GLuint,
-                               buffer.object.gl_buffer);
+                               buffer.object.gl_buffer());
+        }
+    }
+
+    // Returns true if dynamic buffers should be backed by persistently-mapped ring buffers.
+    //
+    // This requires `ARB_buffer_storage`, which is core in GL 4.4 but may be missing from the
+    // loaded function pointers on older 4.x contexts.
+    fn supports_ring_buffers(&self) -> bool {
+        self.version == GLVersion::GL4 &&
+            gl::BufferStorage::is_loaded() &&
+            gl::FenceSync::is_loaded()
+    }
+
+    // Replaces the storage of `buffer` with a ring of persistently-mapped buffer objects.
+    //
+    // Immutable storage can't be resized, so the ring sections get fresh buffer names; callers
+    // must attach buffers to vertex arrays only after uploading, which all in-tree callers do.
+    fn allocate_ring_buffer(&self,
+                            buffer: &GLBuffer,
+                            target: GLenum,
+                            data: *const u8,
+                            len: usize) {
+        let mut ring = buffer.object.ring.borrow_mut();
+        ring.sections.clear();
+        ring.current = 0;
+
+        let flags = gl::MAP_WRITE_BIT | gl::MAP_PERSISTENT_BIT | gl::MAP_COHERENT_BIT;
+        for section_index in 0..RING_BUFFER_SECTIONS {
+            unsafe {
+                let mut gl_buffer = 0;
+                gl::GenBuffers(1, &mut gl_buffer); ck();
+                gl::BindBuffer(target, gl_buffer); ck();
+                gl::BufferStorage(target, len as GLsizeiptr, ptr::null(), flags); ck();
+                let map_ptr = gl::MapBufferRange(target,
+                                                 0,
+                                                 len as GLsizeiptr,
+                                                 flags) as *mut u8; ck();
+                assert!(!map_ptr.is_null());
+                let dirty = section_index == 0 && !data.is_null();
+                if dirty {
+                    ptr::copy_nonoverlapping(data, map_ptr, len);
+                }
+                ring.sections.push(GLBufferSection {
+                    gl_buffer,
+                    map_ptr,
+                    size: len,
+                    fence: None,
+                    dirty,
+                });
+            }
         }
     }
 
@@ -404,38 +479,10 @@ impl Device for GLDevice {
 
         let mut output = vec![];
         self.preprocess(&mut output, source, glsl_version_spec);
-        let source = output;
-
-        let gl_shader_kind = match kind {
-            ShaderKind::Vertex   => gl::VERTEX_SHADER,
-            ShaderKind::Fragment => gl::FRAGMENT_SHADER,
-            ShaderKind::Compute  => gl::COMPUTE_SHADER,
-        };
-
-        unsafe {
-            let gl_shader = gl::CreateShader(gl_shader_kind); ck();
-            gl::ShaderSource(gl_shader,
-                             1,
-                             [source.as_ptr() as *const GLchar].as_ptr(),
-                             [source.len() as GLint].as_ptr()); ck();
-            gl::CompileShader(gl_shader); ck();
-
-            let mut compile_status = 0;
-            gl::GetShaderiv(gl_shader, gl::COMPILE_STATUS, &mut compile_status); ck();
-            if compile_status != gl::TRUE as GLint {
-                let mut info_log_length = 0;
-                gl::GetShaderiv(gl_shader, gl::INFO_LOG_LENGTH, &mut info_log_length); ck();
-                let mut info_log = vec![0; info_log_length as usize];
-                gl::GetShaderInfoLog(gl_shader,
-                                     info_log.len() as GLint,
-                                     ptr::null_mut(),
-                                     info_log.as_mut_ptr() as *mut GLchar); ck();
-                error!("Shader info log:\n{}", String::from_utf8_lossy(&info_log));
-                panic!("{:?} shader '{}' compilation failed", kind, name);
-            }
 
-            GLShader { gl_shader }
-        }
+        // Compilation is deferred to link time so that a program binary cache hit can skip it
+        // entirely.
+        GLShader { name: name.to_owned(), kind, source: output }
     }
 
     fn create_program_from_shaders(&self,
@@ -443,20 +490,55 @@ impl Device for GLDevice {
                                    name: &str,
                                    shaders: ProgramKind<GLShader>)
                                    -> GLProgram {
+        let cache = self.program_binary_cache.as_ref();
+        let source_hash = cache.map(|_| {
+            let mut hasher = DefaultHasher::new();
+            match shaders {
+                ProgramKind::Raster { ref vertex, ref fragment } => {
+                    vertex.source.hash(&mut hasher);
+                    fragment.source.hash(&mut hasher);
+                }
+                ProgramKind::Compute(ref compute) => compute.source.hash(&mut hasher),
+            }
+            hasher.finish()
+        });
+
+        // Fast path: reload a driver-compiled binary from the cache, skipping compilation.
+        if let (Some(cache), Some(source_hash)) = (cache, source_hash) {
+            if let Some(binary) = cache.cache.load(name, cache.device_id, source_hash) {
+                match self.create_program_from_binary(&binary) {
+                    Some(gl_program) => {
+                        let parameters = GLProgramParameters { textures: vec![], images: vec![] };
+                        return GLProgram {
+                            gl_program,
+                            shaders,
+                            parameters: RefCell::new(parameters),
+                        };
+                    }
+                    None => {
+                        warn!("Driver rejected cached program binary for `{}`; recompiling",
+                              name);
+                    }
+                }
+            }
+        }
+
         let gl_program;
         unsafe {
             gl_program = gl::CreateProgram(); ck();
-            match shaders {
-                ProgramKind::Raster {
-                    vertex: ref vertex_shader,
-                    fragment: ref fragment_shader,
-                } => {
-                    gl::AttachShader(gl_program, vertex_shader.gl_shader); ck();
-                    gl::AttachShader(gl_program, fragment_shader.gl_shader); ck();
-                }
-                ProgramKind::Compute(ref compute_shader) => {
-                    gl::AttachShader(gl_program, compute_shader.gl_shader); ck();
+            let gl_shaders = match shaders {
+                ProgramKind::Raster { ref vertex, ref fragment } => {
+                    vec![vertex.compile(), fragment.compile()]
                 }
+                ProgramKind::Compute(ref compute) => vec![compute.compile()],
+            };
+            for &gl_shader in &gl_shaders {
+                gl::AttachShader(gl_program, gl_shader); ck();
+            }
+            if cache.is_some() {
+                gl::ProgramParameteri(gl_program,
+                                      gl::PROGRAM_BINARY_RETRIEVABLE_HINT,
+                                      gl::TRUE as GLint); ck();
             }
             gl::LinkProgram(gl_program); ck();
 
@@ -473,6 +555,17 @@ impl Device for GLDevice {
                 eprintln!("Program info log:\n{}", String::from_utf8_lossy(&info_log));
                 panic!("Program '{}' linking failed", name);
             }
+
+            for &gl_shader in &gl_shaders {
+                gl::DetachShader(gl_program, gl_shader); ck();
+                gl::DeleteShader(gl_shader); ck();
+            }
+        }
+
+        if let (Some(cache), Some(source_hash)) = (cache, source_hash) {
+            if let Some(binary) = self.export_program_binary(gl_program) {
+                cache.cache.store(name, cache.device_id, source_hash, &binary);
+            }
         }
 
         let parameters = GLProgramParameters { textures: vec![], images: vec![] };
@@ -480,6 +573,24 @@ impl Device for GLDevice {
         GLProgram { gl_program, shaders, parameters: RefCell::new(parameters) }
     }
 
+    fn set_program_binary_cache(&mut self, cache: ProgramBinaryCache) {
+        // Program binaries require `glProgramBinary`, which needs OpenGL 4.1 or OpenGL ES 3.0.
+        if let GLVersion::GL3 = self.version {
+            return;
+        }
+        let mut hasher = DefaultHasher::new();
+        unsafe {
+            for &gl_string in &[gl::VENDOR, gl::RENDERER, gl::VERSION] {
+                let string = gl::GetString(gl_string);
+                if !string.is_null() {
+                    CStr::from_ptr(string as *const c_char).to_bytes().hash(&mut hasher);
+                }
+            }
+        }
+        self.program_binary_cache =
+            Some(ProgramBinaryCacheState { cache, device_id: hasher.finish() });
+    }
+
     #[inline]
     fn set_compute_program_local_size(&self, _: &mut Self::Program, _: ComputeDimensions) {
         // This does nothing on OpenGL, since the local size is set in the shader.
@@ -607,7 +718,16 @@ impl Device for GLDevice {
         unsafe {
             let mut gl_buffer = 0;
             gl::GenBuffers(1, &mut gl_buffer); ck();
-            let object = Rc::new(GLBufferObject { gl_buffer });
+            let section = GLBufferSection {
+                gl_buffer,
+                map_ptr: ptr::null_mut(),
+                size: 0,
+                fence: None,
+                dirty: false,
+            };
+            let object = Rc::new(GLBufferObject {
+                ring: RefCell::new(GLBufferRing { sections: vec![section], current: 0 }),
+            });
             GLBuffer { object, mode }
         }
     }
@@ -618,11 +738,17 @@ impl Device for GLDevice {
             BufferData::Uninitialized(len) => (ptr::null(), len),
             BufferData::Memory(buffer) => (buffer.as_ptr() as *const GLvoid, buffer.len()),
         };
-        let len = (len * mem::size_of::<T>()) as GLsizeiptr;
+        let len_in_bytes = len * mem::size_of::<T>();
+
+        if buffer.mode == BufferUploadMode::Dynamic && self.supports_ring_buffers() {
+            self.allocate_ring_buffer(buffer, target, ptr as *const u8, len_in_bytes);
+            return;
+        }
+
         let usage = buffer.mode.to_gl_usage();
         unsafe {
-            gl::BindBuffer(target, buffer.object.gl_buffer); ck();
-            gl::BufferData(target, len, ptr, usage); ck();
+            gl::BindBuffer(target, buffer.object.gl_buffer()); ck();
+            gl::BufferData(target, len_in_bytes as GLsizeiptr, ptr, usage); ck();
         }
     }
 
@@ -632,12 +758,46 @@ impl Device for GLDevice {
                            data: &[T],
                            target: BufferTarget) {
         let target = target.to_gl_target();
-        let len = (data.len() * mem::size_of::<T>()) as GLsizeiptr;
+        let len = data.len() * mem::size_of::<T>();
+
+        let mut ring = buffer.object.ring.borrow_mut();
+        if ring.is_persistent() {
+            // Writes from the start of the buffer rotate to the next ring section; partial
+            // updates at a nonzero offset must land in the section holding the earlier data.
+            if position == 0 {
+                ring.current = (ring.current + 1) % ring.sections.len();
+            }
+            let current = ring.current;
+            let section = &mut ring.sections[current];
+            debug_assert!(position + len <= section.size);
+            unsafe {
+                // If the rotation landed on a section written since it was last fenced — more
+                // same-size uploads this frame than the ring has sections — draws queued since
+                // that write may still read it, so fence the commands recorded so far before
+                // overwriting.
+                if position == 0 && section.dirty && section.fence.is_none() {
+                    section.fence = Some(gl::FenceSync(gl::SYNC_GPU_COMMANDS_COMPLETE, 0)); ck();
+                }
+                // Wait until the GPU has finished with this section before overwriting it.
+                if let Some(gl_sync) = section.fence.take() {
+                    gl::ClientWaitSync(gl_sync, gl::SYNC_FLUSH_COMMANDS_BIT, !0); ck();
+                    gl::DeleteSync(gl_sync); ck();
+                }
+                ptr::copy_nonoverlapping(data.as_ptr() as *const u8,
+                                         section.map_ptr.add(position),
+                                         len);
+                section.dirty = true;
+            }
+            self.dirty_ring_sections.borrow_mut().push((buffer.object.clone(), current));
+            return;
+        }
+        drop(ring);
+
         unsafe {
-            gl::BindBuffer(target, buffer.object.gl_buffer); ck();
+            gl::BindBuffer(target, buffer.object.gl_buffer()); ck();
             gl::BufferSubData(target,
                               position as GLintptr,
-                              len,
+                              len as GLsizeiptr,
                               data.as_ptr() as *const GLvoid); ck();
         }
     }
@@ -775,7 +935,13 @@ impl Device for GLDevice {
                    -> GLBufferDataReceiver {
         unsafe {
             let gl_sync = gl::FenceSync(gl::SYNC_GPU_COMMANDS_COMPLETE, 0);
-            GLBufferDataReceiver { object: buffer.object.clone(), gl_sync, range, target }
+            GLBufferDataReceiver {
+                object: buffer.object.clone(),
+                gl_buffer: buffer.object.gl_buffer(),
+                gl_sync,
+                range,
+                target,
+            }
         }
     }
 
@@ -785,6 +951,19 @@ impl Device for GLDevice {
     }
 
     fn end_commands(&self) {
+        // Fence off the ring buffer sections written this frame so that later uploads don't
+        // overwrite them while the GPU is still reading.
+        for (object, section_index) in self.dirty_ring_sections.borrow_mut().drain(..) {
+            let mut ring = object.ring.borrow_mut();
+            let section = &mut ring.sections[section_index];
+            unsafe {
+                if let Some(old_gl_sync) = section.fence.take() {
+                    gl::DeleteSync(old_gl_sync); ck();
+                }
+                section.fence = Some(gl::FenceSync(gl::SYNC_GPU_COMMANDS_COMPLETE, 0)); ck();
+            }
+        }
+
         unsafe { gl::Flush(); }
     }
 
@@ -925,7 +1104,7 @@ impl Device for GLDevice {
     fn bind_buffer(&self, vertex_array: &GLVertexArray, buffer: &GLBuffer, target: BufferTarget) {
         self.bind_vertex_array(vertex_array);
         unsafe {
-            gl::BindBuffer(target.to_gl_target(), buffer.object.gl_buffer); ck();
+            gl::BindBuffer(target.to_gl_target(), buffer.object.gl_buffer()); ck();
         }
         self.unbind_vertex_array();
     }
@@ -1046,6 +1225,46 @@ impl GLDevice {
         }
     }
 
+    // Creates a program from a driver-compiled binary previously returned by
+    // `export_program_binary`. Returns `None` if the driver rejects the binary, which can
+    // happen after a driver update; the caller is expected to fall back to compiling.
+    fn create_program_from_binary(&self, binary: &ProgramBinary) -> Option<GLuint> {
+        unsafe {
+            let gl_program = gl::CreateProgram(); ck();
+            gl::ProgramBinary(gl_program,
+                              binary.format,
+                              binary.data.as_ptr() as *const GLvoid,
+                              binary.data.len() as GLsizei);
+            let mut link_status = 0;
+            gl::GetProgramiv(gl_program, gl::LINK_STATUS, &mut link_status); ck();
+            if link_status != gl::TRUE as GLint {
+                gl::DeleteProgram(gl_program); ck();
+                return None;
+            }
+            Some(gl_program)
+        }
+    }
+
+    fn export_program_binary(&self, gl_program: GLuint) -> Option<ProgramBinary> {
+        unsafe {
+            let mut binary_length = 0;
+            gl::GetProgramiv(gl_program, gl::PROGRAM_BINARY_LENGTH, &mut binary_length); ck();
+            if binary_length <= 0 {
+                return None;
+            }
+            let mut data = vec![0; binary_length as usize];
+            let mut actual_length = 0;
+            let mut format = 0;
+            gl::GetProgramBinary(gl_program,
+                                 binary_length,
+                                 &mut actual_length,
+                                 &mut format,
+                                 data.as_mut_ptr() as *mut GLvoid); ck();
+            data.truncate(actual_length as usize);
+            Some(ProgramBinary { format, data })
+        }
+    }
+
     fn preprocess(&self, output: &mut Vec<u8>, source: &[u8], version: &str) {
         let mut index = 0;
         while index < source.len() {
@@ -1151,7 +1370,7 @@ impl GLDevice {
         let mut dest = vec![0; receiver.range.end - receiver.range.start];
         let gl_target = receiver.target.to_gl_target();
         unsafe {
-            gl::BindBuffer(gl_target, receiver.object.gl_buffer); ck();
+            gl::BindBuffer(gl_target, receiver.gl_buffer); ck();
             gl::GetBufferSubData(gl_target,
                                  receiver.range.start as GLintptr,
                                  (receiver.range.end - receiver.range.start) as GLsizeiptr,
@@ -1246,13 +1465,60 @@ pub struct GLBuffer {
     pub mode: BufferUploadMode,
 }
 
+/// The GL objects backing a buffer.
+///
+/// Dynamic buffers on GL 4 with `ARB_buffer_storage` are backed by a small ring of
+/// persistently-mapped buffer objects with fence-guarded reuse, so that per-frame uploads don't
+/// stall on GPU reads of the previous frame's data. Other buffers are backed by a single ordinary
+/// buffer object.
 pub struct GLBufferObject {
-    pub gl_buffer: GLuint,
+    ring: RefCell<GLBufferRing>,
 }
 
-impl Drop for GLBufferObject {
+impl GLBufferObject {
+    /// Returns the name of the GL buffer object that currently holds this buffer's data.
+    ///
+    /// For ring buffers this changes on each upload, so don't cache the returned name across
+    /// uploads.
+    #[inline]
+    pub fn gl_buffer(&self) -> GLuint {
+        let ring = self.ring.borrow();
+        ring.sections[ring.current].gl_buffer
+    }
+}
+
+struct GLBufferRing {
+    sections: Vec<GLBufferSection>,
+    current: usize,
+}
+
+impl GLBufferRing {
+    #[inline]
+    fn is_persistent(&self) -> bool {
+        !self.sections[0].map_ptr.is_null()
+    }
+}
+
+struct GLBufferSection {
+    gl_buffer: GLuint,
+    // Persistent mapping of the whole section, or null if not persistently mapped.
+    map_ptr: *mut u8,
+    size: usize,
+    // Signaled when the GPU has finished reading the last data uploaded to this section.
+    fence: Option<GLsync>,
+    // True if the section has been written since it was last fenced. Overwriting such a section
+    // requires fencing the commands recorded so far first, because draws queued since the write
+    // may still read it.
+    dirty: bool,
+}
+
+impl Drop for GLBufferSection {
     fn drop(&mut self) {
         unsafe {
+            if let Some(gl_sync) = self.fence.take() {
+                gl::DeleteSync(gl_sync); ck();
+            }
+            // Deleting a persistently-mapped buffer implicitly unmaps it.
             gl::DeleteBuffers(1, &mut self.gl_buffer); ck();
         }
     }
@@ -1303,13 +1569,45 @@ pub struct GLProgramParameters {
 }
 
 pub struct GLShader {
-    gl_shader: GLuint,
+    name: String,
+    kind: ShaderKind,
+    // Preprocessed GLSL source. The shader object itself is created at link time, so that a
+    // program binary cache hit can skip compilation; see
+    // `GLDevice::create_program_from_shaders`.
+    source: Vec<u8>,
 }
 
-impl Drop for GLShader {
-    fn drop(&mut self) {
+impl GLShader {
+    fn compile(&self) -> GLuint {
+        let gl_shader_kind = match self.kind {
+            ShaderKind::Vertex   => gl::VERTEX_SHADER,
+            ShaderKind::Fragment => gl::FRAGMENT_SHADER,
+            ShaderKind::Compute  => gl::COMPUTE_SHADER,
+        };
+
         unsafe {
-            gl::DeleteShader(self.gl_shader); ck();
+            let gl_shader = gl::CreateShader(gl_shader_kind); ck();
+            gl::ShaderSource(gl_shader,
+                             1,
+                             [self.source.as_ptr() as *const GLchar].as_ptr(),
+                             [self.source.len() as GLint].as_ptr()); ck();
+            gl::CompileShader(gl_shader); ck();
+
+            let mut compile_status = 0;
+            gl::GetShaderiv(gl_shader, gl::COMPILE_STATUS, &mut compile_status); ck();
+            if compile_status != gl::TRUE as GLint {
+                let mut info_log_length = 0;
+                gl::GetShaderiv(gl_shader, gl::INFO_LOG_LENGTH, &mut info_log_length); ck();
+                let mut info_log = vec![0; info_log_length as usize];
+                gl::GetShaderInfoLog(gl_shader,
+                                     info_log.len() as GLint,
+                                     ptr::null_mut(),
+                                     info_log.as_mut_ptr() as *mut GLchar); ck();
+                error!("Shader info log:\n{}", String::from_utf8_lossy(&info_log));
+                panic!("{:?} shader '{}' compilation failed", self.kind, self.name);
+            }
+
+            gl_shader
         }
     }
 }
@@ -1508,7 +1806,12 @@ impl VertexAttrTypeExt for VertexAttrType {
 }
 
 pub struct GLBufferDataReceiver {
+    // Kept alive so the GL buffer named by `gl_buffer` isn't deleted before the read completes.
+    #[allow(dead_code)]
     object: Rc<GLBufferObject>,
+    // Captured at read time: ring buffers may rotate to another section before the data is
+    // received.
+    gl_buffer: GLuint,
     gl_sync: GLsync,
     range: Range<usize>,
     target: BufferTarget,
@@ -1531,7 +1834,7 @@ impl Drop for GLTextureDataReceiver {
 }
 
 /// The version/dialect of OpenGL we should render with.
-#[derive(Clone, Copy)]
+#[derive(Clone, Copy, PartialEq)]
 #[repr(u32)]
 pub enum GLVersion {
     /// OpenGL 3.0+, core profile.
@@ -31,12 +31,29 @@ const DECAY_TIME: f32 = 0.250;
 // This helps avoid stalls. This is admittedly a bit of a hack.
 const REUSE_TIME: f32 = 0.015;
 
+// Number of free bytes we tolerate before compacting, as long as the free bytes also exceed
+// `COMPACTION_SLACK_FACTOR` times the committed bytes.
+//
+// Age-based purging alone lets long-running scenes accumulate slabs in size classes they no
+// longer allocate from, as long as at least one allocation per decay interval keeps the class
+// warm. Compaction frees slabs regardless of age once the total waste gets out of hand.
+const MAX_SLACK_BYTES: u64 = 32 * 1024 * 1024;
+
+// See `MAX_SLACK_BYTES`.
+const COMPACTION_SLACK_FACTOR: u64 = 2;
+
 pub struct GPUMemoryAllocator<D> where D: Device {
     general_buffers_in_use: FxHashMap<GeneralBufferID, BufferAllocation<D>>,
     index_buffers_in_use: FxHashMap<IndexBufferID, BufferAllocation<D>>,
     textures_in_use: FxHashMap<TextureID, TextureAllocation<D>>,
     framebuffers_in_use: FxHashMap<FramebufferID, FramebufferAllocation<D>>,
-    free_objects: VecDeque<FreeObject<D>>,
+    // Free objects, pooled by size class so that allocation is a hash lookup instead of a scan.
+    // Within each pool, objects are ordered from least to most recently freed.
+    free_general_buffers: FxHashMap<u64, VecDeque<FreeObject<GeneralBufferID, BufferAllocation<D>>>>,
+    free_index_buffers: FxHashMap<u64, VecDeque<FreeObject<IndexBufferID, BufferAllocation<D>>>>,
+    free_textures: FxHashMap<TextureDescriptor, VecDeque<FreeObject<TextureID, TextureAllocation<D>>>>,
+    free_framebuffers:
+        FxHashMap<TextureDescriptor, VecDeque<FreeObject<FramebufferID, FramebufferAllocation<D>>>>,
     next_general_buffer_id: GeneralBufferID,
     next_index_buffer_id: IndexBufferID,
     next_texture_id: TextureID,
@@ -63,16 +80,10 @@ struct FramebufferAllocation<D> where D: Device {
     tag: FramebufferTag,
 }
 
-struct FreeObject<D> where D: Device {
+struct FreeObject<ID, A> {
     timestamp: Instant,
-    kind: FreeObjectKind<D>,
-}
-
-enum FreeObjectKind<D> where D: Device {
-    GeneralBuffer { id: GeneralBufferID, allocation: BufferAllocation<D> },
-    IndexBuffer { id: IndexBufferID, allocation: BufferAllocation<D> },
-    Texture { id: TextureID, allocation: TextureAllocation<D> },
-    Framebuffer { id: FramebufferID, allocation: FramebufferAllocation<D> },
+    id: ID,
+    allocation: A,
 }
 
 #[derive(Clone, Copy, Debug, PartialEq, Eq, PartialOrd, Ord, Hash)]
@@ -115,7 +126,10 @@ impl<D> GPUMemoryAllocator<D> where D: Device {
             index_buffers_in_use: FxHashMap::default(),
             textures_in_use: FxHashMap::default(),
             framebuffers_in_use: FxHashMap::default(),
-            free_objects: VecDeque::new(),
+            free_general_buffers: FxHashMap::default(),
+            free_index_buffers: FxHashMap::default(),
+            free_textures: FxHashMap::default(),
+            free_framebuffers: FxHashMap::default(),
             next_general_buffer_id: GeneralBufferID(0),
             next_index_buffer_id: IndexBufferID(0),
             next_texture_id: TextureID(0),
@@ -134,30 +148,20 @@ impl<D> GPUMemoryAllocator<D> where D: Device {
 
         let now = Instant::now();
 
-        for free_object_index in 0..self.free_objects.len() {
-            match self.free_objects[free_object_index] {
-                FreeObject {
-                    ref timestamp,
-                    kind: FreeObjectKind::GeneralBuffer { ref allocation, .. },
-                } if allocation.size == byte_size &&
-                    (now - *timestamp).as_secs_f32() >= REUSE_TIME => {}
-                _ => continue,
-            }
-
-            let (id, mut allocation) = match self.free_objects.remove(free_object_index) {
-                Some(FreeObject {
-                    kind: FreeObjectKind::GeneralBuffer { id, allocation },
-                    ..
-                }) => {
-                    (id, allocation)
-                }
-                _ => unreachable!(),
+        if let Some(pool) = self.free_general_buffers.get_mut(&byte_size) {
+            // The front of the pool is the least recently freed object, so if it isn't safe to
+            // reuse yet, nothing in the pool is.
+            let front_is_reusable = match pool.front() {
+                Some(free_object) => (now - free_object.timestamp).as_secs_f32() >= REUSE_TIME,
+                None => false,
             };
-
-            allocation.tag = tag;
-            self.bytes_committed += allocation.size;
-            self.general_buffers_in_use.insert(id, allocation);
-            return id;
+            if front_is_reusable {
+                let FreeObject { id, mut allocation, .. } = pool.pop_front().unwrap();
+                allocation.tag = tag;
+                self.bytes_committed += allocation.size;
+                self.general_buffers_in_use.insert(id, allocation);
+                return id;
+            }
         }
 
         let buffer = device.create_buffer(BufferUploadMode::Dynamic);
@@ -191,27 +195,18 @@ impl<D> GPUMemoryAllocator<D> where D: Device {
 
         let now = Instant::now();
 
-        for free_object_index in 0..self.free_objects.len() {
-            match self.free_objects[free_object_index] {
-                FreeObject {
-                    ref timestamp,
-                    kind: FreeObjectKind::IndexBuffer { ref allocation, .. },
-                } if allocation.size == byte_size &&
-                    (now - *timestamp).as_secs_f32() >= REUSE_TIME => {}
-                _ => continue,
-            }
-
-            let (id, mut allocation) = match self.free_objects.remove(free_object_index) {
-                Some(FreeObject { kind: FreeObjectKind::IndexBuffer { id, allocation }, .. }) => {
-                    (id, allocation)
-                }
-                _ => unreachable!(),
+        if let Some(pool) = self.free_index_buffers.get_mut(&byte_size) {
+            let front_is_reusable = match pool.front() {
+                Some(free_object) => (now - free_object.timestamp).as_secs_f32() >= REUSE_TIME,
+                None => false,
             };
-
-            allocation.tag = tag;
-            self.bytes_committed += allocation.size;
-            self.index_buffers_in_use.insert(id, allocation);
-            return id;
+            if front_is_reusable {
+                let FreeObject { id, mut allocation, .. } = pool.pop_front().unwrap();
+                allocation.tag = tag;
+                self.bytes_committed += allocation.size;
+                self.index_buffers_in_use.insert(id, allocation);
+                return id;
+            }
         }
 
         let buffer = device.create_buffer(BufferUploadMode::Dynamic);
@@ -249,24 +244,13 @@ impl<D> GPUMemoryAllocator<D> where D: Device {
         };
         let byte_size = descriptor.byte_size();
 
-        for free_object_index in 0..self.free_objects.len() {
-            match self.free_objects[free_object_index] {
-                FreeObject { kind: FreeObjectKind::Texture { ref allocation, .. }, .. } if
-                        allocation.descriptor == descriptor => {}
-                _ => continue,
+        if let Some(pool) = self.free_textures.get_mut(&descriptor) {
+            if let Some(FreeObject { id, mut allocation, .. }) = pool.pop_front() {
+                allocation.tag = tag;
+                self.bytes_committed += allocation.descriptor.byte_size();
+                self.textures_in_use.insert(id, allocation);
+                return id;
             }
-
-            let (id, mut allocation) = match self.free_objects.remove(free_object_index) {
-                Some(FreeObject { kind: FreeObjectKind::Texture { id, allocation }, .. }) => {
-                    (id, allocation)
-                }
-                _ => unreachable!(),
-            };
-
-            allocation.tag = tag;
-            self.bytes_committed += allocation.descriptor.byte_size();
-            self.textures_in_use.insert(id, allocation);
-            return id;
         }
 
         debug!("mapping texture: {:?} {:?}", descriptor, tag);
@@ -296,24 +280,13 @@ impl<D> GPUMemoryAllocator<D> where D: Device {
         };
         let byte_size = descriptor.byte_size();
 
-        for free_object_index in 0..self.free_objects.len() {
-            match self.free_objects[free_object_index].kind {
-                FreeObjectKind::Framebuffer { ref allocation, .. } if allocation.descriptor ==
-                        descriptor => {}
-                _ => continue,
+        if let Some(pool) = self.free_framebuffers.get_mut(&descriptor) {
+            if let Some(FreeObject { id, mut allocation, .. }) = pool.pop_front() {
+                allocation.tag = tag;
+                self.bytes_committed += allocation.descriptor.byte_size();
+                self.framebuffers_in_use.insert(id, allocation);
+                return id;
             }
-
-            let (id, mut allocation) = match self.free_objects.remove(free_object_index) {
-                Some(FreeObject { kind: FreeObjectKind::Framebuffer { id, allocation }, .. }) => {
-                    (id, allocation)
-                }
-                _ => unreachable!(),
-            };
-
-            allocation.tag = tag;
-            self.bytes_committed += allocation.descriptor.byte_size();
-            self.framebuffers_in_use.insert(id, allocation);
-            return id;
         }
 
         debug!("mapping framebuffer: {:?} {:?}", descriptor, tag);
@@ -337,35 +310,117 @@ impl<D> GPUMemoryAllocator<D> where D: Device {
 
     pub fn purge_if_needed(&mut self) {
         let now = Instant::now();
-        loop {
-            match self.free_objects.front() {
-                Some(FreeObject { timestamp, .. }) if (now - *timestamp).as_secs_f32() >=
-                    DECAY_TIME => {}
-                _ => break,
+        let mut bytes_freed = 0;
+
+        for (&byte_size, pool) in &mut self.free_general_buffers {
+            while let Some(free_object) = pool.front() {
+                if (now - free_object.timestamp).as_secs_f32() < DECAY_TIME {
+                    break;
+                }
+                debug!("purging general buffer: {}", byte_size);
+                pool.pop_front();
+                bytes_freed += byte_size;
+            }
+        }
+        for (&byte_size, pool) in &mut self.free_index_buffers {
+            while let Some(free_object) = pool.front() {
+                if (now - free_object.timestamp).as_secs_f32() < DECAY_TIME {
+                    break;
+                }
+                debug!("purging index buffer: {}", byte_size);
+                pool.pop_front();
+                bytes_freed += byte_size;
+            }
+        }
+        for (descriptor, pool) in &mut self.free_textures {
+            while let Some(free_object) = pool.front() {
+                if (now - free_object.timestamp).as_secs_f32() < DECAY_TIME {
+                    break;
+                }
+                debug!("purging texture: {:?}", descriptor);
+                pool.pop_front();
+                bytes_freed += descriptor.byte_size();
             }
-            match self.free_objects.pop_front() {
-                None => break,
-                Some(FreeObject {
-                    kind: FreeObjectKind::GeneralBuffer { allocation, .. },
-                    ..
-                }) => {
-                    debug!("purging general buffer: {}", allocation.size);
-                    self.bytes_allocated -= allocation.size;
+        }
+        for (descriptor, pool) in &mut self.free_framebuffers {
+            while let Some(free_object) = pool.front() {
+                if (now - free_object.timestamp).as_secs_f32() < DECAY_TIME {
+                    break;
                 }
-                Some(FreeObject { kind: FreeObjectKind::IndexBuffer { allocation, .. }, .. }) => {
-                    debug!("purging index buffer: {}", allocation.size);
-                    self.bytes_allocated -= allocation.size;
+                debug!("purging framebuffer: {:?}", descriptor);
+                pool.pop_front();
+                bytes_freed += descriptor.byte_size();
+            }
+        }
+
+        self.bytes_allocated -= bytes_freed;
+        self.remove_empty_pools();
+        self.compact_if_needed();
+    }
+
+    // Frees free objects regardless of age when the allocator holds far more memory than the
+    // scene is committing, so that drifting allocation sizes can't strand slabs in stale size
+    // classes indefinitely. Larger buffer size classes are drained first, since they account for
+    // the most waste.
+    fn compact_if_needed(&mut self) {
+        let slack_limit = (self.bytes_committed * COMPACTION_SLACK_FACTOR).max(MAX_SLACK_BYTES);
+        let mut slack = self.bytes_allocated - self.bytes_committed;
+        if slack <= slack_limit {
+            return;
+        }
+
+        debug!("compacting: {} B committed, {} B allocated",
+               self.bytes_committed,
+               self.bytes_allocated);
+
+        let mut buffer_size_classes: Vec<u64> = self.free_general_buffers
+                                                    .keys()
+                                                    .chain(self.free_index_buffers.keys())
+                                                    .cloned()
+                                                    .collect();
+        buffer_size_classes.sort_unstable_by(|a, b| b.cmp(a));
+        buffer_size_classes.dedup();
+
+        for byte_size in buffer_size_classes {
+            if slack <= slack_limit {
+                break;
+            }
+            if let Some(pool) = self.free_general_buffers.get_mut(&byte_size) {
+                while slack > slack_limit && pool.pop_front().is_some() {
+                    slack = slack.saturating_sub(byte_size);
                 }
-                Some(FreeObject { kind: FreeObjectKind::Texture { allocation, .. }, .. }) => {
-                    debug!("purging texture: {:?}", allocation.descriptor);
-                    self.bytes_allocated -= allocation.descriptor.byte_size();
+            }
+            if let Some(pool) = self.free_index_buffers.get_mut(&byte_size) {
+                while slack > slack_limit && pool.pop_front().is_some() {
+                    slack = slack.saturating_sub(byte_size);
                 }
-                Some(FreeObject { kind: FreeObjectKind::Framebuffer { allocation, .. }, .. }) => {
-                    debug!("purging framebuffer: {:?}", allocation.descriptor);
-                    self.bytes_allocated -= allocation.descriptor.byte_size();
+            }
+        }
+
+        if slack > slack_limit {
+            for (descriptor, pool) in &mut self.free_textures {
+                while slack > slack_limit && pool.pop_front().is_some() {
+                    slack = slack.saturating_sub(descriptor.byte_size());
                 }
             }
         }
+        if slack > slack_limit {
+            for (descriptor, pool) in &mut self.free_framebuffers {
+                while slack > slack_limit && pool.pop_front().is_some() {
+                    slack = slack.saturating_sub(descriptor.byte_size());
+                }
+            }
+        }
+
+        self.bytes_allocated = self.bytes_committed + slack;
+        self.remove_empty_pools();
+    }
+
+    fn remove_empty_pools(&mut self) {
+        self.free_general_buffers.retain(|_, pool| !pool.is_empty());
+        self.free_index_buffers.retain(|_, pool| !pool.is_empty());
+        self.free_textures.retain(|_, pool| !pool.is_empty());
+        self.free_framebuffers.retain(|_, pool| !pool.is_empty());
     }
 
     pub fn free_general_buffer(&mut self, id: GeneralBufferID) {
@@ -373,10 +428,10 @@ impl<D> GPUMemoryAllocator<D> where D: Device {
                              .remove(&id)
                              .expect("Attempted to free unallocated general buffer!");
         self.bytes_committed -= allocation.size;
-        self.free_objects.push_back(FreeObject {
-            timestamp: Instant::now(),
-            kind: FreeObjectKind::GeneralBuffer { id, allocation },
-        });
+        self.free_general_buffers
+            .entry(allocation.size)
+            .or_insert_with(VecDeque::new)
+            .push_back(FreeObject { timestamp: Instant::now(), id, allocation });
     }
 
     pub fn free_index_buffer(&mut self, id: IndexBufferID) {
@@ -384,34 +439,32 @@ impl<D> GPUMemoryAllocator<D> where D: Device {
                              .remove(&id)
                              .expect("Attempted to free unallocated index buffer!");
         self.bytes_committed -= allocation.size;
-        self.free_objects.push_back(FreeObject {
-            timestamp: Instant::now(),
-            kind: FreeObjectKind::IndexBuffer { id, allocation },
-        });
+        self.free_index_buffers
+            .entry(allocation.size)
+            .or_insert_with(VecDeque::new)
+            .push_back(FreeObject { timestamp: Instant::now(), id, allocation });
     }
 
     pub fn free_texture(&mut self, id: TextureID) {
         let allocation = self.textures_in_use
                              .remove(&id)
                              .expect("Attempted to free unallocated texture!");
-        let byte_size = allocation.descriptor.byte_size();
-        self.bytes_committed -= byte_size;
-        self.free_objects.push_back(FreeObject {
-            timestamp: Instant::now(),
-            kind: FreeObjectKind::Texture { id, allocation },
-        });
+        self.bytes_committed -= allocation.descriptor.byte_size();
+        self.free_textures
+            .entry(allocation.descriptor)
+            .or_insert_with(VecDeque::new)
+            .push_back(FreeObject { timestamp: Instant::now(), id, allocation });
     }
 
     pub fn free_framebuffer(&mut self, id: FramebufferID) {
         let allocation = self.framebuffers_in_use
                              .remove(&id)
                              .expect("Attempted to free unallocated framebuffer!");
-        let byte_size = allocation.descriptor.byte_size();
-        self.bytes_committed -= byte_size;
-        self.free_objects.push_back(FreeObject {
-            timestamp: Instant::now(),
-            kind: FreeObjectKind::Framebuffer { id, allocation },
-        });
+        self.bytes_committed -= allocation.descriptor.byte_size();
+        self.free_framebuffers
+            .entry(allocation.descriptor)
+            .or_insert_with(VecDeque::new)
+            .push_back(FreeObject { timestamp: Instant::now(), id, allocation });
     }
 
     pub fn get_general_buffer(&self, id: GeneralBufferID) -> &D::Buffer {
@@ -488,6 +541,30 @@ impl<D> GPUMemoryAllocator<D> where D: Device {
                      allocation.descriptor.format,
                      allocation.descriptor.byte_size());
         }
+
+        println!("Free pools:");
+        let mut buffer_size_classes: Vec<u64> = self.free_general_buffers
+                                                    .keys()
+                                                    .chain(self.free_index_buffers.keys())
+                                                    .cloned()
+                                                    .collect();
+        buffer_size_classes.sort_unstable();
+        buffer_size_classes.dedup();
+        for byte_size in buffer_size_classes {
+            let general_count =
+                self.free_general_buffers.get(&byte_size).map_or(0, VecDeque::len);
+            let index_count = self.free_index_buffers.get(&byte_size).map_or(0, VecDeque::len);
+            println!("size class {:?} B: {:?} general, {:?} index",
+                     byte_size,
+                     general_count,
+                     index_count);
+        }
+        for (descriptor, pool) in &self.free_textures {
+            println!("texture class {:?}: {:?} free", descriptor, pool.len());
+        }
+        for (descriptor, pool) in &self.free_framebuffers {
+            println!("framebuffer class {:?}: {:?} free", descriptor, pool.len());
+        }
     }
 }
 
@@ -25,8 +25,12 @@ use pathfinder_geometry::transform3d::Transform4F;
 use pathfinder_geometry::vector::{Vector2I, vec2i};
 use pathfinder_resources::ResourceLoader;
 use pathfinder_simd::default::{F32x2, F32x4, I32x2};
+use std::convert::TryInto;
+use std::fs;
+use std::io;
 use std::ops::Range;
 use std::os::raw::c_void;
+use std::path::PathBuf;
 use std::time::Duration;
 
 pub trait Device: Sized {
@@ -62,6 +66,17 @@ pub trait Device: Sized {
                                    name: &str,
                                    shaders: ProgramKind<Self::Shader>)
                                    -> Self::Program;
+    /// Supplies a persistent cache of driver-compiled program binaries.
+    ///
+    /// Backends that can export compiled blobs (`glGetProgramBinary` on OpenGL) consult the
+    /// cache in `create_program_from_shaders` and skip compilation on a hit, which can save
+    /// hundreds of milliseconds of startup time on some (especially embedded) drivers. Backends
+    /// without binary export support ignore the cache.
+    ///
+    /// Call this before creating a renderer so that the initial shader set benefits.
+    fn set_program_binary_cache(&mut self, cache: ProgramBinaryCache) {
+        drop(cache);
+    }
     fn set_compute_program_local_size(&self,
                                       program: &mut Self::Program,
                                       local_size: ComputeDimensions);
@@ -238,7 +253,7 @@ pub enum BufferTarget {
     Storage,
 }
 
-#[derive(Clone, Copy, Debug)]
+#[derive(Clone, Copy, PartialEq, Debug)]
 pub enum BufferUploadMode {
     Static,
     Dynamic,
@@ -260,6 +275,90 @@ pub enum ProgramKind<T> {
     Compute(T),
 }
 
+/// A compiled shader program blob exported from the GPU driver.
+#[derive(Clone)]
+pub struct ProgramBinary {
+    /// The backend- and driver-specific binary format token.
+    pub format: u32,
+    /// The opaque binary contents.
+    pub data: Vec<u8>,
+}
+
+/// A persistent on-disk cache of compiled shader program binaries.
+///
+/// Entries are keyed by program name and validated against a hash of the shader sources and a
+/// backend-supplied device identifier, so a driver update or a shader change simply results in
+/// a cache miss and a fresh compile rather than a stale binary being loaded. See
+/// `Device::set_program_binary_cache`.
+pub struct ProgramBinaryCache {
+    directory: PathBuf,
+}
+
+// Cache entry layout: magic, format version, device ID, source hash, binary format token, blob.
+const PROGRAM_BINARY_MAGIC: [u8; 4] = *b"PFpb";
+const PROGRAM_BINARY_VERSION: u32 = 1;
+const PROGRAM_BINARY_HEADER_SIZE: usize = 28;
+
+impl ProgramBinaryCache {
+    /// Creates a cache rooted at the given directory, creating the directory if needed.
+    pub fn new(directory: PathBuf) -> io::Result<ProgramBinaryCache> {
+        fs::create_dir_all(&directory)?;
+        Ok(ProgramBinaryCache { directory })
+    }
+
+    /// Loads the cached binary for the program with the given name, if present and valid.
+    ///
+    /// `device_id` identifies the driver and `source_hash` the shader sources that produced the
+    /// binary; an entry recorded under different values is treated as missing.
+    pub fn load(&self, name: &str, device_id: u64, source_hash: u64) -> Option<ProgramBinary> {
+        let contents = fs::read(self.path_for_program(name)).ok()?;
+        if contents.len() < PROGRAM_BINARY_HEADER_SIZE ||
+                contents[0..4] != PROGRAM_BINARY_MAGIC ||
+                read_u32(&contents[4..8]) != PROGRAM_BINARY_VERSION ||
+                read_u64(&contents[8..16]) != device_id ||
+                read_u64(&contents[16..24]) != source_hash {
+            return None;
+        }
+        Some(ProgramBinary {
+            format: read_u32(&contents[24..28]),
+            data: contents[PROGRAM_BINARY_HEADER_SIZE..].to_vec(),
+        })
+    }
+
+    /// Records the binary for the program with the given name, replacing any previous entry.
+    ///
+    /// Failures are logged and otherwise ignored: the cache is an optimization, not a store of
+    /// record.
+    pub fn store(&self, name: &str, device_id: u64, source_hash: u64, binary: &ProgramBinary) {
+        let mut contents = Vec::with_capacity(PROGRAM_BINARY_HEADER_SIZE + binary.data.len());
+        contents.extend_from_slice(&PROGRAM_BINARY_MAGIC);
+        contents.extend_from_slice(&PROGRAM_BINARY_VERSION.to_le_bytes());
+        contents.extend_from_slice(&device_id.to_le_bytes());
+        contents.extend_from_slice(&source_hash.to_le_bytes());
+        contents.extend_from_slice(&binary.format.to_le_bytes());
+        contents.extend_from_slice(&binary.data);
+        let path = self.path_for_program(name);
+        if let Err(err) = fs::write(&path, contents) {
+            warn!("Failed to write program binary for `{}` to {:?}: {}", name, path, err);
+        }
+    }
+
+    fn path_for_program(&self, name: &str) -> PathBuf {
+        let filename: String = name.chars()
+                                   .map(|ch| if ch.is_ascii_alphanumeric() { ch } else { '_' })
+                                   .collect();
+        self.directory.join(format!("{}.program", filename))
+    }
+}
+
+fn read_u32(bytes: &[u8]) -> u32 {
+    u32::from_le_bytes(bytes.try_into().unwrap())
+}
+
+fn read_u64(bytes: &[u8]) -> u64 {
+    u64::from_le_bytes(bytes.try_into().unwrap())
+}
+
 #[derive(Clone, Copy, Debug, PartialEq)]
 pub struct ComputeDimensions {
     pub x: u32,
@@ -0,0 +1,392 @@
+// pathfinder/lottie/src/animation.rs
+//
+// Copyright © 2020 The Pathfinder Project Developers.
+//
+// Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+// http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+// <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+// option. This file may not be copied, modified, or distributed
+// except according to those terms.
+
+//! Drives a parsed Lottie animation by mutating a retained scene in place.
+//!
+//! `Animation::new()` builds scene geometry for every shape layer once and remembers which
+//! draw path each keyframe track feeds. Each `set_frame()` call then samples only the animated
+//! tracks and applies the results through the scene's mutation API — transforms via
+//! `transform_draw_path()` and fill colors via `set_draw_path_paint()` — so the per-tick cost
+//! is proportional to the number of animated properties, not to the scene size.
+//!
+//! Like the parser, this is very incomplete: only shape layers with solid fills are handled,
+//! easing is linear, and shape vertices aren't animated yet.
+
+use crate::{Layer, Lottie, MultidimensionalPropertyValue, OffsetKeyframe, PropertyValue, Shape,
+            ShapeVertices, Transform};
+use pathfinder_color::ColorU;
+use pathfinder_content::outline::{Contour, Outline};
+use pathfinder_geometry::transform2d::Transform2F;
+use pathfinder_geometry::vector::{vec2f, Vector2F};
+use pathfinder_renderer::paint::{Paint, PaintId};
+use pathfinder_renderer::scene::{DrawPath, DrawPathId, Scene};
+
+/// An evaluator that binds a Lottie composition to draw paths in a scene and updates them in
+/// place as playback advances.
+pub struct Animation {
+    frame_rate: f32,
+    in_point: f32,
+    out_point: f32,
+    layers: Vec<LayerBinding>,
+}
+
+// A shape layer, bound to the draw paths its groups produced.
+struct LayerBinding {
+    transform: TransformTracks,
+    opacity: Option<PropertyValue>,
+    in_point: f32,
+    out_point: f32,
+    visible: bool,
+    paths: Vec<PathBinding>,
+}
+
+// One filled group, bound to the draw path that holds its geometry.
+struct PathBinding {
+    draw_path_id: DrawPathId,
+    // The geometry in group-local space, kept so the path can be rebuilt after the layer was
+    // hidden or after a non-invertible (zero-scale) transform.
+    outline: Outline,
+    // Transforms of the enclosing groups, outermost first. The layer transform is applied on
+    // top of these.
+    transform_chain: Vec<TransformTracks>,
+    color: MultidimensionalPropertyValue,
+    fill_opacity: Option<PropertyValue>,
+    paint_id: PaintId,
+    current_color: ColorU,
+    current_transform: Transform2F,
+}
+
+// The animatable parts of a layer or group transform.
+//
+// TODO: Skew.
+#[derive(Clone)]
+struct TransformTracks {
+    position: MultidimensionalPropertyValue,
+    anchor_point: MultidimensionalPropertyValue,
+    scale: MultidimensionalPropertyValue,
+    rotation: PropertyValue,
+}
+
+// A filled group discovered while flattening a layer's shape tree, before it has a draw path.
+struct PendingPath {
+    outline: Outline,
+    transform_chain: Vec<TransformTracks>,
+    color: MultidimensionalPropertyValue,
+    fill_opacity: Option<PropertyValue>,
+}
+
+impl Animation {
+    /// Builds draw paths for every shape layer of `lottie` in `scene` and binds the animation's
+    /// keyframe tracks to them. The scene is left showing the composition's in point.
+    pub fn new(lottie: &Lottie, scene: &mut Scene) -> Animation {
+        let mut animation = Animation {
+            frame_rate: lottie.frame_rate as f32,
+            in_point: lottie.in_point as f32,
+            out_point: lottie.out_point as f32,
+            layers: vec![],
+        };
+
+        for layer in &lottie.layers {
+            let Layer::Shape { ref transform, in_point, out_point, ref shapes, .. } = *layer;
+
+            let mut pending_paths = vec![];
+            flatten_shapes(shapes, &[], &mut pending_paths);
+
+            let mut layer_binding = LayerBinding {
+                transform: TransformTracks::from_layer_transform(transform),
+                opacity: transform.opacity.clone(),
+                in_point: in_point as f32,
+                out_point: out_point as f32,
+                visible: false,
+                paths: vec![],
+            };
+
+            // Push a placeholder per path; the `set_frame()` below fills in geometry for
+            // whatever is visible at the in point.
+            for pending_path in pending_paths {
+                let color = ColorU::new(0, 0, 0, 0);
+                let paint_id = scene.push_paint(&Paint::from_color(color));
+                let draw_path_id = scene.push_draw_path(DrawPath::new(Outline::new(), paint_id));
+                layer_binding.paths.push(PathBinding {
+                    draw_path_id,
+                    outline: pending_path.outline,
+                    transform_chain: pending_path.transform_chain,
+                    color: pending_path.color,
+                    fill_opacity: pending_path.fill_opacity,
+                    paint_id,
+                    current_color: color,
+                    current_transform: Transform2F::default(),
+                });
+            }
+
+            animation.layers.push(layer_binding);
+        }
+
+        let in_point = animation.in_point;
+        animation.set_frame(in_point, scene);
+        animation
+    }
+
+    /// Updates the scene to show the given frame, touching only draw paths whose animated
+    /// transforms or paints actually changed.
+    pub fn set_frame(&mut self, frame: f32, scene: &mut Scene) {
+        for layer in &mut self.layers {
+            let was_visible = layer.visible;
+            layer.visible = frame >= layer.in_point && frame < layer.out_point;
+            if !layer.visible {
+                if was_visible {
+                    for path in &layer.paths {
+                        scene.remove_draw_path(path.draw_path_id);
+                    }
+                }
+                continue;
+            }
+
+            let layer_transform = layer.transform.sample(frame);
+            let layer_opacity = sample_opacity(&layer.opacity, frame);
+
+            for path in &mut layer.paths {
+                let mut transform = layer_transform;
+                for tracks in &path.transform_chain {
+                    transform = transform * tracks.sample(frame);
+                }
+
+                if !was_visible || path.current_transform.matrix.det() == 0.0 {
+                    // No usable previous state; rebuild the path from the base outline.
+                    let mut outline = path.outline.clone();
+                    outline.transform(&transform);
+                    scene.replace_draw_path(path.draw_path_id,
+                                            DrawPath::new(outline, path.paint_id));
+                } else if transform != path.current_transform {
+                    let delta = transform * path.current_transform.inverse();
+                    scene.transform_draw_path(path.draw_path_id, &delta);
+                }
+                path.current_transform = transform;
+
+                let color = sample_color(&path.color, &path.fill_opacity, layer_opacity, frame);
+                if color != path.current_color {
+                    path.paint_id = scene.push_paint(&Paint::from_color(color));
+                    scene.set_draw_path_paint(path.draw_path_id, path.paint_id);
+                    path.current_color = color;
+                }
+            }
+        }
+    }
+
+    #[inline]
+    pub fn frame_rate(&self) -> f32 {
+        self.frame_rate
+    }
+
+    #[inline]
+    pub fn in_point(&self) -> f32 {
+        self.in_point
+    }
+
+    #[inline]
+    pub fn out_point(&self) -> f32 {
+        self.out_point
+    }
+}
+
+impl TransformTracks {
+    fn from_layer_transform(transform: &Transform) -> TransformTracks {
+        TransformTracks {
+            position: transform.position.clone(),
+            anchor_point: transform.anchor_point.clone(),
+            scale: transform.scale.clone(),
+            rotation: transform.rotation.clone(),
+        }
+    }
+
+    fn sample(&self, frame: f32) -> Transform2F {
+        let position = to_vec2(&sample_vector_track(&self.position, frame));
+        let anchor_point = to_vec2(&sample_vector_track(&self.anchor_point, frame));
+        let scale = to_vec2(&sample_vector_track(&self.scale, frame)) * (1.0 / 100.0);
+        let rotation = sample_scalar_track(&self.rotation, frame).to_radians();
+        Transform2F::from_translation(position) *
+            Transform2F::from_rotation(rotation) *
+            Transform2F::from_scale(scale) *
+            Transform2F::from_translation(-anchor_point)
+    }
+}
+
+// Collects each filled group of a layer's shape tree into a pending path, remembering the
+// group transforms on the way down.
+fn flatten_shapes(shapes: &[Shape],
+                  transform_chain: &[TransformTracks],
+                  pending_paths: &mut Vec<PendingPath>) {
+    // The group's own transform applies to everything in it, so find it before walking the
+    // items. (In bodymovin output it's the last item of the group.)
+    let mut transform_chain = transform_chain.to_vec();
+    for shape in shapes {
+        if let Shape::Transform { ref rotation, ref position, ref anchor_point, ref scale, .. } =
+                *shape {
+            transform_chain.push(TransformTracks {
+                position: position.clone(),
+                anchor_point: anchor_point.clone(),
+                scale: scale.clone(),
+                rotation: rotation.clone(),
+            });
+        }
+    }
+
+    let mut outline = Outline::new();
+    let mut fill = None;
+    for shape in shapes {
+        match *shape {
+            Shape::Group { ref items, .. } => {
+                flatten_shapes(items, &transform_chain, pending_paths)
+            }
+            Shape::Shape { ref vertices, .. } => push_shape_contour(&mut outline, vertices),
+            Shape::Fill { ref color, ref opacity, .. } => {
+                if fill.is_none() {
+                    fill = Some((color, opacity));
+                }
+            }
+            // TODO: Strokes, gradients, trim paths…
+            _ => {}
+        }
+    }
+
+    if let Some((color, opacity)) = fill {
+        if !outline.contours().is_empty() {
+            pending_paths.push(PendingPath {
+                outline,
+                transform_chain,
+                color: color.clone(),
+                fill_opacity: opacity.clone(),
+            });
+        }
+    }
+}
+
+fn push_shape_contour(outline: &mut Outline, vertices: &ShapeVertices) {
+    let shape = match *vertices {
+        ShapeVertices::Shape { ref value, .. } => value,
+        ShapeVertices::ShapeKeyframed { ref value, .. } => {
+            // TODO: Animate vertices. For now, take the shape of the first keyframe.
+            match value.iter().flat_map(|keyframe| keyframe.start.iter().flatten()).next() {
+                Some(shape) => shape,
+                None => return,
+            }
+        }
+    };
+    if shape.vertices.is_empty() {
+        return;
+    }
+
+    let point = |p: [f32; 2]| vec2f(p[0], p[1]);
+    let mut contour = Contour::new();
+    contour.push_endpoint(point(shape.vertices[0]));
+    for index in 1..shape.vertices.len() {
+        let from = point(shape.vertices[index - 1]);
+        let to = point(shape.vertices[index]);
+        // The in and out points are offsets from their vertices.
+        contour.push_cubic(from + point(shape.out_points[index - 1]),
+                           to + point(shape.in_points[index]),
+                           to);
+    }
+    if shape.closed {
+        let last = shape.vertices.len() - 1;
+        contour.push_cubic(point(shape.vertices[last]) + point(shape.out_points[last]),
+                           point(shape.vertices[0]) + point(shape.in_points[0]),
+                           point(shape.vertices[0]));
+        contour.close();
+    }
+    outline.push_contour(contour);
+}
+
+fn sample_scalar_track(track: &PropertyValue, frame: f32) -> f32 {
+    match *track {
+        PropertyValue::Value { value, .. } => value,
+        PropertyValue::KeyframedValue { ref keyframes, .. } => {
+            let keyframes: Vec<_> = keyframes.iter()
+                                             .map(|keyframe| {
+                                                 (keyframe.time, keyframe.start.as_deref())
+                                             })
+                                             .collect();
+            sample_keyframes(&keyframes, frame).first().copied().unwrap_or(0.0)
+        }
+    }
+}
+
+fn sample_vector_track(track: &MultidimensionalPropertyValue, frame: f32) -> Vec<f32> {
+    match *track {
+        MultidimensionalPropertyValue::Value { ref value, .. } => value.clone(),
+        MultidimensionalPropertyValue::KeyframedValue { ref keyframes, .. } => {
+            let keyframes: Vec<_> =
+                keyframes.iter()
+                         .map(|keyframe: &OffsetKeyframe| {
+                             (keyframe.time, keyframe.start.as_deref())
+                         })
+                         .collect();
+            sample_keyframes(&keyframes, frame)
+        }
+    }
+}
+
+// Samples a keyframe track at `frame`, interpolating componentwise between the bracketing
+// keyframes. A keyframe without a start value holds the previous value, which is how
+// bodymovin marks the end of a track.
+//
+// TODO: Honor the Bézier easing parameters; this is linear.
+fn sample_keyframes(keyframes: &[(i64, Option<&[f32]>)], frame: f32) -> Vec<f32> {
+    let mut prev_index = 0;
+    for (index, &(time, _)) in keyframes.iter().enumerate() {
+        if time as f32 <= frame {
+            prev_index = index;
+        } else {
+            break;
+        }
+    }
+
+    let prev_value = keyframes[..=prev_index].iter().rev().find_map(|&(_, value)| value);
+    let prev_value = match prev_value {
+        Some(prev_value) => prev_value,
+        None => return vec![],
+    };
+
+    let prev_time = keyframes[prev_index].0 as f32;
+    match keyframes.get(prev_index + 1) {
+        Some(&(next_time, Some(next_value))) if frame >= prev_time => {
+            let t = ((frame - prev_time) / (next_time as f32 - prev_time)).max(0.0).min(1.0);
+            prev_value.iter()
+                      .zip(next_value)
+                      .map(|(&prev, &next)| prev + (next - prev) * t)
+                      .collect()
+        }
+        _ => prev_value.to_vec(),
+    }
+}
+
+fn sample_opacity(track: &Option<PropertyValue>, frame: f32) -> f32 {
+    match *track {
+        Some(ref track) => sample_scalar_track(track, frame) * (1.0 / 100.0),
+        None => 1.0,
+    }
+}
+
+fn sample_color(track: &MultidimensionalPropertyValue,
+                fill_opacity: &Option<PropertyValue>,
+                layer_opacity: f32,
+                frame: f32)
+                -> ColorU {
+    let components = sample_vector_track(track, frame);
+    let component = |index: usize| components.get(index).copied().unwrap_or(0.0);
+    let alpha = components.get(3).copied().unwrap_or(1.0) *
+        sample_opacity(fill_opacity, frame) * layer_opacity;
+    let to_u8 = |value: f32| (value.max(0.0).min(1.0) * 255.0).round() as u8;
+    ColorU::new(to_u8(component(0)), to_u8(component(1)), to_u8(component(2)), to_u8(alpha))
+}
+
+fn to_vec2(components: &[f32]) -> Vector2F {
+    vec2f(components.get(0).copied().unwrap_or(0.0), components.get(1).copied().unwrap_or(0.0))
+}
@@ -14,6 +14,10 @@ use serde::{Deserialize, Serialize};
 use serde_json::Error as JSONError;
 use std::io::Read;
 
+pub use crate::animation::Animation;
+
+mod animation;
+
 #[derive(Clone, Debug, Serialize, Deserialize)]
 pub struct Lottie {
     #[serde(rename = "v")]
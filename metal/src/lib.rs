@@ -32,7 +32,7 @@ use libc::size_t;
 use metal::{self, Argument, ArgumentEncoder, BlitCommandEncoder, Buffer, CommandBuffer};
 use metal::{CommandQueue, CompileOptions, ComputeCommandEncoder, ComputePipelineDescriptor};
 use metal::{ComputePipelineState, CoreAnimationDrawable, CoreAnimationDrawableRef};
-use metal::{CoreAnimationLayer, CoreAnimationLayerRef, DepthStencilDescriptor, Device as NativeMetalDevice, DeviceRef, Function, Library};
+use metal::{CoreAnimationLayer, CoreAnimationLayerRef, DepthStencilDescriptor, Device as NativeMetalDevice, DeviceRef, Function, Heap, HeapDescriptor, Library};
 use metal::{MTLArgument, MTLArgumentEncoder, MTLArgumentType, MTLBlendFactor, MTLBlendOperation};
 use metal::{MTLBlitOption, MTLClearColor, MTLColorWriteMask, MTLCompareFunction, MTLComputePipelineState};
 use metal::{MTLDataType, MTLDevice, MTLIndexType, MTLLoadAction, MTLOrigin, MTLPixelFormat};
@@ -69,11 +69,21 @@ use std::time::{Duration, Instant};
 
 const FIRST_VERTEX_BUFFER_INDEX: u64 = 16;
 
+// The size of each heap that private buffers and textures are sub-allocated from. Resources
+// bigger than this get a heap of their own.
+const HEAP_BLOCK_SIZE: u64 = 16 * 1024 * 1024;
+
+// The maximum number of staging buffers to create per GPU resource before waiting for an earlier
+// upload to finish. Three buffers allow the CPU to encode a new frame while the GPU executes the
+// two before it.
+const MAX_STAGING_BUFFERS_PER_RESOURCE: usize = 3;
+
 pub struct MetalDevice {
     device: NativeMetalDevice,
     main_color_texture: Texture,
     main_depth_stencil_texture: Texture,
     command_queue: CommandQueue,
+    heap_allocator: MetalHeapAllocator,
     scopes: RefCell<Vec<Scope>>,
     samplers: Vec<SamplerState>,
     #[allow(dead_code)]
@@ -110,7 +120,7 @@ pub struct MetalBuffer {
 
 struct BufferAllocations {
     private: Option<Buffer>,
-    shared: Option<StagingBuffer>,
+    staging_buffers: Vec<StagingBuffer>,
     byte_size: u64,
 }
 
@@ -119,6 +129,98 @@ struct StagingBuffer {
     event_value: u64,
 }
 
+// Sub-allocates private buffers and textures out of large `MTLHeap`s. This is much cheaper than
+// creating individual resources, and it lets frames overlap without the per-allocation
+// synchronization that standalone resources impose.
+//
+// Heaps are untracked by default in Metal 2, which would require manual hazard tracking with
+// fences. We therefore only sub-allocate on OS versions that support per-resource hazard
+// tracking for heaps (macOS 10.15/iOS 13); elsewhere we fall back to standalone allocations.
+struct MetalHeapAllocator {
+    heaps: RefCell<Vec<Heap>>,
+    supports_tracked_heaps: bool,
+}
+
+impl MetalHeapAllocator {
+    fn new() -> MetalHeapAllocator {
+        let supports_tracked_heaps = unsafe {
+            let responds: bool = msg_send![class!(MTLHeapDescriptor),
+                                           instancesRespondToSelector:sel!(setHazardTrackingMode:)];
+            responds
+        };
+        MetalHeapAllocator { heaps: RefCell::new(vec![]), supports_tracked_heaps }
+    }
+
+    fn add_heap(&self, device: &NativeMetalDevice, min_size: u64) {
+        let descriptor = HeapDescriptor::new();
+        descriptor.set_size(HEAP_BLOCK_SIZE.max(min_size));
+        descriptor.set_storage_mode(MTLStorageMode::Private);
+        unsafe {
+            // MTLHazardTrackingModeTracked. Make the driver track hazards between
+            // sub-allocated resources, just as it does for standalone ones.
+            let () = msg_send![descriptor.as_ptr() as *mut Object,
+                               setHazardTrackingMode:2 as NSUInteger];
+        }
+        self.heaps.borrow_mut().push(device.new_heap(&descriptor));
+    }
+
+    fn allocate_buffer(&self,
+                       device: &NativeMetalDevice,
+                       byte_size: u64,
+                       options: MTLResourceOptions)
+                       -> Buffer {
+        if !self.supports_tracked_heaps {
+            return device.new_buffer(byte_size, options);
+        }
+
+        // CPU cache mode is meaningless for private storage, and the heap's resource options
+        // must match those of its sub-allocations.
+        let options = MTLResourceOptions::StorageModePrivate;
+        {
+            let heaps = self.heaps.borrow();
+            for heap in heaps.iter() {
+                if let Some(buffer) = heap.new_buffer(byte_size, options) {
+                    return buffer;
+                }
+            }
+        }
+
+        let size_and_align = device.heap_buffer_size_and_align(byte_size, options);
+        self.add_heap(device, size_and_align.size + size_and_align.align);
+        self.heaps
+            .borrow()
+            .last()
+            .unwrap()
+            .new_buffer(byte_size, options)
+            .expect("Failed to sub-allocate buffer from new heap!")
+    }
+
+    fn allocate_texture(&self, device: &NativeMetalDevice, descriptor: &TextureDescriptor)
+                        -> Texture {
+        if !self.supports_tracked_heaps {
+            return device.new_texture(descriptor);
+        }
+
+        {
+            let heaps = self.heaps.borrow();
+            for heap in heaps.iter() {
+                if let Some(texture) = heap.new_texture(descriptor) {
+                    return texture;
+                }
+            }
+        }
+
+        let size_and_align = device.heap_texture_size_and_align(descriptor);
+        self.add_heap(device, size_and_align.size + size_and_align.align);
+        self.heaps
+            .borrow()
+            .last()
+            .unwrap()
+            .new_texture(descriptor)
+            .expect("Failed to sub-allocate texture from new heap!")
+    }
+}
+
 struct Scope {
     autorelease_pool: id,
     command_buffer: CommandBuffer,
@@ -180,6 +282,7 @@ impl MetalDevice {
         });
 
         MetalDevice {
+            heap_allocator: MetalHeapAllocator::new(),
             device,
             main_color_texture: texture,
             main_depth_stencil_texture,
@@ -235,7 +338,7 @@ pub struct MetalShader {
 
 pub struct MetalTexture {
     private_texture: Texture,
-    shared_buffer: RefCell<Option<Buffer>>,
+    staging_buffers: RefCell<Vec<StagingBuffer>>,
     sampling_flags: Cell<TextureSamplingFlags>,
 }
 
@@ -388,8 +491,8 @@ impl Device for MetalDevice {
         let descriptor = create_texture_descriptor(format, size);
         descriptor.set_storage_mode(MTLStorageMode::Private);
         MetalTexture {
-            private_texture: self.device.new_texture(&descriptor),
-            shared_buffer: RefCell::new(None),
+            private_texture: self.heap_allocator.allocate_texture(&self.device, &descriptor),
+            staging_buffers: RefCell::new(vec![]),
             sampling_flags: Cell::new(TextureSamplingFlags::empty()),
         }
     }
@@ -612,7 +715,7 @@ impl Device for MetalDevice {
         MetalBuffer {
             allocations: Rc::new(RefCell::new(BufferAllocations {
                 private: None,
-                shared: None,
+                staging_buffers: vec![],
                 byte_size: 0,
             })),
             mode,
@@ -629,11 +732,11 @@ impl Device for MetalDevice {
             BufferData::Memory(slice) => slice.len(),
         };
         let byte_size = (length * mem::size_of::<T>()) as u64;
-        let new_buffer = self.device.new_buffer(byte_size, options);
+        let new_buffer = self.heap_allocator.allocate_buffer(&self.device, byte_size, options);
 
         *buffer.allocations.borrow_mut() = BufferAllocations {
              private: Some(new_buffer),
-             shared: None,
+             staging_buffers: vec![],
              byte_size,
         };
 
@@ -659,22 +762,9 @@ impl Device for MetalDevice {
         let byte_start = (start * mem::size_of::<T>()) as u64;
         let byte_size = (data.len() * mem::size_of::<T>()) as u64;
 
-        if dest_allocations.shared.is_none() {
-            let resource_options = MTLResourceOptions::CPUCacheModeWriteCombined |
-                MTLResourceOptions::StorageModeShared;
-            dest_allocations.shared = Some(StagingBuffer {
-                buffer: self.device.new_buffer(dest_allocations.byte_size, resource_options),
-                event_value: 0,
-            });
-        }
-
-        let staging_buffer = dest_allocations.shared.as_mut().unwrap();
-        if staging_buffer.event_value != 0 {
-            let mut mutex = self.buffer_upload_event_data.mutex.lock().unwrap();
-            while *mutex < staging_buffer.event_value {
-                mutex = self.buffer_upload_event_data.cond.wait(mutex).unwrap();
-            }
-        }
+        let buffer_byte_size = dest_allocations.byte_size;
+        let staging_buffer = self.acquire_staging_buffer(&mut dest_allocations.staging_buffers,
+                                                         buffer_byte_size);
 
         unsafe {
             ptr::copy_nonoverlapping(
@@ -683,9 +773,6 @@ impl Device for MetalDevice {
                 byte_size as usize)
         }
 
-        staging_buffer.event_value = self.next_buffer_upload_event_value.get();
-        self.next_buffer_upload_event_value.set(staging_buffer.event_value + 1);
-
         {
             let scopes = self.scopes.borrow();
             let command_buffer = &scopes.last().unwrap().command_buffer;
@@ -697,19 +784,7 @@ impl Device for MetalDevice {
                                                 byte_size);
             blit_command_encoder.end_encoding();
 
-            command_buffer.encode_signal_event(&self.buffer_upload_shared_event,
-                                               staging_buffer.event_value);
-
-            let buffer_upload_event_data = self.buffer_upload_event_data.clone();
-            let event_value = staging_buffer.event_value;
-            let listener_block = ConcreteBlock::new(move |_, _| {
-                let mut mutex = buffer_upload_event_data.mutex.lock().unwrap();
-                *mutex = (*mutex).max(event_value);
-                buffer_upload_event_data.cond.notify_all();
-            });
-            self.buffer_upload_shared_event.notify_listener_at_value(&self.shared_event_listener,   
-                                                                     staging_buffer.event_value,
-                                                                     listener_block.copy());
+            self.signal_staging_buffer_copy(command_buffer, staging_buffer);
         }
 
         // Flush to avoid deadlock.
@@ -747,32 +822,21 @@ impl Device for MetalDevice {
     }
 
     fn upload_to_texture(&self, dest_texture: &MetalTexture, rect: RectI, data: TextureDataRef) {
-        let scopes = self.scopes.borrow();
-        let command_buffer = &scopes.last()
-                                    .expect("Must call `begin_commands()` first!")
-                                    .command_buffer;
-
         let texture_size = self.texture_size(dest_texture);
         let texture_format = self.texture_format(&dest_texture.private_texture)
                                  .expect("Unexpected texture format!");
         let bytes_per_pixel = texture_format.bytes_per_pixel() as u64;
         let texture_byte_size = texture_size.area() as u64 * bytes_per_pixel;
 
-        let mut src_shared_buffer = dest_texture.shared_buffer.borrow_mut();
-        if src_shared_buffer.is_none() {
-            let resource_options = MTLResourceOptions::CPUCacheModeWriteCombined |
-                MTLResourceOptions::StorageModeShared;
-            *src_shared_buffer = Some(self.device.new_buffer(texture_byte_size, resource_options));
-        }
+        let mut staging_buffers = dest_texture.staging_buffers.borrow_mut();
+        let staging_buffer = self.acquire_staging_buffer(&mut staging_buffers, texture_byte_size);
 
-        // TODO(pcwalton): Wait if necessary...
-        let src_shared_buffer = src_shared_buffer.as_ref().unwrap();
         let texture_data_ptr =
             data.check_and_extract_data_ptr(rect.size(), texture_format) as *const u8;
         let src_stride = rect.width() as u64 * bytes_per_pixel;
         let dest_stride = texture_size.x() as u64 * bytes_per_pixel;
         unsafe {
-            let dest_contents = src_shared_buffer.contents() as *mut u8;
+            let dest_contents = staging_buffer.buffer.contents() as *mut u8;
             for src_y in 0..rect.height() {
                 let dest_y = src_y + rect.origin_y();
                 let src_offset = src_y as isize * src_stride as isize;
@@ -793,8 +857,13 @@ impl Device for MetalDevice {
         let dest_byte_offset = rect.origin_y() as u64 * src_stride as u64 +
             rect.origin_x() as u64 * bytes_per_pixel as u64;
 
+        let scopes = self.scopes.borrow();
+        let command_buffer = &scopes.last()
+                                    .expect("Must call `begin_commands()` first!")
+                                    .command_buffer;
+
         let blit_command_encoder = command_buffer.real_new_blit_command_encoder();
-        blit_command_encoder.copy_from_buffer_to_texture(&src_shared_buffer,
+        blit_command_encoder.copy_from_buffer_to_texture(&staging_buffer.buffer,
                                                          dest_byte_offset,
                                                          dest_stride,
                                                          0,
@@ -805,6 +874,8 @@ impl Device for MetalDevice {
                                                          dest_origin,
                                                          MTLBlitOption::empty());
         blit_command_encoder.end_encoding();
+
+        self.signal_staging_buffer_copy(command_buffer, staging_buffer);
     }
 
     fn read_pixels(&self, target: &RenderTarget<MetalDevice>, viewport: RectI)
@@ -844,16 +915,10 @@ impl Device for MetalDevice {
                                                     .as_ref()
                                                     .expect("Private buffer not allocated!");
 
-            if src_allocations.shared.is_none() {
-                let resource_options = MTLResourceOptions::CPUCacheModeWriteCombined |
-                    MTLResourceOptions::StorageModeShared;
-                src_allocations.shared = Some(StagingBuffer {
-                    buffer: self.device.new_buffer(src_allocations.byte_size, resource_options),
-                    event_value: 0,
-                });
-            }
-
-            let staging_buffer = src_allocations.shared.as_ref().unwrap();
+            let buffer_byte_size = src_allocations.byte_size;
+            let staging_buffer =
+                self.acquire_staging_buffer(&mut src_allocations.staging_buffers,
+                                            buffer_byte_size);
             let byte_size = (range.end - range.start) as u64;
             let blit_command_encoder = command_buffer.real_new_blit_command_encoder();
             blit_command_encoder.copy_from_buffer(src_private_buffer,
@@ -870,6 +935,8 @@ impl Device for MetalDevice {
 
             blit_command_encoder.end_encoding();
 
+            self.signal_staging_buffer_copy(command_buffer, staging_buffer);
+
             let buffer_data_receiver_for_block = buffer_data_receiver.clone();
             let block = ConcreteBlock::new(move |_| buffer_data_receiver_for_block.download());
             command_buffer.add_completed_handler(block.copy());
@@ -1157,6 +1224,78 @@ impl Device for MetalDevice {
 }
 
 impl MetalDevice {
+    // Returns a staging buffer of the given size that the GPU is no longer copying from.
+    //
+    // Staging buffers the GPU has finished with are reused immediately. If they're all still in
+    // flight, a fresh one is created, up to a limit that allows the CPU to encode new frames
+    // while the GPU works through earlier ones; past that limit, this method blocks until the
+    // least recently used buffer becomes free.
+    fn acquire_staging_buffer<'a>(&self,
+                                  staging_buffers: &'a mut Vec<StagingBuffer>,
+                                  byte_size: u64)
+                                  -> &'a mut StagingBuffer {
+        let completed_event_value = *self.buffer_upload_event_data.mutex.lock().unwrap();
+        let staging_buffer_index = match staging_buffers.iter().position(|staging_buffer| {
+            staging_buffer.event_value <= completed_event_value
+        }) {
+            Some(index) => index,
+            None if staging_buffers.len() < MAX_STAGING_BUFFERS_PER_RESOURCE => {
+                let resource_options = MTLResourceOptions::CPUCacheModeWriteCombined |
+                    MTLResourceOptions::StorageModeShared;
+                staging_buffers.push(StagingBuffer {
+                    buffer: self.device.new_buffer(byte_size, resource_options),
+                    event_value: 0,
+                });
+                staging_buffers.len() - 1
+            }
+            None => {
+                let index = staging_buffers.iter()
+                                           .enumerate()
+                                           .min_by_key(|&(_, staging_buffer)| {
+                                               staging_buffer.event_value
+                                           })
+                                           .unwrap()
+                                           .0;
+                let event_value = staging_buffers[index].event_value;
+
+                // The signals for the in-flight copies may still be sitting in the current
+                // command buffer; commit it before blocking, or the wait never ends.
+                self.end_commands();
+                self.begin_commands();
+
+                let mut mutex = self.buffer_upload_event_data.mutex.lock().unwrap();
+                while *mutex < event_value {
+                    mutex = self.buffer_upload_event_data.cond.wait(mutex).unwrap();
+                }
+                index
+            }
+        };
+        &mut staging_buffers[staging_buffer_index]
+    }
+
+    // Encodes a signal of the buffer upload event after the commands in flight, so that
+    // `acquire_staging_buffer()` knows when the staging buffer can be reused.
+    fn signal_staging_buffer_copy(&self,
+                                  command_buffer: &CommandBuffer,
+                                  staging_buffer: &mut StagingBuffer) {
+        staging_buffer.event_value = self.next_buffer_upload_event_value.get();
+        self.next_buffer_upload_event_value.set(staging_buffer.event_value + 1);
+
+        command_buffer.encode_signal_event(&self.buffer_upload_shared_event,
+                                           staging_buffer.event_value);
+
+        let buffer_upload_event_data = self.buffer_upload_event_data.clone();
+        let event_value = staging_buffer.event_value;
+        let listener_block = ConcreteBlock::new(move |_, _| {
+            let mut mutex = buffer_upload_event_data.mutex.lock().unwrap();
+            *mutex = (*mutex).max(event_value);
+            buffer_upload_event_data.cond.notify_all();
+        });
+        self.buffer_upload_shared_event.notify_listener_at_value(&self.shared_event_listener,
+                                                                 event_value,
+                                                                 listener_block.copy());
+    }
+
     fn get_uniform_index(&self, shader: &MetalShader, name: &str) -> Option<MetalUniformIndex> {
         let uniforms = shader.arguments.borrow();
         let arguments = match *uniforms {
@@ -13,16 +13,18 @@
 use crate::concurrent::executor::Executor;
 use crate::gpu::blend::BlendModeExt;
 use crate::gpu::options::RendererLevel;
+use crate::gpu::perf::CPUBuildTimes;
 use crate::gpu_data::{AlphaTileId, BackdropInfoD3D11, Clip, ClippedPathInfo, DiceMetadataD3D11};
 use crate::gpu_data::{DrawTileBatch, DrawTileBatchD3D9, DrawTileBatchD3D11, Fill, GlobalPathId};
 use crate::gpu_data::{PathBatchIndex, PathSource, PrepareTilesInfoD3D11, PropagateMetadataD3D11};
-use crate::gpu_data::{RenderCommand, SegmentIndicesD3D11, SegmentsD3D11, TileBatchDataD3D11};
+use crate::gpu_data::{RenderCommand, SegmentIndicesD3D11, SegmentsD3D11, StrokeSegmentD3D11};
+use crate::gpu_data::TileBatchDataD3D11;
 use crate::gpu_data::{TileBatchId, TileBatchTexture, TileObjectPrimitive, TilePathInfoD3D11};
 use crate::options::{PrepareMode, PreparedBuildOptions, PreparedRenderTransform};
 use crate::paint::{PaintId, PaintInfo, PaintMetadata};
-use crate::scene::{ClipPathId, DisplayItem, DrawPath, DrawPathId, LastSceneInfo, PathId};
-use crate::scene::{Scene, SceneSink};
-use crate::tile_map::DenseTileMap;
+use crate::scene::{ClipPathId, DirtyDrawPaths, DisplayItem, DrawPath, DrawPathId, SymbolRenderKey};
+use crate::scene::{LastSceneInfo, PathId, Scene, SceneId, SceneSink};
+use crate::tile_map::{DenseTileMap, SparseTileMap, TileMap, TileMapEntry};
 use crate::tiler::Tiler;
 use crate::tiles::{self, DrawTilingPathInfo, TILE_HEIGHT, TILE_WIDTH, TilingPathInfo};
 use fxhash::FxHashMap;
@@ -30,15 +32,21 @@ use instant::Instant;
 use pathfinder_content::effects::{BlendMode, Filter};
 use pathfinder_content::fill::FillRule;
 use pathfinder_content::outline::{Outline, PointFlags};
+use pathfinder_content::stroke::{LineCap, LineJoin, OutlineStrokeToFill, StrokeStyle};
 use pathfinder_geometry::line_segment::{LineSegment2F, LineSegmentU16};
 use pathfinder_geometry::rect::{RectF, RectI};
 use pathfinder_geometry::transform2d::Transform2F;
-use pathfinder_geometry::vector::{Vector2I, vec2i};
+use pathfinder_geometry::vector::{Vector2F, Vector2I, vec2i};
 use pathfinder_gpu::TextureSamplingFlags;
-use pathfinder_simd::default::F32x4;
+use pathfinder_simd::default::{F32x4, I32x4};
+use pathfinder_simd::wide::F32x8;
 use std::borrow::Cow;
+use std::f32::consts::SQRT_2;
+use std::mem;
 use std::ops::Range;
-use std::sync::atomic::AtomicUsize;
+use std::sync::Mutex;
+use std::sync::atomic::{AtomicU64, AtomicUsize, Ordering};
+use std::time::Duration;
 use std::u32;
 
 pub(crate) const ALPHA_TILE_LEVEL_COUNT: usize = 2;
@@ -49,13 +57,60 @@ const CURVE_IS_CUBIC:     u32 = 0x40000000;
 
 const MAX_CLIP_BATCHES: u32 = 32;
 
+// The number of segments and points reserved per GPU-stroked input segment. Each input segment
+// expands to a closed capsule: one offset cubic per side and two quadratic arcs per end cap, plus
+// a repeated closing point.
+const STROKE_CAPSULE_SEGMENT_COUNT: usize = 6;
+const STROKE_CAPSULE_POINT_COUNT: usize = 15;
+
+const SYMBOL_TILE_CACHE_SIZE: usize = 1024;
+
+// Paths whose tile rect covers at least this many tiles use a `SparseTileMap` instead of a
+// `DenseTileMap` during CPU tiling.
+const SPARSE_TILE_MAP_MIN_AREA: i32 = 64 * 64;
+
 pub(crate) struct SceneBuilder<'a, 'b, 'c, 'd> {
     pub(crate) scene: &'a mut Scene,
     built_options: &'b PreparedBuildOptions,
     next_alpha_tile_indices: [AtomicUsize; ALPHA_TILE_LEVEL_COUNT],
+    pub(crate) build_time_counters: BuildTimeCounters,
     pub(crate) sink: &'c mut SceneSink<'d>,
 }
 
+// Accumulates per-stage CPU build times. The tiling stages run on worker threads, so the
+// counters are atomic nanosecond sums over all workers.
+#[derive(Default)]
+pub(crate) struct BuildTimeCounters {
+    dice_nanos: AtomicU64,
+    fill_nanos: AtomicU64,
+    tile_prepare_nanos: AtomicU64,
+}
+
+impl BuildTimeCounters {
+    pub(crate) fn add_dice_time(&self, duration: Duration) {
+        self.dice_nanos.fetch_add(duration.as_nanos() as u64, Ordering::Relaxed);
+    }
+
+    pub(crate) fn add_fill_time(&self, duration: Duration) {
+        self.fill_nanos.fetch_add(duration.as_nanos() as u64, Ordering::Relaxed);
+    }
+
+    pub(crate) fn add_tile_prepare_time(&self, duration: Duration) {
+        self.tile_prepare_nanos.fetch_add(duration.as_nanos() as u64, Ordering::Relaxed);
+    }
+
+    fn to_times(&self, paint_time: Duration, batch_time: Duration) -> CPUBuildTimes {
+        CPUBuildTimes {
+            dice_time: Duration::from_nanos(self.dice_nanos.load(Ordering::Relaxed)),
+            fill_time: Duration::from_nanos(self.fill_nanos.load(Ordering::Relaxed)),
+            tile_prepare_time:
+                Duration::from_nanos(self.tile_prepare_nanos.load(Ordering::Relaxed)),
+            paint_time,
+            batch_time,
+        }
+    }
+}
+
 #[derive(Debug)]
 pub(crate) struct ObjectBuilder {
     pub built_path: BuiltPath,
@@ -87,7 +142,7 @@ impl BuiltDrawPath {
             filter: paint_metadata.filter(),
             color_texture: paint_metadata.tile_batch_texture(),
             sampling_flags_1: TextureSamplingFlags::empty(),
-            mask_0_fill_rule: path_object.fill_rule(),
+            mask_0_fill_rule: path_object.effective_fill_rule(),
             blend_mode,
             occludes,
         }
@@ -117,7 +172,7 @@ pub(crate) struct BuiltPathBinCPUData {
     /// During tiling, or if backdrop computation is done on GPU, this stores the sum of backdrops
     /// for tile columns above the viewport.
     pub backdrops: Vec<i32>,
-    pub tiles: DenseTileMap<TileObjectPrimitive>,
+    pub tiles: TileMap<TileObjectPrimitive>,
     pub clip_tiles: Option<DenseTileMap<Clip>>,
 }
 
@@ -141,6 +196,7 @@ impl<'a, 'b, 'c, 'd> SceneBuilder<'a, 'b, 'c, 'd> {
             scene,
             built_options,
             next_alpha_tile_indices: [AtomicUsize::new(0), AtomicUsize::new(0)],
+            build_time_counters: BuildTimeCounters::default(),
             sink,
         }
     }
@@ -171,6 +227,7 @@ impl<'a, 'b, 'c, 'd> SceneBuilder<'a, 'b, 'c, 'd> {
         };
 
         // Build paint data.
+        let paint_start_time = Instant::now();
         let PaintInfo {
             render_commands,
             paint_metadata,
@@ -178,6 +235,7 @@ impl<'a, 'b, 'c, 'd> SceneBuilder<'a, 'b, 'c, 'd> {
         for render_command in render_commands {
             self.sink.listener.send(render_command);
         }
+        let paint_time = paint_start_time.elapsed();
 
         let built_paths = match prepare_mode {
             PrepareMode::CPU | PrepareMode::TransformCPUBinGPU => {
@@ -211,10 +269,13 @@ impl<'a, 'b, 'c, 'd> SceneBuilder<'a, 'b, 'c, 'd> {
             });
         }
 
+        let batch_start_time = Instant::now();
         self.finish_building(&paint_metadata, built_paths, &prepare_mode);
+        let batch_time = batch_start_time.elapsed();
 
         let cpu_build_time = Instant::now() - start_time;
-        self.sink.listener.send(RenderCommand::Finish { cpu_build_time });
+        let cpu_build_times = self.build_time_counters.to_times(paint_time, batch_time);
+        self.sink.listener.send(RenderCommand::Finish { cpu_build_time, cpu_build_times });
     }
 
     fn build_paths_on_cpu<E>(&mut self,
@@ -227,17 +288,64 @@ impl<'a, 'b, 'c, 'd> SceneBuilder<'a, 'b, 'c, 'd> {
         let draw_path_count = self.scene.draw_paths().len();
         let effective_view_box = self.scene.effective_view_box(self.built_options);
 
+        // Determine whether built paths from the last build can be reused. This is only supported
+        // when preparing entirely on CPU (i.e. the D3D9 level); the GPU levels have their own
+        // scene upload cache.
+        let dirty_draw_paths = match (prepare_mode, self.scene.take_dirty_draw_paths()) {
+            (&PrepareMode::CPU, DirtyDrawPaths::Paths(dirty_draw_paths)) => Some(dirty_draw_paths),
+            _ => None,
+        };
+        let cache_transform = SceneBuildCache::cache_transform(self.built_options);
+        let build_cache = match (&dirty_draw_paths, self.sink.build_cache.take()) {
+            (&Some(_), Some(build_cache)) if build_cache.matches(self.scene.id(),
+                                                                 effective_view_box,
+                                                                 self.built_options) => {
+                Some(build_cache)
+            }
+            _ => None,
+        };
+
+        // Symbol tiles are shared among repeated instances of the same symbol, both within this
+        // build and across builds. Wrap the cache in a mutex for the duration of the build so that
+        // worker threads can consult it.
+        self.sink.symbol_tile_cache.begin_build(self.built_options);
+        let symbol_tile_cache = Mutex::new(mem::replace(&mut self.sink.symbol_tile_cache,
+                                                        SymbolTileCache::new()));
+
         let built_clip_paths = executor.build_vector(clip_path_count, |path_index| {
+            if let Some(ref build_cache) = build_cache {
+                if let Some(cached_clip_path) = build_cache.clip_paths.get(path_index) {
+                    if let Some(rebuilt) = self.rebuild_cached_clip_path(cached_clip_path) {
+                        return rebuilt;
+                    }
+                }
+            }
+
             self.build_clip_path_on_cpu(PathBuildParams {
                 path_id: PathId(path_index as u32),
                 view_box: effective_view_box,
                 prepare_mode: *prepare_mode,
                 built_options: &self.built_options,
                 scene: &self.scene,
-            })
+            }, executor)
         });
+        let (built_clip_paths, clip_fills): (Vec<BuiltPath>, Vec<Vec<Fill>>) =
+            built_clip_paths.into_iter().unzip();
 
         let built_draw_paths = executor.build_vector(draw_path_count, |path_index| {
+            let draw_path_id = DrawPathId(path_index as u32);
+            if let (&Some(ref dirty_draw_paths), &Some(ref build_cache)) =
+                    (&dirty_draw_paths, &build_cache) {
+                if !dirty_draw_paths.contains(&draw_path_id) {
+                    if let Some(cached_draw_path) = build_cache.draw_paths.get(path_index) {
+                        if let Some(built_draw_path) =
+                                self.rebuild_cached_draw_path(cached_draw_path) {
+                            return built_draw_path;
+                        }
+                    }
+                }
+            }
+
             self.build_draw_path_on_cpu(DrawPathBuildParams {
                 path_build_params: PathBuildParams {
                     path_id: PathId(path_index as u32),
@@ -248,16 +356,100 @@ impl<'a, 'b, 'c, 'd> SceneBuilder<'a, 'b, 'c, 'd> {
                 },
                 paint_metadata: &paint_metadata,
                 built_clip_paths: &built_clip_paths,
-            })
+            }, executor, &symbol_tile_cache)
         });
 
-        BuiltPaths { draw: built_draw_paths }
+        self.sink.symbol_tile_cache = symbol_tile_cache.into_inner().unwrap();
+
+        // Retain the built paths for the next build, so that paths that don't change can skip
+        // re-tiling.
+        let mut draw = Vec::with_capacity(draw_path_count);
+        match (prepare_mode, cache_transform) {
+            (&PrepareMode::CPU, Some(transform)) => {
+                let cached_clip_paths = built_clip_paths.iter()
+                                                        .zip(clip_fills)
+                                                        .map(|(built_clip_path, fills)| {
+                    CachedClipPath { path: built_clip_path.clone(), fills }
+                }).collect();
+                let mut cached_draw_paths = Vec::with_capacity(draw_path_count);
+                for (built_draw_path, fills) in built_draw_paths {
+                    cached_draw_paths.push(CachedDrawPath {
+                        path: built_draw_path.clone(),
+                        fills,
+                    });
+                    draw.push(built_draw_path);
+                }
+                self.sink.build_cache = Some(SceneBuildCache {
+                    scene_id: self.scene.id(),
+                    view_box: effective_view_box,
+                    transform,
+                    dilation: self.built_options.dilation,
+                    subpixel_aa_enabled: self.built_options.subpixel_aa_enabled,
+                    dirty_tile_rects: self.built_options.dirty_tile_rects.clone(),
+                    clip_paths: cached_clip_paths,
+                    draw_paths: cached_draw_paths,
+                });
+            }
+            _ => draw.extend(built_draw_paths.into_iter().map(|(built_draw_path, _)| {
+                built_draw_path
+            })),
+        }
+
+        BuiltPaths { draw }
+    }
+
+    // Reuses the built tiles and fills of an unchanged path from the last build. Returns `None`
+    // if the path can't be reused and must be re-tiled.
+    fn rebuild_cached_draw_path(&self, cached_draw_path: &CachedDrawPath)
+                                -> Option<(BuiltDrawPath, Vec<Fill>)> {
+        // Clipped paths reference alpha tiles belonging to their clip paths, which are rebuilt
+        // every frame, so they can't be reused.
+        if cached_draw_path.path.clip_path_id.is_some() {
+            return None;
+        }
+
+        let mut built_draw_path = cached_draw_path.path.clone();
+        let mut fills = cached_draw_path.fills.clone();
+
+        // Alpha tile IDs are allocated afresh on every build, so assign new IDs to the cached
+        // tiles and relink the cached fills to them.
+        let tiles = match built_draw_path.path.data {
+            BuiltPathData::CPU(ref mut cpu_data) => &mut cpu_data.tiles,
+            BuiltPathData::TransformCPUBinGPU(_) | BuiltPathData::GPU => return None,
+        };
+        self.assign_fresh_alpha_tile_ids(tiles, &mut fills);
+
+        self.send_fills(fills.clone());
+        Some((built_draw_path, fills))
     }
 
-    fn build_clip_path_on_cpu(&self, params: PathBuildParams) -> BuiltPath {
+    // Alpha tile IDs are allocated afresh on every build, so cached tiles must be given new IDs
+    // before they can be reused, and the fills that reference them must be relinked.
+    fn assign_fresh_alpha_tile_ids(&self,
+                                   tiles: &mut TileMap<TileObjectPrimitive>,
+                                   fills: &mut [Fill]) {
+        let mut alpha_tile_mapping = FxHashMap::default();
+        tiles.for_each_mut(|tile| {
+            if !tile.alpha_tile_id.is_valid() {
+                return;
+            }
+            let new_alpha_tile_id = AlphaTileId::new(&self.next_alpha_tile_indices, 0);
+            alpha_tile_mapping.insert(tile.alpha_tile_id.0, new_alpha_tile_id.0);
+            tile.alpha_tile_id = new_alpha_tile_id;
+        });
+        for fill in fills {
+            fill.link = alpha_tile_mapping[&fill.link];
+        }
+    }
+
+    fn build_clip_path_on_cpu<E>(&self, params: PathBuildParams, executor: &E)
+                                 -> (BuiltPath, Vec<Fill>)
+                                 where E: Executor {
         let PathBuildParams { path_id, view_box, built_options, scene, prepare_mode } = params;
         let path_object = &scene.get_clip_path(path_id.to_clip_path_id());
+        let dice_start_time = Instant::now();
         let outline = scene.apply_render_options(path_object.outline(), built_options);
+        self.build_time_counters.add_dice_time(dice_start_time.elapsed());
 
         let mut tiler = Tiler::new(self,
                                    path_id,
@@ -269,12 +461,44 @@ impl<'a, 'b, 'c, 'd> SceneBuilder<'a, 'b, 'c, 'd> {
                                    &[],
                                    TilingPathInfo::Clip);
 
-        tiler.generate_tiles();
-        self.send_fills(tiler.object_builder.fills);
-        tiler.object_builder.built_path
+        tiler.generate_tiles(executor);
+        let fills = tiler.object_builder.fills;
+        self.send_fills(fills.clone());
+        (tiler.object_builder.built_path, fills)
+    }
+
+    // Reuses the built tiles and fills of a clip path from the last build. Returns `None` if the
+    // clip can't be reused and must be re-tiled.
+    //
+    // Clip paths can't be mutated once pushed to a scene, so as long as the scene and transform
+    // that key the cache still match, a cached clip is valid; only its alpha tile IDs need
+    // reassignment. Nested clips reference alpha tiles belonging to their parent clips and so
+    // can't be reused, just like clipped draw paths.
+    fn rebuild_cached_clip_path(&self, cached_clip_path: &CachedClipPath)
+                                -> Option<(BuiltPath, Vec<Fill>)> {
+        if cached_clip_path.path.clip_path_id.is_some() {
+            return None;
+        }
+
+        let mut built_path = cached_clip_path.path.clone();
+        let mut fills = cached_clip_path.fills.clone();
+
+        let tiles = match built_path.data {
+            BuiltPathData::CPU(ref mut cpu_data) => &mut cpu_data.tiles,
+            BuiltPathData::TransformCPUBinGPU(_) | BuiltPathData::GPU => return None,
+        };
+        self.assign_fresh_alpha_tile_ids(tiles, &mut fills);
+
+        self.send_fills(fills.clone());
+        Some((built_path, fills))
     }
 
-    fn build_draw_path_on_cpu(&self, params: DrawPathBuildParams) -> BuiltDrawPath {
+    fn build_draw_path_on_cpu<E>(&self,
+                                 params: DrawPathBuildParams,
+                                 executor: &E,
+                                 symbol_tile_cache: &Mutex<SymbolTileCache>)
+                                 -> (BuiltDrawPath, Vec<Fill>)
+                                 where E: Executor {
         let DrawPathBuildParams {
             path_build_params: PathBuildParams {
                 path_id,
@@ -288,29 +512,119 @@ impl<'a, 'b, 'c, 'd> SceneBuilder<'a, 'b, 'c, 'd> {
         } = params;
 
         let path_object = scene.get_draw_path(path_id.to_draw_path_id());
-        let outline = scene.apply_render_options(path_object.outline(), built_options);
+        let dice_start_time = Instant::now();
+
+        // When tiling on CPU, stroked paths are converted to fills here. Stroking happens in path
+        // space, before the render transform, to match the GPU stroking stage.
+        let (outline, fill_rule) = match path_object.stroke_style() {
+            Some(stroke_style) => {
+                let mut stroke_to_fill = OutlineStrokeToFill::new(path_object.outline(),
+                                                                  stroke_style);
+                stroke_to_fill.offset();
+                let stroked_outline = stroke_to_fill.into_outline();
+                (scene.apply_render_options(&stroked_outline, built_options), FillRule::Winding)
+            }
+            None => {
+                (scene.apply_render_options(path_object.outline(), built_options),
+                 path_object.fill_rule())
+            }
+        };
+        self.build_time_counters.add_dice_time(dice_start_time.elapsed());
 
         let paint_id = path_object.paint();
         let paint_metadata = &paint_metadata[paint_id.0 as usize];
 
+        let tiling_path_info = TilingPathInfo::Draw(DrawTilingPathInfo {
+            paint_id,
+            blend_mode: path_object.blend_mode(),
+            fill_rule,
+        });
+
+        // If this path is a symbol instance, its tiles may be shared with other instances of the
+        // same symbol whose positions differ by a whole number of tiles. Instances clipped by a
+        // clip path or by the view box can't participate, since their tiles depend on their
+        // position. Neither can stroked instances, since the symbol key doesn't capture the
+        // stroke style.
+        let symbol_tile_key = match (prepare_mode, path_object.symbol_key()) {
+            (PrepareMode::CPU, Some(symbol_key)) if path_object.clip_path().is_none() &&
+                    path_object.stroke_style().is_none() &&
+                    !path_object.blend_mode().is_destructive() &&
+                    view_box.contains_rect(outline.bounds()) => {
+                Some(SymbolTileCache::classify(symbol_key,
+                                               fill_rule,
+                                               outline.bounds().origin()))
+            }
+            _ => None,
+        };
+
+        if let Some((ref key, base_tile_coords)) = symbol_tile_key {
+            let cached = {
+                let mut cache = symbol_tile_cache.lock().unwrap();
+                cache.get(key).map(|entry| {
+                    (entry.tiles.clone(),
+                     entry.backdrops.clone(),
+                     entry.fills.clone(),
+                     base_tile_coords - entry.base_tile_coords)
+                })
+            };
+            if let Some((mut tiles, backdrops, mut fills, tile_delta)) = cached {
+                // Translate the cached tiles to this instance's position and relink the fills to
+                // freshly-allocated alpha tiles.
+                tiles.translate(tile_delta);
+                tiles.for_each_mut(|tile| {
+                    tile.tile_x += tile_delta.x() as i16;
+                    tile.tile_y += tile_delta.y() as i16;
+                    tile.path_id = path_id;
+                    tile.color = paint_id.0;
+                    tile.ctrl = tiling_path_info.to_ctrl();
+                });
+                self.assign_fresh_alpha_tile_ids(&mut tiles, &mut fills);
+                self.send_fills(fills.clone());
+
+                let built_path = BuiltPath {
+                    tile_bounds: tiles.rect(),
+                    data: BuiltPathData::CPU(BuiltPathBinCPUData {
+                        backdrops,
+                        tiles,
+                        clip_tiles: None,
+                    }),
+                    fill_rule,
+                    clip_path_id: None,
+                    ctrl_byte: tiling_path_info.to_ctrl(),
+                    paint_id,
+                };
+                return (BuiltDrawPath::new(built_path, path_object, paint_metadata), fills);
+            }
+        }
+
         let mut tiler = Tiler::new(self,
                                    path_id,
                                    &outline,
-                                   path_object.fill_rule(),
+                                   fill_rule,
                                    view_box,
                                    &prepare_mode,
                                    path_object.clip_path(),
                                    &built_clip_paths,
-                                   TilingPathInfo::Draw(DrawTilingPathInfo {
-            paint_id,
-            blend_mode: path_object.blend_mode(),
-            fill_rule: path_object.fill_rule(),
-        }));
-
-        tiler.generate_tiles();
-        self.send_fills(tiler.object_builder.fills);
+                                   tiling_path_info);
+
+        tiler.generate_tiles(executor);
+        let fills = tiler.object_builder.fills;
+        self.send_fills(fills.clone());
+
+        // Retain the symbol's tiles so that future instances can skip tiling.
+        if let Some((key, base_tile_coords)) = symbol_tile_key {
+            if let BuiltPathData::CPU(ref cpu_data) = tiler.object_builder.built_path.data {
+                symbol_tile_cache.lock().unwrap().insert(key, SymbolTileEntry {
+                    base_tile_coords,
+                    tiles: cpu_data.tiles.clone(),
+                    backdrops: cpu_data.backdrops.clone(),
+                    fills: fills.clone(),
+                    last_used: 0,
+                });
+            }
+        }
 
-        BuiltDrawPath::new(tiler.object_builder.built_path, path_object, paint_metadata)
+        (BuiltDrawPath::new(tiler.object_builder.built_path, path_object, paint_metadata), fills)
     }
 
     fn send_fills(&self, fills: Vec<Fill>) {
@@ -391,6 +705,187 @@ struct BuiltPaths {
     draw: Vec<BuiltDrawPath>,
 }
 
+/// Built draw paths retained across builds, so that a build can skip re-tiling paths that
+/// haven't been mutated since the previous one.
+///
+/// This lives in the `SceneSink`, alongside the GPU levels' scene upload cache.
+pub(crate) struct SceneBuildCache {
+    scene_id: SceneId,
+    view_box: RectF,
+    transform: Transform2F,
+    dilation: Vector2F,
+    subpixel_aa_enabled: bool,
+    dirty_tile_rects: Option<Vec<RectI>>,
+    clip_paths: Vec<CachedClipPath>,
+    draw_paths: Vec<CachedDrawPath>,
+}
+
+struct CachedDrawPath {
+    path: BuiltDrawPath,
+    fills: Vec<Fill>,
+}
+
+struct CachedClipPath {
+    path: BuiltPath,
+    fills: Vec<Fill>,
+}
+
+impl SceneBuildCache {
+    // Returns the transform that keys the cache, or `None` if the given options don't support
+    // caching (i.e. perspective).
+    fn cache_transform(built_options: &PreparedBuildOptions) -> Option<Transform2F> {
+        match built_options.transform {
+            PreparedRenderTransform::None => Some(Transform2F::default()),
+            PreparedRenderTransform::Transform2D(transform) => Some(transform),
+            PreparedRenderTransform::Perspective { .. } => None,
+        }
+    }
+
+    fn matches(&self,
+               scene_id: SceneId,
+               view_box: RectF,
+               built_options: &PreparedBuildOptions)
+               -> bool {
+        match SceneBuildCache::cache_transform(built_options) {
+            None => false,
+            Some(transform) => {
+                self.scene_id == scene_id &&
+                    self.view_box == view_box &&
+                    self.transform == transform &&
+                    self.dilation == built_options.dilation &&
+                    self.subpixel_aa_enabled == built_options.subpixel_aa_enabled &&
+                    self.dirty_tile_rects == built_options.dirty_tile_rects
+            }
+        }
+    }
+}
+
+/// Built symbol tiles retained across paths and across builds, so that repeated instances of the
+/// same symbol (a glyph, a map marker, and so on) can skip tiling entirely.
+///
+/// Tiles can only be shared between instances whose positions differ by a whole number of tiles,
+/// so the cache key includes the symbol's offset within its tile, quantized to the same 8.8
+/// fixed-point precision that fills are stored at. Entries are evicted in least-recently-used
+/// order.
+///
+/// This lives in the `SceneSink`, alongside the scene build cache.
+pub(crate) struct SymbolTileCache {
+    transform: Transform2F,
+    dilation: Vector2F,
+    subpixel_aa_enabled: bool,
+    entries: FxHashMap<SymbolTileKey, SymbolTileEntry>,
+    clock: u64,
+    enabled: bool,
+}
+
+#[derive(Clone, Copy, PartialEq, Eq, Hash, Debug)]
+struct SymbolTileKey {
+    symbol_key: SymbolRenderKey,
+    // The symbol origin modulo the tile size, in 8.8 fixed point.
+    subtile_offset: (i32, i32),
+    even_odd: bool,
+}
+
+struct SymbolTileEntry {
+    // The tile containing the symbol origin at the time the symbol was built. Reuse translates
+    // the tiles by the whole-tile delta from here to the new instance's origin tile.
+    base_tile_coords: Vector2I,
+    tiles: TileMap<TileObjectPrimitive>,
+    backdrops: Vec<i32>,
+    fills: Vec<Fill>,
+    last_used: u64,
+}
+
+impl SymbolTileCache {
+    pub(crate) fn new() -> SymbolTileCache {
+        SymbolTileCache {
+            transform: Transform2F::default(),
+            dilation: Vector2F::zero(),
+            subpixel_aa_enabled: false,
+            entries: FxHashMap::default(),
+            clock: 0,
+            enabled: false,
+        }
+    }
+
+    // Evicts all entries if the given options are incompatible with those the cache contents were
+    // built with. Symbol tiles can't be shared at all when rendering partially (the cached fills
+    // would have been culled against stale dirty rects) or with a perspective transform.
+    fn begin_build(&mut self, built_options: &PreparedBuildOptions) {
+        let transform = match SceneBuildCache::cache_transform(built_options) {
+            Some(transform) if built_options.dirty_tile_rects.is_none() => transform,
+            _ => {
+                self.entries.clear();
+                self.enabled = false;
+                return;
+            }
+        };
+        if self.transform != transform || self.dilation != built_options.dilation ||
+                self.subpixel_aa_enabled != built_options.subpixel_aa_enabled {
+            self.entries.clear();
+            self.transform = transform;
+            self.dilation = built_options.dilation;
+            self.subpixel_aa_enabled = built_options.subpixel_aa_enabled;
+        }
+        self.enabled = true;
+    }
+
+    // Computes the cache key for a symbol instance with the given origin in scene space, along
+    // with the tile containing that origin.
+    fn classify(symbol_key: SymbolRenderKey, fill_rule: FillRule, origin: Vector2F)
+                -> (SymbolTileKey, Vector2I) {
+        debug_assert_eq!(TILE_WIDTH, TILE_HEIGHT);
+        let tile_size = TILE_WIDTH as i32 * 256;
+
+        // Quantize the origin to the 8.8 fixed-point grid that fills are stored at.
+        let fixed_origin = (origin * 256.0).to_i32();
+        let subtile_offset = (fixed_origin.x().rem_euclid(tile_size),
+                              fixed_origin.y().rem_euclid(tile_size));
+        let base_tile_coords = vec2i((fixed_origin.x() - subtile_offset.0) / tile_size,
+                                     (fixed_origin.y() - subtile_offset.1) / tile_size);
+
+        let key = SymbolTileKey {
+            symbol_key,
+            subtile_offset,
+            even_odd: fill_rule == FillRule::EvenOdd,
+        };
+        (key, base_tile_coords)
+    }
+
+    fn get(&mut self, key: &SymbolTileKey) -> Option<&SymbolTileEntry> {
+        if !self.enabled {
+            return None;
+        }
+        self.clock += 1;
+        let clock = self.clock;
+        match self.entries.get_mut(key) {
+            None => None,
+            Some(entry) => {
+                entry.last_used = clock;
+                Some(&*entry)
+            }
+        }
+    }
+
+    fn insert(&mut self, key: SymbolTileKey, mut entry: SymbolTileEntry) {
+        if !self.enabled {
+            return;
+        }
+        if self.entries.len() >= SYMBOL_TILE_CACHE_SIZE {
+            let lru_key = self.entries
+                              .iter()
+                              .min_by_key(|&(_, entry)| entry.last_used)
+                              .map(|(&key, _)| key);
+            if let Some(lru_key) = lru_key {
+                self.entries.remove(&lru_key);
+            }
+        }
+        self.clock += 1;
+        entry.last_used = self.clock;
+        self.entries.insert(key, entry);
+    }
+}
+
 struct PathBuildParams<'a> {
     path_id: PathId,
     view_box: RectF,
@@ -431,19 +926,28 @@ impl BuiltPath {
 
         let data = match *prepare_mode {
             PrepareMode::CPU => {
+                let tile_template = TileObjectPrimitive {
+                    tile_x: 0,
+                    tile_y: 0,
+                    alpha_tile_id: AlphaTileId(!0),
+                    path_id,
+                    color: paint_id.0,
+                    backdrop: 0,
+                    ctrl: ctrl_byte,
+                };
+                // Paths covering a large tile area get sparse chunked storage, so that a small
+                // path on a huge surface doesn't allocate (and later walk) a mostly-empty dense
+                // array.
+                let tiles = if tile_bounds.area() >= SPARSE_TILE_MAP_MIN_AREA {
+                    TileMap::Sparse(SparseTileMap::new(tile_template, tile_bounds))
+                } else {
+                    TileMap::Dense(DenseTileMap::from_builder(|tile_coord| {
+                        tile_template.at_coords(tile_coord)
+                    }, tile_bounds))
+                };
                 BuiltPathData::CPU(BuiltPathBinCPUData {
                     backdrops: vec![0; tile_bounds.width() as usize],
-                    tiles: DenseTileMap::from_builder(|tile_coord| {
-                            TileObjectPrimitive {
-                                tile_x: tile_coord.x() as i16,
-                                tile_y: tile_coord.y() as i16,
-                                alpha_tile_id: AlphaTileId(!0),
-                                path_id,
-                                color: paint_id.0,
-                                backdrop: 0,
-                                ctrl: ctrl_byte,
-                            }
-                        }, tile_bounds),
+                    tiles,
                     clip_tiles: match *tiling_path_info {
                         TilingPathInfo::Draw(_) if clip_path_id.is_some() => {
                             Some(DenseTileMap::from_builder(|_| {
@@ -511,6 +1015,11 @@ impl ObjectBuilder {
             return;
         }
 
+        // In partial rendering mode, cull fills outside the damage rectangles.
+        if !scene_builder.built_options.tile_is_dirty(tile_coords) {
+            return;
+        }
+
         debug_assert_eq!(TILE_WIDTH, TILE_HEIGHT);
 
         // Compute the upper left corner of the tile.
@@ -521,6 +1030,50 @@ impl ObjectBuilder {
         let segment = (segment.0 - tile_upper_left) * F32x4::splat(256.0);
         let (min, max) = (F32x4::default(), F32x4::splat((TILE_WIDTH * 256 - 1) as f32));
         let segment = segment.clamp(min, max).to_i32x4();
+
+        self.push_packed_fill(scene_builder, segment, tile_coords);
+    }
+
+    /// Adds two fills at once, converting both line segments to fixed point with a single run of
+    /// 8-wide vector operations. This is equivalent to calling `add_fill` twice.
+    pub(crate) fn add_fill_pair(&mut self,
+                                scene_builder: &SceneBuilder,
+                                segment_a: LineSegment2F,
+                                tile_coords_a: Vector2I,
+                                segment_b: LineSegment2F,
+                                tile_coords_b: Vector2I) {
+        // If either fill would be culled, fall back to the one-at-a-time path.
+        if self.tile_coords_to_local_index(tile_coords_a).is_none() ||
+                self.tile_coords_to_local_index(tile_coords_b).is_none() ||
+                !scene_builder.built_options.tile_is_dirty(tile_coords_a) ||
+                !scene_builder.built_options.tile_is_dirty(tile_coords_b) {
+            self.add_fill(scene_builder, segment_a, tile_coords_a);
+            self.add_fill(scene_builder, segment_b, tile_coords_b);
+            return;
+        }
+
+        debug_assert_eq!(TILE_WIDTH, TILE_HEIGHT);
+
+        // Compute the upper left corners of both tiles.
+        let tile_size = F32x8::splat(TILE_WIDTH as f32);
+        let tile_upper_left =
+            F32x8::from_halves(tile_coords_a.to_f32().0.to_f32x4().xyxy(),
+                               tile_coords_b.to_f32().0.to_f32x4().xyxy()) * tile_size;
+
+        // Convert both segments to 8.8 fixed point in one pass.
+        let segments = F32x8::from_halves(segment_a.0, segment_b.0);
+        let segments = (segments - tile_upper_left) * F32x8::splat(256.0);
+        let (min, max) = (F32x8::default(), F32x8::splat((TILE_WIDTH * 256 - 1) as f32));
+        let segments = segments.clamp(min, max).to_i32x8();
+
+        self.push_packed_fill(scene_builder, segments.lo(), tile_coords_a);
+        self.push_packed_fill(scene_builder, segments.hi(), tile_coords_b);
+    }
+
+    fn push_packed_fill(&mut self,
+                        scene_builder: &SceneBuilder,
+                        segment: I32x4,
+                        tile_coords: Vector2I) {
         let (from_x, from_y, to_x, to_y) = (segment[0], segment[1], segment[2], segment[3]);
 
         // Cull degenerate fills.
@@ -550,8 +1103,6 @@ impl ObjectBuilder {
                                         scene_builder: &SceneBuilder,
                                         tile_coords: Vector2I)
                                         -> AlphaTileId {
-        let local_tile_index = self.tile_coords_to_local_index_unchecked(tile_coords) as usize;
-
         let tiles = match self.built_path.data {
             BuiltPathData::CPU(ref mut cpu_data) => &mut cpu_data.tiles,
             BuiltPathData::GPU | BuiltPathData::TransformCPUBinGPU(_) => {
@@ -559,13 +1110,14 @@ impl ObjectBuilder {
             }
         };
 
-        let alpha_tile_id = tiles.data[local_tile_index].alpha_tile_id;
-        if alpha_tile_id.is_valid() {
-            return alpha_tile_id;
+        // The caller has already checked that the coordinates are in bounds.
+        let tile = tiles.get_mut(tile_coords).unwrap();
+        if tile.alpha_tile_id.is_valid() {
+            return tile.alpha_tile_id;
         }
 
         let alpha_tile_id = AlphaTileId::new(&scene_builder.next_alpha_tile_indices, 0);
-        tiles.data[local_tile_index].alpha_tile_id = alpha_tile_id;
+        tile.alpha_tile_id = alpha_tile_id;
         alpha_tile_id
     }
 
@@ -594,9 +1146,10 @@ impl ObjectBuilder {
             BuiltPathData::TransformCPUBinGPU(_) | BuiltPathData::GPU => unreachable!(),
         };
 
-        let tile_offset = tile_coords - tiles.rect.origin();
-        if tile_offset.x() < 0 || tile_offset.x() >= tiles.rect.width() ||
-                tile_offset.y() >= tiles.rect.height() {
+        let tile_rect = tiles.rect();
+        let tile_offset = tile_coords - tile_rect.origin();
+        if tile_offset.x() < 0 || tile_offset.x() >= tile_rect.width() ||
+                tile_offset.y() >= tile_rect.height() {
             return;
         }
 
@@ -605,8 +1158,7 @@ impl ObjectBuilder {
             return;
         }
 
-        let local_tile_index = tiles.coords_to_index_unchecked(tile_coords);
-        tiles.data[local_tile_index].backdrop += delta;
+        tiles.get_mut(tile_coords).unwrap().backdrop += delta;
     }
 }
 
@@ -782,7 +1334,13 @@ impl BuiltSegments {
             built_segments.clip_segment_ranges.push(range);
         }
         for draw_path in scene.draw_paths() {
-            let range = built_segments.draw_segments.add_path(draw_path.outline());
+            let range = match draw_path.stroke_style() {
+                Some(stroke_style) => {
+                    built_segments.draw_segments.add_stroked_path(draw_path.outline(),
+                                                                  stroke_style)
+                }
+                None => built_segments.draw_segments.add_path(draw_path.outline()),
+            };
             built_segments.draw_segment_ranges.push(range);
         }
 
@@ -792,7 +1350,7 @@ impl BuiltSegments {
 
 impl SegmentsD3D11 {
     fn new() -> SegmentsD3D11 {
-        SegmentsD3D11 { points: vec![], indices: vec![] }
+        SegmentsD3D11 { points: vec![], indices: vec![], stroke_segments: vec![] }
     }
 
     fn add_path(&mut self, outline: &Outline) -> Range<u32> {
@@ -832,6 +1390,103 @@ impl SegmentsD3D11 {
         let last_segment_index = self.indices.len() as u32;
         first_segment_index..last_segment_index
     }
+
+    fn add_stroked_path(&mut self, outline: &Outline, stroke_style: StrokeStyle) -> Range<u32> {
+        // Only round joins and caps can be expressed as a union of per-segment capsules. Fall
+        // back to CPU stroking for the other styles.
+        if stroke_style.line_cap != LineCap::Round || stroke_style.line_join != LineJoin::Round {
+            let mut stroke_to_fill = OutlineStrokeToFill::new(outline, stroke_style);
+            stroke_to_fill.offset();
+            return self.add_path(&stroke_to_fill.into_outline());
+        }
+
+        let radius = stroke_style.line_width * 0.5;
+        let first_segment_index = self.indices.len() as u32;
+
+        for contour in outline.contours() {
+            let point_count = contour.len();
+            if point_count == 0 {
+                continue;
+            }
+
+            // Upload the raw centerline points. These are inputs to the stroke stage only; no
+            // segment indices point at them, so the dicer never sees them.
+            let first_input_point_index = self.points.len() as u32;
+            self.points.reserve(point_count as usize + 1);
+            for point_index in 0..point_count {
+                self.points.push(contour.position_of(point_index));
+            }
+            self.points.push(contour.position_of(0));
+
+            let is_on_curve = |point_index: u32| {
+                !contour.flags_of(point_index).intersects(PointFlags::CONTROL_POINT_0 |
+                                                          PointFlags::CONTROL_POINT_1)
+            };
+
+            // The last on-curve point starts the segment that wraps around to the contour's
+            // first point. Open contours have no such segment.
+            let last_on_curve_index = (0..point_count).rev().find(|&i| is_on_curve(i)).unwrap();
+
+            for point_index in 0..point_count {
+                if !is_on_curve(point_index) {
+                    continue;
+                }
+                if point_index == last_on_curve_index && !contour.is_closed() {
+                    continue;
+                }
+
+                let mut flags = 0;
+                if point_index + 1 < point_count &&
+                        contour.flags_of(point_index + 1)
+                               .contains(PointFlags::CONTROL_POINT_0) {
+                    if point_index + 2 < point_count &&
+                            contour.flags_of(point_index + 2)
+                                   .contains(PointFlags::CONTROL_POINT_1) {
+                        flags = CURVE_IS_CUBIC
+                    } else {
+                        flags = CURVE_IS_QUADRATIC
+                    }
+                }
+
+                self.push_stroke_capsule(first_input_point_index + point_index, flags, radius);
+            }
+        }
+
+        let last_segment_index = self.indices.len() as u32;
+        first_segment_index..last_segment_index
+    }
+
+    fn push_stroke_capsule(&mut self, input_point_index: u32, flags: u32, radius: f32) {
+        let output_point_index = self.points.len() as u32;
+        self.stroke_segments.push(StrokeSegmentD3D11 {
+            input_point_index,
+            output_point_index,
+            flags,
+            radius,
+        });
+
+        // The capsule's segment layout: an offset cubic down each side, and two quadratic arcs
+        // around each end cap. The final point is a repeat of the first, closing the contour.
+        let capsule_segments = [
+            (0,  CURVE_IS_CUBIC),
+            (3,  CURVE_IS_QUADRATIC),
+            (5,  CURVE_IS_QUADRATIC),
+            (7,  CURVE_IS_CUBIC),
+            (10, CURVE_IS_QUADRATIC),
+            (12, CURVE_IS_QUADRATIC),
+        ];
+        debug_assert_eq!(capsule_segments.len(), STROKE_CAPSULE_SEGMENT_COUNT);
+        for &(point_offset, segment_flags) in &capsule_segments {
+            self.indices.push(SegmentIndicesD3D11 {
+                first_point_index: output_point_index + point_offset,
+                flags: segment_flags,
+            });
+        }
+
+        // Reserve the output points; the stroke stage fills them in on GPU.
+        let new_point_count = self.points.len() + STROKE_CAPSULE_POINT_COUNT;
+        self.points.resize(new_point_count, Vector2F::zero());
+    }
 }
 
 struct TileBatchBuilder {
@@ -983,23 +1638,28 @@ impl TileBatchBuilder {
                         }
                     };
 
-                    for tile in &cpu_data.tiles.data {
+                    cpu_data.tiles.for_each(|tile| {
                         if tile.alpha_tile_id == AlphaTileId(!0) && tile.backdrop == 0 {
-                            continue;
+                            return;
+                        }
+
+                        let tile_coords = vec2i(tile.tile_x as i32, tile.tile_y as i32);
+
+                        // In partial rendering mode, cull tiles outside the damage rectangles.
+                        if !built_options.tile_is_dirty(tile_coords) {
+                            return;
                         }
 
                         draw_tile_batch.tiles.push(*tile);
 
                         if !draw_path.occludes || tile.alpha_tile_id != AlphaTileId(!0) {
-                            continue;
+                            return;
                         }
-
-                        let tile_coords = vec2i(tile.tile_x as i32, tile.tile_y as i32);
                         let z_value = draw_tile_batch.z_buffer_data
                                                      .get_mut(tile_coords)
                                                      .expect("Z value out of bounds!");
                         *z_value = (*z_value).max(draw_path_id.0 as i32);
-                    }
+                    });
 
                     let clip_tiles = match cpu_data.clip_tiles {
                         None => continue,
@@ -1043,7 +1703,21 @@ impl TileBatchBuilder {
         let effective_view_box = scene.effective_view_box(built_options);
         let draw_path = scene.get_draw_path(draw_path_id);
 
-        let mut path_bounds = transform * draw_path.outline().bounds();
+        let mut outline_bounds = draw_path.outline().bounds();
+        if let Some(stroke_style) = draw_path.stroke_style() {
+            // Stroke expansion happens on GPU, so dilate the bounds conservatively here: miter
+            // joins can extend to the miter limit, and square caps by a factor of sqrt(2).
+            let mut factor: f32 = 1.0;
+            if let LineJoin::Miter(miter_limit) = stroke_style.line_join {
+                factor = factor.max(miter_limit);
+            }
+            if stroke_style.line_cap == LineCap::Square {
+                factor = factor.max(SQRT_2);
+            }
+            outline_bounds = outline_bounds.dilate(stroke_style.line_width * 0.5 * factor);
+        }
+
+        let mut path_bounds = transform * outline_bounds;
         match path_bounds.intersection(effective_view_box) {
             Some(intersection) => path_bounds = intersection,
             None => return None,
@@ -1051,16 +1725,17 @@ impl TileBatchBuilder {
 
         let paint_id = draw_path.paint();
         let paint_metadata = &paint_metadata[paint_id.0 as usize];
+        let fill_rule = draw_path.effective_fill_rule();
         let built_path = BuiltPath::new(draw_path_id.to_path_id(),
                                         path_bounds,
                                         effective_view_box,
-                                        draw_path.fill_rule(),
+                                        fill_rule,
                                         &prepare_mode,
                                         draw_path.clip_path(),
                                         &TilingPathInfo::Draw(DrawTilingPathInfo {
                                             paint_id,
                                             blend_mode: draw_path.blend_mode(),
-                                            fill_rule: draw_path.fill_rule(),
+                                            fill_rule,
                                         }));
         Some(BuiltDrawPath::new(built_path, draw_path, paint_metadata))
     }
@@ -11,7 +11,10 @@
 //! An abstraction over threading and parallelism systems such as Rayon.
 
 /// An abstraction over threading and parallelism systems such as Rayon.
-pub trait Executor {
+///
+/// Executors must be `Sync`, because scene building may invoke them from worker threads in order
+/// to further subdivide large tasks.
+pub trait Executor: Sync {
     /// Like the Rayon snippet:
     ///
     /// ```norun
@@ -24,10 +24,15 @@ use crate::gpu::options::RendererLevel;
 use crate::gpu::renderer::Renderer;
 use crate::gpu_data::RenderCommand;
 use crate::options::{BuildOptions, RenderCommandListener};
-use crate::scene::{Scene, SceneSink};
+use crate::paint::{Paint, PaintId};
+use crate::scene::{DrawPath, DrawPathId, Scene, SceneSink};
 use crossbeam_channel::{self, Receiver, Sender};
+use pathfinder_content::outline::OutlineArena;
 use pathfinder_geometry::rect::RectF;
+use pathfinder_geometry::transform2d::Transform2F;
 use pathfinder_gpu::Device;
+use std::mem;
+use std::sync::{Arc, Mutex};
 use std::thread;
 
 const MAX_MESSAGES_IN_FLIGHT: usize = 1024;
@@ -36,6 +41,9 @@ const MAX_MESSAGES_IN_FLIGHT: usize = 1024;
 pub struct SceneProxy {
     sender: Sender<MainToWorkerMsg>,
     receiver: Receiver<RenderCommand>,
+    pipeline_depth: usize,
+    pending_frames: usize,
+    outline_arena: Arc<Mutex<OutlineArena>>,
 }
 
 impl SceneProxy {
@@ -67,31 +75,139 @@ impl SceneProxy {
             drop(worker_to_main_sender.send(command))
         }));
         let sink = SceneSink::new(listener, renderer_level);
-        thread::spawn(move || scene_thread(scene, executor, sink, main_to_worker_receiver));
-        SceneProxy { sender: main_to_worker_sender, receiver: worker_to_main_receiver }
+        let outline_arena = Arc::new(Mutex::new(OutlineArena::new()));
+        let worker_outline_arena = outline_arena.clone();
+        thread::spawn(move || {
+            scene_thread(scene, executor, sink, worker_outline_arena, main_to_worker_receiver)
+        });
+        SceneProxy {
+            sender: main_to_worker_sender,
+            receiver: worker_to_main_receiver,
+            pipeline_depth: 0,
+            pending_frames: 0,
+            outline_arena,
+        }
     }
 
-    /// Replaces the wrapped scene with a new one, discarding the old scene.
+    /// Sets the number of built frames that may be queued between scene building and rendering.
+    ///
+    /// A depth of 0 (the default) makes `build_and_render()` fully synchronous: each frame is
+    /// built and then immediately rendered. A depth of 1 pipelines frames: `build_and_render()`
+    /// kicks off the build of the current frame on the worker thread and, while that proceeds,
+    /// renders the frame built on the previous call, overlapping CPU tiling with GPU submission
+    /// at the cost of one frame of latency. The bounded command channel provides backpressure:
+    /// the worker thread stalls rather than building arbitrarily far ahead of the renderer.
+    ///
+    /// Depths greater than 1 queue additional frames and are rarely useful.
+    #[inline]
+    pub fn set_pipeline_depth(&mut self, new_pipeline_depth: usize) {
+        self.pipeline_depth = new_pipeline_depth;
+    }
+
+    /// Replaces the wrapped scene with a new one.
+    ///
+    /// The point storage of the old scene's paths is recycled into the proxy's outline arena,
+    /// where `take_outline_arena()` can retrieve it for reuse.
     #[inline]
     pub fn replace_scene(&self, new_scene: Scene) {
         self.sender.send(MainToWorkerMsg::ReplaceScene(new_scene)).unwrap();
     }
 
+    /// Takes the pool of contour storage recycled from replaced scenes, leaving the proxy with
+    /// an empty one.
+    ///
+    /// Feed the returned arena back into whatever builds the next scene (for example via
+    /// `CanvasRenderingContext2D::set_outline_arena()`) to reuse the allocations. Because scene
+    /// replacement happens on the worker thread, call this after `fence()` or `render()` to be
+    /// sure the most recent `replace_scene()` has actually been recycled.
+    #[inline]
+    pub fn take_outline_arena(&self) -> OutlineArena {
+        mem::take(&mut *self.outline_arena.lock().unwrap())
+    }
+
     /// Sets the view box of the scene, which defines the visible rectangle.
     #[inline]
     pub fn set_view_box(&self, new_view_box: RectF) {
         self.sender.send(MainToWorkerMsg::SetViewBox(new_view_box)).unwrap();
     }
 
+    /// Defines a new paint in the wrapped scene and returns its ID.
+    ///
+    /// This blocks until the worker thread has processed all pending messages.
+    #[inline]
+    pub fn push_paint(&self, paint: Paint) -> PaintId {
+        let (sender, receiver) = crossbeam_channel::bounded(MAX_MESSAGES_IN_FLIGHT);
+        self.sender.send(MainToWorkerMsg::PushPaint(paint, sender)).unwrap();
+        receiver.recv().unwrap()
+    }
+
+    /// Adds a path to the wrapped scene, to be drawn on top of all previously-added paths, and
+    /// returns its ID.
+    ///
+    /// This blocks until the worker thread has processed all pending messages.
+    #[inline]
+    pub fn push_draw_path(&self, draw_path: DrawPath) -> DrawPathId {
+        let (sender, receiver) = crossbeam_channel::bounded(MAX_MESSAGES_IN_FLIGHT);
+        self.sender.send(MainToWorkerMsg::PushDrawPath(draw_path, sender)).unwrap();
+        receiver.recv().unwrap()
+    }
+
+    /// Replaces the draw path with the given ID, keeping its ID and drawing order position.
+    ///
+    /// Only the replaced path is marked dirty, so the next build can reuse built tile data for
+    /// all other paths.
+    #[inline]
+    pub fn replace_draw_path(&self, draw_path_id: DrawPathId, new_draw_path: DrawPath) {
+        self.sender
+            .send(MainToWorkerMsg::ReplaceDrawPath(draw_path_id, new_draw_path))
+            .unwrap();
+    }
+
+    /// Applies an affine transform to the draw path with the given ID.
+    #[inline]
+    pub fn transform_draw_path(&self, draw_path_id: DrawPathId, transform: Transform2F) {
+        self.sender
+            .send(MainToWorkerMsg::TransformDrawPath(draw_path_id, transform))
+            .unwrap();
+    }
+
+    /// Changes the paint of the draw path with the given ID.
+    #[inline]
+    pub fn set_draw_path_paint(&self, draw_path_id: DrawPathId, new_paint: PaintId) {
+        self.sender.send(MainToWorkerMsg::SetDrawPathPaint(draw_path_id, new_paint)).unwrap();
+    }
+
+    /// Removes the draw path with the given ID from the wrapped scene.
+    ///
+    /// The IDs of all other paths remain stable.
+    #[inline]
+    pub fn remove_draw_path(&self, draw_path_id: DrawPathId) {
+        self.sender.send(MainToWorkerMsg::RemoveDrawPath(draw_path_id)).unwrap();
+    }
+
     /// Constructs a scene and queues up the commands needed to render it.
     #[inline]
-    pub fn build(&self, options: BuildOptions) {
+    pub fn build(&mut self, options: BuildOptions) {
+        self.pending_frames += 1;
         self.sender.send(MainToWorkerMsg::Build(options)).unwrap();
     }
 
+    /// Blocks until the worker thread has finished building all frames issued so far.
+    ///
+    /// This is an explicit fence between scene building and GPU submission: after it returns,
+    /// every queued `build()` has produced its complete command stream. It can be useful when
+    /// pipelining to bound latency before mutating the scene.
+    #[inline]
+    pub fn fence(&self) {
+        let (sender, receiver) = crossbeam_channel::bounded(MAX_MESSAGES_IN_FLIGHT);
+        self.sender.send(MainToWorkerMsg::Fence(sender)).unwrap();
+        receiver.recv().unwrap()
+    }
+
     /// Sends all queued commands to the given renderer to render the wrapped scene.
     #[inline]
     pub fn render<D>(&mut self, renderer: &mut Renderer<D>) where D: Device {
+        self.pending_frames = self.pending_frames.saturating_sub(1);
         renderer.begin_scene();
         while let Ok(command) = self.receiver.recv() {
             renderer.render_command(&command);
@@ -106,18 +222,24 @@ impl SceneProxy {
     /// A convenience method to build a scene and send the resulting commands
     /// to the given renderer.
     ///
-    /// Exactly equivalent to:
+    /// With the default pipeline depth of 0, this is exactly equivalent to:
     ///
     /// ```norun
     /// scene_proxy.build(build_options);
     /// scene_proxy.render(renderer);
     /// }
     /// ```
+    ///
+    /// With a nonzero pipeline depth (see `set_pipeline_depth()`), this instead renders the
+    /// oldest queued frame, so that the build of the frame just issued overlaps the GPU
+    /// submission of the previous one.
     #[inline]
     pub fn build_and_render<D>(&mut self, renderer: &mut Renderer<D>, build_options: BuildOptions)
                                where D: Device {
         self.build(build_options);
-        self.render(renderer);
+        while self.pending_frames > self.pipeline_depth {
+            self.render(renderer);
+        }
     }
 
     /// Returns a copy of the wrapped scene.
@@ -132,14 +254,35 @@ impl SceneProxy {
 fn scene_thread<E>(mut scene: Scene,
                    executor: E,
                    mut sink: SceneSink<'static>,
+                   outline_arena: Arc<Mutex<OutlineArena>>,
                    main_to_worker_receiver: Receiver<MainToWorkerMsg>)
                    where E: Executor {
     while let Ok(msg) = main_to_worker_receiver.recv() {
         match msg {
-            MainToWorkerMsg::ReplaceScene(new_scene) => scene = new_scene,
+            MainToWorkerMsg::ReplaceScene(new_scene) => {
+                let old_scene = mem::replace(&mut scene, new_scene);
+                old_scene.recycle_storage(&mut *outline_arena.lock().unwrap());
+            }
             MainToWorkerMsg::CopyScene(sender) => sender.send(scene.clone()).unwrap(),
             MainToWorkerMsg::SetViewBox(new_view_box) => scene.set_view_box(new_view_box),
             MainToWorkerMsg::Build(options) => scene.build(options, &mut sink, &executor),
+            MainToWorkerMsg::Fence(sender) => sender.send(()).unwrap(),
+            MainToWorkerMsg::PushPaint(paint, sender) => {
+                sender.send(scene.push_paint(&paint)).unwrap()
+            }
+            MainToWorkerMsg::PushDrawPath(draw_path, sender) => {
+                sender.send(scene.push_draw_path(draw_path)).unwrap()
+            }
+            MainToWorkerMsg::ReplaceDrawPath(draw_path_id, new_draw_path) => {
+                scene.replace_draw_path(draw_path_id, new_draw_path)
+            }
+            MainToWorkerMsg::TransformDrawPath(draw_path_id, transform) => {
+                scene.transform_draw_path(draw_path_id, &transform)
+            }
+            MainToWorkerMsg::SetDrawPathPaint(draw_path_id, new_paint) => {
+                scene.set_draw_path_paint(draw_path_id, new_paint)
+            }
+            MainToWorkerMsg::RemoveDrawPath(draw_path_id) => scene.remove_draw_path(draw_path_id),
         }
     }
 }
@@ -149,4 +292,11 @@ enum MainToWorkerMsg {
     CopyScene(Sender<Scene>),
     SetViewBox(RectF),
     Build(BuildOptions),
+    Fence(Sender<()>),
+    PushPaint(Paint, Sender<PaintId>),
+    PushDrawPath(DrawPath, Sender<DrawPathId>),
+    ReplaceDrawPath(DrawPathId, DrawPath),
+    TransformDrawPath(DrawPathId, Transform2F),
+    SetDrawPathPaint(DrawPathId, PaintId),
+    RemoveDrawPath(DrawPathId),
 }
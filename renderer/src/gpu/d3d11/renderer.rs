@@ -14,11 +14,13 @@
 
 use crate::gpu::d3d11::shaders::{BOUND_WORKGROUP_SIZE, DICE_WORKGROUP_SIZE};
 use crate::gpu::d3d11::shaders::{PROPAGATE_WORKGROUP_SIZE, ProgramsD3D11, SORT_WORKGROUP_SIZE};
+use crate::gpu::d3d11::shaders::STROKE_WORKGROUP_SIZE;
 use crate::gpu::perf::TimeCategory;
 use crate::gpu::renderer::{FramebufferFlags, RendererCore};
 use crate::gpu_data::{AlphaTileD3D11, BackdropInfoD3D11, DiceMetadataD3D11, DrawTileBatchD3D11};
 use crate::gpu_data::{Fill, FirstTileD3D11, MicrolineD3D11, PathSource, PropagateMetadataD3D11};
-use crate::gpu_data::{SegmentIndicesD3D11, SegmentsD3D11, TileD3D11, TileBatchDataD3D11};
+use crate::gpu_data::{SegmentIndicesD3D11, SegmentsD3D11, StrokeSegmentD3D11, TileD3D11};
+use crate::gpu_data::TileBatchDataD3D11;
 use crate::gpu_data::{TileBatchTexture, TilePathInfoD3D11};
 use byte_slice_cast::AsSliceOf;
 use pathfinder_geometry::transform2d::Transform2F;
@@ -238,6 +240,60 @@ impl<D> RendererD3D11<D> where D: Device {
                                draw_segments: &SegmentsD3D11,
                                clip_segments: &SegmentsD3D11) {
         self.scene_buffers.upload(&mut core.allocator, &core.device, draw_segments, clip_segments);
+
+        // Expand stroke centerlines into stroke-boundary geometry. This happens once per scene
+        // upload, not per frame: the expanded points live in the points buffer in path space, so
+        // the dicer can transform them every frame like any other segment.
+        if !draw_segments.stroke_segments.is_empty() {
+            self.stroke_segments(core, &draw_segments.stroke_segments);
+        }
+    }
+
+    fn stroke_segments(&mut self,
+                       core: &mut RendererCore<D>,
+                       stroke_segments: &[StrokeSegmentD3D11]) {
+        let stroke_program = &self.programs.stroke_program;
+
+        let stroke_segments_buffer_id =
+            core.allocator.allocate_general_buffer::<StrokeSegmentD3D11>(
+                &core.device,
+                stroke_segments.len() as u64,
+                BufferTag("StrokeSegmentD3D11"));
+        let stroke_segments_buffer = core.allocator.get_general_buffer(stroke_segments_buffer_id);
+        core.device.upload_to_buffer(stroke_segments_buffer,
+                                     0,
+                                     stroke_segments,
+                                     BufferTarget::Storage);
+
+        let points_buffer = core.allocator.get_general_buffer(
+            self.scene_buffers.draw.points_buffer.expect("Where's the points buffer?"));
+
+        let timer_query = core.timer_query_cache.start_timing_draw_call(&core.device,
+                                                                        &core.options);
+
+        let workgroup_count = (stroke_segments.len() as u32 + STROKE_WORKGROUP_SIZE - 1) /
+            STROKE_WORKGROUP_SIZE;
+        let compute_dimensions = ComputeDimensions { x: workgroup_count, y: 1, z: 1 };
+
+        core.device.dispatch_compute(compute_dimensions, &ComputeState {
+            program: &stroke_program.program,
+            textures: &[],
+            uniforms: &[
+                (&stroke_program.stroke_segment_count_uniform,
+                 UniformData::Int(stroke_segments.len() as i32)),
+            ],
+            images: &[],
+            storage_buffers: &[
+                (&stroke_program.stroke_segments_storage_buffer, stroke_segments_buffer),
+                (&stroke_program.points_storage_buffer, points_buffer),
+            ],
+        });
+
+        core.stats.drawcall_count += 1;
+        core.finish_timing_draw_call(&timer_query);
+        core.current_timer.as_mut().unwrap().push_query(TimeCategory::Dice, timer_query);
+
+        core.allocator.free_general_buffer(stroke_segments_buffer_id);
     }
 
     fn allocate_tiles(&mut self, core: &mut RendererCore<D>, tile_count: u32) -> GeneralBufferID {
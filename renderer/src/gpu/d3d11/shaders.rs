@@ -16,12 +16,14 @@ use pathfinder_gpu::{ComputeDimensions, Device};
 use pathfinder_resources::ResourceLoader;
 
 pub(crate) const BOUND_WORKGROUP_SIZE: u32 = 64;
+pub(crate) const STROKE_WORKGROUP_SIZE: u32 = 64;
 pub(crate) const DICE_WORKGROUP_SIZE: u32 = 64;
 pub(crate) const BIN_WORKGROUP_SIZE: u32 = 64;
 pub(crate) const PROPAGATE_WORKGROUP_SIZE: u32 = 64;
 pub(crate) const SORT_WORKGROUP_SIZE: u32 = 64;
 
 pub(crate) struct ProgramsD3D11<D> where D: Device {
+    pub(crate) stroke_program: StrokeProgramD3D11<D>,
     pub(crate) bound_program: BoundProgramD3D11<D>,
     pub(crate) dice_program: DiceProgramD3D11<D>,
     pub(crate) bin_program: BinProgramD3D11<D>,
@@ -34,6 +36,7 @@ pub(crate) struct ProgramsD3D11<D> where D: Device {
 impl<D> ProgramsD3D11<D> where D: Device {
     pub(crate) fn new(device: &D, resources: &dyn ResourceLoader) -> ProgramsD3D11<D> {
         ProgramsD3D11 {
+            stroke_program: StrokeProgramD3D11::new(device, resources),
             bound_program: BoundProgramD3D11::new(device, resources),
             dice_program: DiceProgramD3D11::new(device, resources),
             bin_program: BinProgramD3D11::new(device, resources),
@@ -45,6 +48,33 @@ impl<D> ProgramsD3D11<D> where D: Device {
     }
 }
 
+pub(crate) struct StrokeProgramD3D11<D> where D: Device {
+    pub(crate) program: D::Program,
+    pub(crate) stroke_segment_count_uniform: D::Uniform,
+    pub(crate) stroke_segments_storage_buffer: D::StorageBuffer,
+    pub(crate) points_storage_buffer: D::StorageBuffer,
+}
+
+impl<D> StrokeProgramD3D11<D> where D: Device {
+    pub(crate) fn new(device: &D, resources: &dyn ResourceLoader) -> StrokeProgramD3D11<D> {
+        let mut program = device.create_compute_program(resources, "d3d11/stroke");
+        let local_size = ComputeDimensions { x: STROKE_WORKGROUP_SIZE, y: 1, z: 1 };
+        device.set_compute_program_local_size(&mut program, local_size);
+
+        let stroke_segment_count_uniform = device.get_uniform(&program, "StrokeSegmentCount");
+        let stroke_segments_storage_buffer =
+            device.get_storage_buffer(&program, "StrokeSegments", 0);
+        let points_storage_buffer = device.get_storage_buffer(&program, "Points", 1);
+
+        StrokeProgramD3D11 {
+            program,
+            stroke_segment_count_uniform,
+            stroke_segments_storage_buffer,
+            points_storage_buffer,
+        }
+    }
+}
+
 pub(crate) struct PropagateProgramD3D11<D> where D: Device {
     pub(crate) program: D::Program,
     pub(crate) framebuffer_tile_size_uniform: D::Uniform,
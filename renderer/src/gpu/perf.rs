@@ -11,7 +11,9 @@
 //! Performance monitoring infrastructure.
 
 use crate::gpu::options::RendererOptions;
+use instant::Instant;
 use pathfinder_gpu::Device;
+use std::io::{self, Write};
 use std::mem;
 use std::ops::{Add, Div};
 use std::time::Duration;
@@ -32,6 +34,8 @@ pub struct RenderStats {
     pub total_tile_count: usize,
     /// The amount of CPU time it took to build the scene.
     pub cpu_build_time: Duration,
+    /// The CPU time it took to build the scene, broken up into stages.
+    pub cpu_build_times: CPUBuildTimes,
     /// The number of GPU API draw calls it took to render the scene.
     pub drawcall_count: u32,
     /// The number of bytes of VRAM Pathfinder has allocated.
@@ -52,6 +56,7 @@ impl Add<RenderStats> for RenderStats {
             total_tile_count: self.total_tile_count + other.total_tile_count,
             fill_count: self.fill_count + other.fill_count,
             cpu_build_time: self.cpu_build_time + other.cpu_build_time,
+            cpu_build_times: self.cpu_build_times + other.cpu_build_times,
             drawcall_count: self.drawcall_count + other.drawcall_count,
             gpu_bytes_allocated: self.gpu_bytes_allocated + other.gpu_bytes_allocated,
             gpu_bytes_committed: self.gpu_bytes_committed + other.gpu_bytes_committed,
@@ -68,6 +73,7 @@ impl Div<usize> for RenderStats {
             total_tile_count: self.total_tile_count / divisor,
             fill_count: self.fill_count / divisor,
             cpu_build_time: self.cpu_build_time / divisor as u32,
+            cpu_build_times: self.cpu_build_times / divisor,
             drawcall_count: self.drawcall_count / divisor as u32,
             gpu_bytes_allocated: self.gpu_bytes_allocated / divisor as u64,
             gpu_bytes_committed: self.gpu_bytes_committed / divisor as u64,
@@ -289,3 +295,131 @@ impl Div<usize> for RenderTime {
         }
     }
 }
+
+/// The amount of CPU time it took to build the scene, broken up into stages.
+///
+/// The tiling stages run in parallel across paths, so their times are summed over all worker
+/// threads and can exceed the wall-clock build time on multicore machines.
+#[derive(Clone, Copy, Debug, Default)]
+pub struct CPUBuildTimes {
+    /// How much CPU time was spent transforming, dashing, stroking, and flattening outlines.
+    pub dice_time: Duration,
+    /// How much CPU time was spent walking the tile lattice to generate fills.
+    ///
+    /// This will be zero in the D3D11-level backend, since in that backend fill generation is
+    /// done on GPU.
+    pub fill_time: Duration,
+    /// How much CPU time was spent propagating backdrops and applying clips to tiles.
+    ///
+    /// This will be zero in the D3D11-level backend, since in that backend tile preparation is
+    /// done on GPU.
+    pub tile_prepare_time: Duration,
+    /// How much CPU time was spent assembling the paint texture pages and metadata.
+    pub paint_time: Duration,
+    /// How much CPU time was spent grouping the built tiles into draw batches.
+    pub batch_time: Duration,
+}
+
+impl Add<CPUBuildTimes> for CPUBuildTimes {
+    type Output = CPUBuildTimes;
+
+    #[inline]
+    fn add(self, other: CPUBuildTimes) -> CPUBuildTimes {
+        CPUBuildTimes {
+            dice_time: self.dice_time + other.dice_time,
+            fill_time: self.fill_time + other.fill_time,
+            tile_prepare_time: self.tile_prepare_time + other.tile_prepare_time,
+            paint_time: self.paint_time + other.paint_time,
+            batch_time: self.batch_time + other.batch_time,
+        }
+    }
+}
+
+impl Div<usize> for CPUBuildTimes {
+    type Output = CPUBuildTimes;
+
+    #[inline]
+    fn div(self, divisor: usize) -> CPUBuildTimes {
+        let divisor = divisor as u32;
+        CPUBuildTimes {
+            dice_time: self.dice_time / divisor,
+            fill_time: self.fill_time / divisor,
+            tile_prepare_time: self.tile_prepare_time / divisor,
+            paint_time: self.paint_time / divisor,
+            batch_time: self.batch_time / divisor,
+        }
+    }
+}
+
+/// Records per-frame CPU timing breakdowns and writes them out in the JSON trace event format
+/// that `chrome://tracing` and Perfetto understand.
+///
+/// The builder only reports stage durations, not start timestamps, so each frame's stage spans
+/// are laid out back to back ending at the time the frame's stats arrived. The result shows
+/// relative stage costs frame by frame rather than exact scheduling.
+pub struct ChromeTraceDump {
+    events: Vec<ChromeTraceEvent>,
+    epoch: Instant,
+}
+
+struct ChromeTraceEvent {
+    name: &'static str,
+    start: Duration,
+    duration: Duration,
+}
+
+impl ChromeTraceDump {
+    /// Creates a new, empty trace.
+    #[inline]
+    pub fn new() -> ChromeTraceDump {
+        ChromeTraceDump { events: vec![], epoch: Instant::now() }
+    }
+
+    /// Appends one frame's worth of spans, derived from the given statistics.
+    pub fn add_frame(&mut self, stats: &RenderStats) {
+        let frame_end = self.epoch.elapsed();
+        let frame_start = frame_end.checked_sub(stats.cpu_build_time).unwrap_or_default();
+        self.events.push(ChromeTraceEvent {
+            name: "build",
+            start: frame_start,
+            duration: stats.cpu_build_time,
+        });
+
+        let times = &stats.cpu_build_times;
+        let stages = [
+            ("paint", times.paint_time),
+            ("dice", times.dice_time),
+            ("fill", times.fill_time),
+            ("prepare_tiles", times.tile_prepare_time),
+            ("batch", times.batch_time),
+        ];
+        let mut stage_start = frame_start;
+        for &(name, duration) in &stages {
+            self.events.push(ChromeTraceEvent { name, start: stage_start, duration });
+            stage_start += duration;
+        }
+    }
+
+    /// Writes the trace as a JSON array of trace events, suitable for loading into
+    /// `chrome://tracing` or Perfetto.
+    pub fn write<W>(&self, mut writer: W) -> io::Result<()> where W: Write {
+        writeln!(writer, "[")?;
+        for (index, event) in self.events.iter().enumerate() {
+            let separator = if index + 1 == self.events.len() { "" } else { "," };
+            writeln!(writer,
+                     "{{\"name\":\"{}\",\"cat\":\"pathfinder\",\"ph\":\"X\",\"ts\":{:.3},\
+                      \"dur\":{:.3},\"pid\":1,\"tid\":1}}{}",
+                     event.name,
+                     event.start.as_secs_f64() * 1_000_000.0,
+                     event.duration.as_secs_f64() * 1_000_000.0,
+                     separator)?;
+        }
+        writeln!(writer, "]")
+    }
+
+    /// Returns true if no frames have been recorded yet.
+    #[inline]
+    pub fn is_empty(&self) -> bool {
+        self.events.is_empty()
+    }
+}
@@ -15,7 +15,8 @@ use crate::gpu::d3d9::renderer::RendererD3D9;
 use crate::gpu::d3d11::renderer::RendererD3D11;
 use crate::gpu::debug::DebugUIPresenter;
 use crate::gpu::options::{DestFramebuffer, RendererLevel, RendererMode, RendererOptions};
-use crate::gpu::perf::{PendingTimer, RenderStats, RenderTime, TimeCategory, TimerQueryCache};
+use crate::gpu::perf::{ChromeTraceDump, PendingTimer, RenderStats, RenderTime, TimeCategory};
+use crate::gpu::perf::TimerQueryCache;
 use crate::gpu::shaders::{BlitProgram, BlitVertexArray, ClearProgram, ClearVertexArray};
 use crate::gpu::shaders::{ProgramsCore, ReprojectionProgram, ReprojectionVertexArray};
 use crate::gpu::shaders::{StencilProgram, StencilVertexArray, TileProgramCommon, VertexArraysCore};
@@ -26,6 +27,7 @@ use crate::tiles::{TILE_HEIGHT, TILE_WIDTH};
 use half::f16;
 use pathfinder_color::{self as color, ColorF, ColorU};
 use pathfinder_content::effects::{BlendMode, BlurDirection, Filter, PatternFilter};
+use pathfinder_content::pattern::ExternalTextureId;
 use pathfinder_content::render_target::RenderTargetId;
 use pathfinder_geometry::rect::{RectF, RectI};
 use pathfinder_geometry::transform3d::Transform4F;
@@ -35,11 +37,13 @@ use pathfinder_gpu::allocator::{BufferTag, FramebufferID, FramebufferTag, Genera
 use pathfinder_gpu::allocator::{GPUMemoryAllocator, IndexBufferID, TextureID, TextureTag};
 use pathfinder_gpu::{BufferData, BufferTarget, ClearOps, DepthFunc, DepthState, Device, Primitive};
 use pathfinder_gpu::{RenderOptions, RenderState, RenderTarget, StencilFunc, StencilState};
-use pathfinder_gpu::{TextureBinding, TextureDataRef, TextureFormat, UniformBinding, UniformData};
+use pathfinder_gpu::{TextureBinding, TextureData, TextureDataRef, TextureFormat, UniformBinding};
+use pathfinder_gpu::UniformData;
 use pathfinder_resources::ResourceLoader;
 use pathfinder_simd::default::{F32x2, F32x4, I32x2};
-use std::collections::VecDeque;
+use std::collections::{HashMap, VecDeque};
 use std::f32;
+use std::mem;
 use std::time::Duration;
 use std::u32;
 
@@ -90,6 +94,23 @@ pub struct Renderer<D> where D: Device {
     debug_ui_presenter: Option<DebugUIPresenter<D>>,
     last_stats: VecDeque<RenderStats>,
     last_rendering_time: Option<RenderTime>,
+    chrome_trace_dump: Option<ChromeTraceDump>,
+
+    // Temporal reuse
+    temporal_frame_cache: Option<TemporalFrameCache>,
+    pending_temporal_transform: Option<Transform4F>,
+}
+
+// The last frame's composited output, retained for temporal reuse.
+//
+// At the end of each frame this framebuffer is swapped with the intermediate destination
+// framebuffer rather than copied, so retaining a frame costs nothing beyond the memory.
+struct TemporalFrameCache {
+    framebuffer_id: FramebufferID,
+    framebuffer_size: Vector2I,
+    // The transform the retained frame was composited with, or `None` if the retained contents
+    // are invalid (e.g. just allocated or stale after a resize).
+    transform: Option<Transform4F>,
 }
 
 enum RendererLevelImpl<D> where D: Device {
@@ -129,6 +150,8 @@ pub(crate) struct RendererCore<D> where D: Device {
     render_targets: Vec<RenderTargetInfo>,
     pub(crate) render_target_stack: Vec<RenderTargetId>,
     pub(crate) pattern_texture_pages: Vec<Option<PatternTexturePage>>,
+    external_textures: HashMap<ExternalTextureId, D::Texture>,
+    external_texture_pages: HashMap<TexturePageId, ExternalTextureId>,
     pub(crate) mask_storage: Option<MaskStorage>,
     pub(crate) alpha_tile_count: u32,
     pub(crate) framebuffer_flags: FramebufferFlags,
@@ -255,6 +278,8 @@ impl<D> Renderer<D> where D: Device {
             render_targets: vec![],
             render_target_stack: vec![],
             pattern_texture_pages: vec![],
+            external_textures: HashMap::new(),
+            external_texture_pages: HashMap::new(),
             mask_storage: None,
             alpha_tile_count: 0,
             framebuffer_flags: FramebufferFlags::empty(),
@@ -308,6 +333,10 @@ impl<D> Renderer<D> where D: Device {
             debug_ui_presenter,
             last_stats: VecDeque::new(),
             last_rendering_time: None,
+            chrome_trace_dump: None,
+
+            temporal_frame_cache: None,
+            pending_temporal_transform: None,
         }
     }
 
@@ -349,6 +378,9 @@ impl<D> Renderer<D> where D: Device {
             RenderCommand::DeclareRenderTarget { id, location } => {
                 self.declare_render_target(id, location)
             }
+            RenderCommand::DeclareExternalTexture { id, location } => {
+                self.declare_external_texture(id, location)
+            }
             RenderCommand::UploadTextureMetadata(ref metadata) => {
                 self.upload_texture_metadata(metadata)
             }
@@ -376,8 +408,9 @@ impl<D> Renderer<D> where D: Device {
             RenderCommand::DrawTilesD3D11(ref batch) => {
                 self.level_impl.require_d3d11().prepare_and_draw_tiles(&mut self.core, batch)
             }
-            RenderCommand::Finish { cpu_build_time } => {
+            RenderCommand::Finish { cpu_build_time, cpu_build_times } => {
                 self.core.stats.cpu_build_time = cpu_build_time;
+                self.core.stats.cpu_build_times = cpu_build_times;
             }
         }
     }
@@ -392,6 +425,7 @@ impl<D> Renderer<D> where D: Device {
     pub fn end_scene(&mut self) {
         self.clear_dest_framebuffer_if_necessary();
         self.blit_intermediate_dest_framebuffer_if_necessary();
+        self.retain_temporal_frame_if_necessary();
 
         self.core.stats.gpu_bytes_allocated = self.core.allocator.bytes_allocated();
         self.core.stats.gpu_bytes_committed = self.core.allocator.bytes_committed();
@@ -408,6 +442,10 @@ impl<D> Renderer<D> where D: Device {
         }
         self.current_cpu_build_time = None;
 
+        if let Some(ref mut chrome_trace_dump) = self.chrome_trace_dump {
+            chrome_trace_dump.add_frame(&self.core.stats);
+        }
+
         self.update_debug_ui();
         if self.core.options.show_debug_ui {
             self.draw_debug_ui();
@@ -441,10 +479,22 @@ impl<D> Renderer<D> where D: Device {
             }
         }
 
+        // Temporal reuse needs the composited frame to end up in a texture, so route drawing
+        // through the intermediate destination framebuffer when it's active.
+        if self.temporal_frame_cache.is_some() {
+            if let DestFramebuffer::Default { .. } = self.core.options.dest {
+                self.core
+                    .renderer_flags
+                    .insert(RendererFlags::INTERMEDIATE_DEST_FRAMEBUFFER_NEEDED);
+            }
+        }
+
         if self.core.renderer_flags.contains(RendererFlags::USE_DEPTH) {
             self.draw_stencil(&bounding_quad);
         }
 
+        self.reproject_retained_frame_if_possible();
+
         self.core.stats.path_count = path_count;
 
         self.core.render_targets.clear();
@@ -493,6 +543,27 @@ impl<D> Renderer<D> where D: Device {
         self.last_rendering_time
     }
 
+    /// Starts recording per-frame CPU timing breakdowns in Chrome trace format.
+    ///
+    /// One frame's worth of spans is appended at the end of every scene until
+    /// `end_chrome_trace()` is called. Recording has negligible overhead, so it's safe to leave
+    /// enabled in production.
+    #[inline]
+    pub fn begin_chrome_trace(&mut self) {
+        if self.chrome_trace_dump.is_none() {
+            self.chrome_trace_dump = Some(ChromeTraceDump::new());
+        }
+    }
+
+    /// Stops recording and returns the trace recorded since `begin_chrome_trace()`, if any.
+    ///
+    /// Write the trace out with `ChromeTraceDump::write()` and load the resulting file into
+    /// `chrome://tracing` or Perfetto.
+    #[inline]
+    pub fn end_chrome_trace(&mut self) -> Option<ChromeTraceDump> {
+        self.chrome_trace_dump.take()
+    }
+
     /// Returns a reference to the GPU device.
     /// 
     /// This can be useful to issue GPU commands manually via the low-level `pathfinder_gpu`
@@ -597,9 +668,86 @@ impl<D> Renderer<D> where D: Device {
         self.core.allocator.get_index_buffer(self.core.quad_vertex_indices_buffer_id)
     }
 
+    /// Registers a texture owned by the embedder, so that patterns created with
+    /// `Pattern::from_external_texture()` and the same ID can reference it.
+    ///
+    /// The tile compositing pass samples the texture directly; its contents are never copied.
+    /// This makes external textures a zero-copy way to composite content, such as video frames,
+    /// that another system decodes straight into GPU memory. The embedder may freely update the
+    /// texture contents between scenes.
+    ///
+    /// Returns the texture previously registered under this ID, if any.
+    pub fn register_external_texture(&mut self, id: ExternalTextureId, texture: D::Texture)
+                                     -> Option<D::Texture> {
+        self.core.external_textures.insert(id, texture)
+    }
+
+    /// Unregisters the external texture with the given ID and returns it to the embedder.
+    ///
+    /// Returns `None` if no texture was registered under this ID. Scenes rendered afterward must
+    /// not contain patterns referencing the ID.
+    pub fn unregister_external_texture(&mut self, id: ExternalTextureId) -> Option<D::Texture> {
+        self.core.external_textures.remove(&id)
+    }
+
+    /// Begins an asynchronous readback of the contents of the given render target.
+    ///
+    /// The copy into a CPU-visible buffer is enqueued and fenced immediately, but this function
+    /// doesn't wait for the GPU to finish it, so subsequent frames can be built and rendered
+    /// while the copy completes. Poll the returned handle with `try_recv_pixels()`, or block on
+    /// it with `recv_pixels()`.
+    ///
+    /// The render target must belong to the most recently rendered scene. Call this after
+    /// `render_command()` has processed the frame's `Finish` command; reading back mid-frame
+    /// would capture partially-drawn contents.
+    pub fn read_render_target_pixels_async(&mut self, render_target_id: RenderTargetId)
+                                           -> PixelReadback<D> {
+        let location = self.core.render_target_location(render_target_id);
+        let framebuffer = self.core.texture_page_framebuffer(location.page);
+        let receiver = self.core
+                           .device
+                           .read_pixels(&RenderTarget::Framebuffer(framebuffer), location.rect);
+        PixelReadback { receiver, viewport: location.rect }
+    }
+
+    /// Begins an asynchronous readback of the given viewport of the destination framebuffer.
+    ///
+    /// This works like `read_render_target_pixels_async()`, but captures the final composited
+    /// output instead of an intermediate render target.
+    pub fn read_dest_pixels_async(&mut self, viewport: RectI) -> PixelReadback<D> {
+        let receiver = match self.core.options.dest {
+            DestFramebuffer::Default { .. } => {
+                self.core.device.read_pixels(&RenderTarget::Default, viewport)
+            }
+            DestFramebuffer::Other(ref framebuffer) => {
+                self.core.device.read_pixels(&RenderTarget::Framebuffer(framebuffer), viewport)
+            }
+        };
+        PixelReadback { receiver, viewport }
+    }
+
+    /// Returns the pixels of a completed readback, or `None` if the GPU hasn't finished the
+    /// copy yet.
+    ///
+    /// Polling doesn't stall the pipeline, so a service that snapshots frames can check once
+    /// per frame and keep rendering until the data arrives.
+    #[inline]
+    pub fn try_recv_pixels(&self, readback: &PixelReadback<D>) -> Option<TextureData> {
+        self.core.device.try_recv_texture_data(&readback.receiver)
+    }
+
+    /// Blocks until the readback completes and returns its pixels.
+    #[inline]
+    pub fn recv_pixels(&self, readback: &PixelReadback<D>) -> TextureData {
+        self.core.device.recv_texture_data(&readback.receiver)
+    }
+
     fn allocate_pattern_texture_page(&mut self,
                                      page_id: TexturePageId,
                                      descriptor: &TexturePageDescriptor) {
+        // The page is now backed by a texture of its own.
+        self.core.external_texture_pages.remove(&page_id);
+
         // Fill in IDs up to the requested page ID.
         let page_index = page_id.0 as usize;
         while self.core.pattern_texture_pages.len() < page_index + 1 {
@@ -652,6 +800,14 @@ impl<D> Renderer<D> where D: Device {
         render_target.location = location;
     }
 
+    fn declare_external_texture(&mut self,
+                                external_texture_id: ExternalTextureId,
+                                location: TextureLocation) {
+        debug_assert!(self.core.external_textures.contains_key(&external_texture_id),
+                      "External texture not registered!");
+        self.core.external_texture_pages.insert(location.page, external_texture_id);
+    }
+
     fn upload_texture_metadata(&mut self, metadata: &[TextureMetadataEntry]) {
         let padded_texel_size =
             (util::alignup_i32(metadata.len() as i32, TEXTURE_METADATA_ENTRIES_PER_ROW) *
@@ -808,6 +964,156 @@ impl<D> Renderer<D> where D: Device {
         self.core.preserve_draw_framebuffer();
     }
 
+    /// Enables or disables temporal frame reuse.
+    ///
+    /// When enabled, the renderer retains each frame's composited output along with the transform
+    /// it was rendered with (see `begin_temporal_frame()`). At the start of the next frame, the
+    /// retained frame is reprojected under the new transform before any tiles are drawn, so the
+    /// scene only needs to rasterize what actually changed. Callers pair this with
+    /// `BuildOptions::dirty_rects` covering the mutated paths and any disoccluded regions;
+    /// pan/zoom workloads that repaint mostly-identical pixels every frame can skip the fill and
+    /// composite work for everything else.
+    ///
+    /// Temporal reuse is only supported when rendering to `DestFramebuffer::Default`; it routes
+    /// drawing through the intermediate destination framebuffer so the composited frame is
+    /// available as a texture.
+    pub fn set_temporal_reuse_enabled(&mut self, enabled: bool) {
+        if !enabled {
+            if let Some(cache) = self.temporal_frame_cache.take() {
+                self.core.allocator.free_framebuffer(cache.framebuffer_id);
+            }
+            return;
+        }
+        if self.temporal_frame_cache.is_some() {
+            return;
+        }
+
+        let size = self.core.main_viewport().size();
+        let framebuffer_id =
+            self.core.allocator.allocate_framebuffer(&self.core.device,
+                                                     size,
+                                                     TextureFormat::RGBA8,
+                                                     FramebufferTag("TemporalRetainedFrame"));
+        self.temporal_frame_cache = Some(TemporalFrameCache {
+            framebuffer_id,
+            framebuffer_size: size,
+            transform: None,
+        });
+    }
+
+    /// Returns the transform the retained frame was composited with, if a frame is available for
+    /// temporal reuse.
+    ///
+    /// `None` means the coming frame must be rendered in full: temporal reuse is disabled, no
+    /// frame has been retained yet, or the viewport has been resized since the last frame.
+    /// Callers consult this before building the scene to decide between full and partial dirty
+    /// rects.
+    pub fn retained_frame_transform(&self) -> Option<Transform4F> {
+        let cache = self.temporal_frame_cache.as_ref()?;
+        if cache.framebuffer_size != self.core.main_viewport().size() {
+            return None;
+        }
+        match self.core.options.dest {
+            DestFramebuffer::Default { .. } => cache.transform,
+            DestFramebuffer::Other(_) => None,
+        }
+    }
+
+    /// Declares the render transform for the frame about to be drawn, for temporal reuse.
+    ///
+    /// Call this after `begin_scene()` and before issuing render commands. If a retained frame is
+    /// available (see `retained_frame_transform()`), it will be reprojected from its original
+    /// transform to the given one before this frame's tiles composite on top. The transform is
+    /// also recorded alongside this frame's output when it's retained at `end_scene()` time.
+    pub fn begin_temporal_frame(&mut self, new_transform: Transform4F) {
+        self.pending_temporal_transform = Some(new_transform);
+    }
+
+    // Draws the retained frame, reprojected under the transform declared for this frame, into the
+    // intermediate destination framebuffer. Subsequent tile draws composite on top.
+    fn reproject_retained_frame_if_possible(&mut self) {
+        let new_transform = match self.pending_temporal_transform {
+            Some(new_transform) => new_transform,
+            None => return,
+        };
+        if !self.core
+                .renderer_flags
+                .contains(RendererFlags::INTERMEDIATE_DEST_FRAMEBUFFER_NEEDED) {
+            return;
+        }
+        let (retained_framebuffer_id, old_transform) = match self.temporal_frame_cache {
+            Some(TemporalFrameCache {
+                framebuffer_id,
+                framebuffer_size,
+                transform: Some(old_transform),
+            }) if framebuffer_size == self.core.main_viewport().size() => {
+                (framebuffer_id, old_transform)
+            }
+            _ => return,
+        };
+
+        self.core.ensure_intermediate_dest_framebuffer();
+
+        let clear_color = self.core.clear_color_for_draw_operation();
+        let main_viewport = self.core.main_viewport();
+        let retained_texture = self.core
+                                   .device
+                                   .framebuffer_texture(self.core
+                                                            .allocator
+                                                            .get_framebuffer(retained_framebuffer_id));
+        let intermediate_dest_framebuffer =
+            self.core.allocator.get_framebuffer(self.core.intermediate_dest_framebuffer_id);
+
+        self.core.device.draw_elements(6, &RenderState {
+            target: &RenderTarget::Framebuffer(intermediate_dest_framebuffer),
+            program: &self.reprojection_program.program,
+            vertex_array: &self.frame.reprojection_vertex_array.vertex_array,
+            primitive: Primitive::Triangles,
+            textures: &[(&self.reprojection_program.texture, retained_texture)],
+            images: &[],
+            storage_buffers: &[],
+            uniforms: &[
+                (&self.reprojection_program.old_transform_uniform,
+                 UniformData::from_transform_3d(&old_transform)),
+                (&self.reprojection_program.new_transform_uniform,
+                 UniformData::from_transform_3d(&new_transform)),
+            ],
+            viewport: main_viewport,
+            options: RenderOptions {
+                blend: BlendMode::SrcOver.to_blend_state(),
+                clear_ops: ClearOps { color: clear_color, ..ClearOps::default() },
+                ..RenderOptions::default()
+            },
+        });
+
+        self.core.stats.drawcall_count += 1;
+
+        self.core.preserve_draw_framebuffer();
+    }
+
+    // Retains this frame's composited output for reuse by the next frame by swapping the
+    // intermediate destination framebuffer with the retained one. Must run after the intermediate
+    // destination framebuffer has been blitted to the output.
+    fn retain_temporal_frame_if_necessary(&mut self) {
+        let new_transform = self.pending_temporal_transform.take();
+        let cache = match self.temporal_frame_cache {
+            Some(ref mut cache) => cache,
+            None => return,
+        };
+        if new_transform.is_none() ||
+                !self.core
+                     .renderer_flags
+                     .contains(RendererFlags::INTERMEDIATE_DEST_FRAMEBUFFER_NEEDED) {
+            cache.transform = None;
+            return;
+        }
+
+        mem::swap(&mut cache.framebuffer_id, &mut self.core.intermediate_dest_framebuffer_id);
+        mem::swap(&mut cache.framebuffer_size,
+                  &mut self.core.intermediate_dest_framebuffer_size);
+        cache.transform = new_transform;
+    }
+
     fn push_render_target(&mut self, render_target_id: RenderTargetId) {
         self.core.render_target_stack.push(render_target_id);
     }
@@ -859,15 +1165,7 @@ impl<D> Renderer<D> where D: Device {
 
         let main_viewport = self.core.main_viewport();
 
-        if self.core.intermediate_dest_framebuffer_size != main_viewport.size() {
-            self.core.allocator.free_framebuffer(self.core.intermediate_dest_framebuffer_id);
-            self.core.intermediate_dest_framebuffer_id =
-                self.core.allocator.allocate_framebuffer(&self.core.device,
-                                                         main_viewport.size(),
-                                                         TextureFormat::RGBA8,
-                                                         FramebufferTag("IntermediateDest"));
-            self.core.intermediate_dest_framebuffer_size = main_viewport.size();
-        }
+        self.core.ensure_intermediate_dest_framebuffer();
 
         let intermediate_dest_framebuffer =
             self.core.allocator.get_framebuffer(self.core.intermediate_dest_framebuffer_id);
@@ -1129,6 +1427,9 @@ impl<D> RendererCore<D> where D: Device {
     // Pattern textures
 
     fn texture_page(&self, id: TexturePageId) -> &D::Texture {
+        if let Some(external_texture_id) = self.external_texture_pages.get(&id) {
+            return &self.external_textures[external_texture_id];
+        }
         self.device.framebuffer_texture(&self.texture_page_framebuffer(id))
     }
 
@@ -1220,6 +1521,21 @@ impl<D> RendererCore<D> where D: Device {
         }
     }
 
+    // Reallocates the intermediate destination framebuffer if its size no longer matches the
+    // main viewport.
+    fn ensure_intermediate_dest_framebuffer(&mut self) {
+        let main_viewport = self.main_viewport();
+        if self.intermediate_dest_framebuffer_size != main_viewport.size() {
+            self.allocator.free_framebuffer(self.intermediate_dest_framebuffer_id);
+            self.intermediate_dest_framebuffer_id =
+                self.allocator.allocate_framebuffer(&self.device,
+                                                    main_viewport.size(),
+                                                    TextureFormat::RGBA8,
+                                                    FramebufferTag("IntermediateDest"));
+            self.intermediate_dest_framebuffer_size = main_viewport.size();
+        }
+    }
+
     pub(crate) fn preserve_draw_framebuffer(&mut self) {
         match self.render_target_stack.last() {
             Some(&render_target_id) => {
@@ -1353,8 +1669,26 @@ pub(crate) struct PatternTexturePage {
     pub(crate) must_preserve_contents: bool,
 }
 
+/// A handle to an in-flight pixel readback, returned by
+/// `Renderer::read_render_target_pixels_async()` and `Renderer::read_dest_pixels_async()`.
+///
+/// Poll it with `Renderer::try_recv_pixels()` or block on it with `Renderer::recv_pixels()`.
+/// Dropping the handle abandons the readback.
+pub struct PixelReadback<D> where D: Device {
+    receiver: D::TextureDataReceiver,
+    viewport: RectI,
+}
+
+impl<D> PixelReadback<D> where D: Device {
+    /// The rectangle of pixels being read back, in device coordinates of the source target.
+    #[inline]
+    pub fn viewport(&self) -> RectI {
+        self.viewport
+    }
+}
+
 /// A mutable reference to the debug UI presenter.
-/// 
+///
 /// You can use this structure to draw custom debug widgets on screen, as the demo does.
 pub struct DebugUIPresenterInfo<'a, D> where D: Device {
     /// The GPU device.
@@ -11,12 +11,14 @@
 //! Packed data ready to be sent to the GPU.
 
 use crate::builder::{ALPHA_TILES_PER_LEVEL, ALPHA_TILE_LEVEL_COUNT};
+use crate::gpu::perf::CPUBuildTimes;
 use crate::options::BoundingQuad;
 use crate::paint::PaintCompositeOp;
 use crate::scene::PathId;
-use crate::tile_map::DenseTileMap;
+use crate::tile_map::{DenseTileMap, TileMapEntry};
 use pathfinder_color::ColorU;
 use pathfinder_content::effects::{BlendMode, Filter};
+use pathfinder_content::pattern::ExternalTextureId;
 use pathfinder_content::render_target::RenderTargetId;
 use pathfinder_geometry::line_segment::{LineSegment2F, LineSegmentU16};
 use pathfinder_geometry::rect::RectI;
@@ -61,6 +63,10 @@ pub enum RenderCommand {
     // TODO(pcwalton): Add a rect to this so we can render to subrects of a page.
     DeclareRenderTarget { id: RenderTargetId, location: TextureLocation },
 
+    // Associates an embedder-owned texture with a texture page, so that patterns can reference
+    // it without any CPU copy.
+    DeclareExternalTexture { id: ExternalTextureId, location: TextureLocation },
+
     // Upload texture metadata.
     UploadTextureMetadata(Vec<TextureMetadataEntry>),
 
@@ -95,10 +101,10 @@ pub enum RenderCommand {
     DrawTilesD3D11(DrawTileBatchD3D11),
 
     // Presents a rendered frame.
-    Finish { cpu_build_time: Duration },
+    Finish { cpu_build_time: Duration, cpu_build_times: CPUBuildTimes },
 }
 
-#[derive(Clone, Copy, PartialEq, Debug, Default)]
+#[derive(Clone, Copy, PartialEq, Eq, Hash, Debug, Default)]
 pub struct TexturePageId(pub u32);
 
 #[derive(Clone, Copy, Debug)]
@@ -165,6 +171,13 @@ pub struct PrepareTilesInfoD3D11 {
 pub struct SegmentsD3D11 {
     pub points: Vec<Vector2F>,
     pub indices: Vec<SegmentIndicesD3D11>,
+    /// Stroke expansion jobs for the GPU stroking stage, if any paths are stroked on GPU.
+    ///
+    /// For each job, the stroke compute shader reads the input segment at `input_point_index` and
+    /// writes the points of its stroke-boundary capsule into the reserved slots starting at
+    /// `output_point_index`. The segment indices for the capsule are laid out on CPU, since the
+    /// capsule shape has a fixed segment count.
+    pub stroke_segments: Vec<StrokeSegmentD3D11>,
 }
 
 #[derive(Clone, Copy, Debug)]
@@ -174,6 +187,21 @@ pub struct SegmentIndicesD3D11 {
     pub flags: u32,
 }
 
+/// A single stroke expansion job for the GPU stroking stage.
+#[derive(Clone, Copy, Debug)]
+#[repr(C)]
+pub struct StrokeSegmentD3D11 {
+    /// The index of the input segment's first point in the points array.
+    pub input_point_index: u32,
+    /// The index of the first of the capsule's reserved output points.
+    pub output_point_index: u32,
+    /// The curve flags of the input segment (`CURVE_IS_QUADRATIC`/`CURVE_IS_CUBIC`), or 0 for a
+    /// line.
+    pub flags: u32,
+    /// Half the stroke width, in path space.
+    pub radius: f32,
+}
+
 /// Information about clips applied to paths in a batch.
 #[derive(Clone, Debug)]
 pub struct ClippedPathInfo {
@@ -266,6 +294,17 @@ pub struct TileObjectPrimitive {
     pub backdrop: i8,
 }
 
+impl TileMapEntry for TileObjectPrimitive {
+    #[inline]
+    fn at_coords(&self, coords: Vector2I) -> TileObjectPrimitive {
+        TileObjectPrimitive {
+            tile_x: coords.x() as i16,
+            tile_y: coords.y() as i16,
+            ..*self
+        }
+    }
+}
+
 #[derive(Clone, Copy, Debug)]
 #[repr(C)]
 pub struct TileD3D11 {
@@ -479,6 +518,9 @@ impl Debug for RenderCommand {
             RenderCommand::DeclareRenderTarget { id, location } => {
                 write!(formatter, "DeclareRenderTarget({:?}, {:?})", id, location)
             }
+            RenderCommand::DeclareExternalTexture { id, location } => {
+                write!(formatter, "DeclareExternalTexture({:?}, {:?})", id, location)
+            }
             RenderCommand::UploadTextureMetadata(ref metadata) => {
                 write!(formatter, "UploadTextureMetadata(x{})", metadata.len())
             }
@@ -517,7 +559,7 @@ impl Debug for RenderCommand {
                        batch.tile_batch_data.batch_id,
                        batch.color_texture)
             }
-            RenderCommand::Finish { cpu_build_time } => {
+            RenderCommand::Finish { cpu_build_time, .. } => {
                 write!(formatter, "Finish({} ms)", cpu_build_time.as_secs_f64() * 1000.0)
             }
         }
@@ -22,6 +22,7 @@ pub mod gpu;
 pub mod options;
 pub mod paint;
 pub mod scene;
+pub mod snapshot;
 
 mod allocator;
 mod builder;
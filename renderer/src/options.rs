@@ -12,10 +12,11 @@
 
 use crate::gpu::options::RendererLevel;
 use crate::gpu_data::RenderCommand;
-use pathfinder_geometry::rect::RectF;
+use crate::tiles;
+use pathfinder_geometry::rect::{RectF, RectI};
 use pathfinder_geometry::transform2d::Transform2F;
 use pathfinder_geometry::transform3d::Perspective;
-use pathfinder_geometry::vector::{Vector2F, Vector4F};
+use pathfinder_geometry::vector::{Vector2F, Vector2I, Vector4F, vec2f};
 
 #[allow(deprecated)]
 use pathfinder_content::clip::PolygonClipper3D;
@@ -58,14 +59,40 @@ pub struct BuildOptions {
     pub dilation: Vector2F,
     /// True if subpixel antialiasing for LCD screens is to be performed.
     pub subpixel_aa_enabled: bool,
+    /// If nonempty, restricts rendering to the given damage rectangles, specified in scene
+    /// coordinates after `transform` has been applied.
+    ///
+    /// Fills and tiles that fall entirely outside every rectangle are culled during scene
+    /// building, so both fill rasterization and compositing cost scale with the damaged area.
+    /// Callers typically pass `None` for `RendererOptions::background_color` alongside this, so
+    /// that the undamaged portion of the destination framebuffer is preserved.
+    ///
+    /// This only takes effect when preparing scenes on CPU (the D3D9 renderer level).
+    pub dirty_rects: Vec<RectF>,
 }
 
 impl BuildOptions {
     pub(crate) fn prepare(self, bounds: RectF) -> PreparedBuildOptions {
+        let dirty_tile_rects = if self.dirty_rects.is_empty() {
+            None
+        } else {
+            Some(self.dirty_rects.iter().map(|&dirty_rect| {
+                // Subpixel AA scales the scene horizontally; keep the damage rectangles in the
+                // same space.
+                let dirty_rect = if self.subpixel_aa_enabled {
+                    dirty_rect * vec2f(3.0, 1.0)
+                } else {
+                    dirty_rect
+                };
+                tiles::round_rect_out_to_tile_bounds(dirty_rect)
+            }).collect())
+        };
+
         PreparedBuildOptions {
             transform: self.transform.prepare(bounds),
             dilation: self.dilation,
             subpixel_aa_enabled: self.subpixel_aa_enabled,
+            dirty_tile_rects,
         }
     }
 }
@@ -143,6 +170,7 @@ pub(crate) struct PreparedBuildOptions {
     pub(crate) transform: PreparedRenderTransform,
     pub(crate) dilation: Vector2F,
     pub(crate) subpixel_aa_enabled: bool,
+    pub(crate) dirty_tile_rects: Option<Vec<RectI>>,
 }
 
 #[derive(Clone, Copy)]
@@ -153,6 +181,20 @@ pub(crate) enum PrepareMode {
 }
 
 impl PreparedBuildOptions {
+    /// Returns true if the tile with the given coordinates intersects the damage rectangles (or
+    /// if there are none, in which case everything is considered damaged).
+    #[inline]
+    pub(crate) fn tile_is_dirty(&self, tile_coords: Vector2I) -> bool {
+        match self.dirty_tile_rects {
+            None => true,
+            Some(ref dirty_tile_rects) => {
+                dirty_tile_rects.iter().any(|dirty_tile_rect| {
+                    dirty_tile_rect.contains_point(tile_coords)
+                })
+            }
+        }
+    }
+
     #[inline]
     pub(crate) fn bounding_quad(&self) -> BoundingQuad {
         match self.transform {
@@ -12,13 +12,13 @@
 
 use crate::allocator::{AllocationMode, TextureAllocator};
 use crate::gpu_data::{ColorCombineMode, RenderCommand, TextureLocation, TextureMetadataEntry};
-use crate::gpu_data::{TexturePageDescriptor, TexturePageId, TileBatchTexture};
+use crate::gpu_data::{TexturePageDescriptor, TileBatchTexture};
 use crate::scene::{RenderTarget, SceneId};
 use hashbrown::{HashMap, HashSet};
 use pathfinder_color::ColorU;
 use pathfinder_content::effects::{BlendMode, Filter, PatternFilter};
 use pathfinder_content::gradient::{Gradient, GradientGeometry, GradientWrap};
-use pathfinder_content::pattern::{ImageHash, Pattern, PatternSource};
+use pathfinder_content::pattern::{ExternalTextureId, ImageHash, Pattern, PatternSource};
 use pathfinder_content::render_target::RenderTargetId;
 use pathfinder_geometry::line_segment::LineSegment2F;
 use pathfinder_geometry::rect::{RectF, RectI};
@@ -26,8 +26,10 @@ use pathfinder_geometry::transform2d::Transform2F;
 use pathfinder_geometry::vector::{Vector2F, Vector2I, vec2f, vec2i};
 use pathfinder_gpu::TextureSamplingFlags;
 use pathfinder_simd::default::{F32x2, F32x4};
+use std::collections::hash_map::DefaultHasher;
 use std::f32;
 use std::fmt::{self, Debug, Formatter};
+use std::hash::{Hash, Hasher};
 use std::sync::Arc;
 
 // The size of a gradient tile.
@@ -44,10 +46,28 @@ pub(crate) struct Palette {
     scene_id: SceneId,
 }
 
-// Caches texture images from scene to scene.
+// Caches gradient ramps and texture images from scene to scene.
 pub(crate) struct PaintTextureManager {
     allocator: TextureAllocator,
     cached_images: HashMap<ImageHash, TextureLocation>,
+    cached_gradients: HashMap<GradientRampHash, TextureLocation>,
+    gradient_pages: Vec<GradientPage>,
+}
+
+// A content hash of the color stops of a gradient, which fully determine its ramp texels.
+//
+// Two gradients with the same stops but different geometry share one ramp.
+#[derive(Clone, Copy, PartialEq, Eq, Hash, Debug)]
+struct GradientRampHash(u64);
+
+// A texture page that stores gradient ramps, one per row.
+//
+// Unlike images and render targets, these pages persist across builds so that ramps for
+// unchanged gradients can be reused without resampling or reuploading them.
+struct GradientPage {
+    location: TextureLocation,
+    next_row: u32,
+    free_rows: Vec<u32>,
 }
 
 /// Defines how a path is to be filled: with a solid color, gradient, or pattern.
@@ -389,6 +409,10 @@ impl Palette {
         paint_id
     }
 
+    pub(crate) fn render_targets(&self) -> &[RenderTarget] {
+        &self.render_targets
+    }
+
     pub(crate) fn push_render_target(&mut self, render_target: RenderTarget) -> RenderTargetId {
         let id = self.render_targets.len() as u32;
         self.render_targets.push(render_target);
@@ -404,15 +428,20 @@ impl Palette {
         let render_target_metadata =
             self.assign_render_target_locations(texture_manager, &mut transient_paint_locations);
 
+        // Assign external texture locations.
+        let external_texture_metadata =
+            self.assign_external_texture_locations(texture_manager, &mut transient_paint_locations);
+
         // Assign paint locations.
         let PaintLocationsInfo {
             mut paint_metadata,
-            gradient_tile_builder,
+            gradient_texel_info,
             image_texel_info,
+            used_gradient_hashes,
             used_image_hashes,
         } = self.assign_paint_locations(&render_target_metadata,
-                                        texture_manager,
-                                        &mut transient_paint_locations);
+                                        &external_texture_metadata,
+                                        texture_manager);
 
         // Calculate texture transforms.
         self.calculate_texture_transforms(&mut paint_metadata, texture_manager, render_transform);
@@ -422,16 +451,19 @@ impl Palette {
         let mut render_commands = vec![RenderCommand::UploadTextureMetadata(texture_metadata)];
 
         // Allocate textures.
-        self.allocate_textures(&mut render_commands, texture_manager);
+        self.allocate_textures(&mut render_commands, texture_manager, &external_texture_metadata);
 
         // Create render commands.
         self.create_render_commands(&mut render_commands,
                                     render_target_metadata,
-                                    gradient_tile_builder,
+                                    external_texture_metadata,
+                                    gradient_texel_info,
                                     image_texel_info);
 
-        // Free transient locations and unused images, now that they're no longer needed.
+        // Free transient locations and unused gradients and images, now that they're no longer
+        // needed.
         self.free_transient_locations(texture_manager, transient_paint_locations);
+        self.free_unused_gradients(texture_manager, used_gradient_hashes);
         self.free_unused_images(texture_manager, used_image_hashes);
 
         PaintInfo { render_commands, paint_metadata }
@@ -450,17 +482,46 @@ impl Palette {
         render_target_metadata
     }
 
+    // Reserves a texture page for each external texture that the paints reference. The pages
+    // aren't backed by GPU memory of their own; the renderer resolves them to the registered
+    // embedder-owned textures at composite time, so no pixels are ever copied.
+    fn assign_external_texture_locations(&self,
+                                         texture_manager: &mut PaintTextureManager,
+                                         transient_paint_locations: &mut Vec<TextureLocation>)
+                                         -> HashMap<ExternalTextureId, TextureLocation> {
+        let mut external_texture_metadata = HashMap::new();
+        for paint in &self.paints {
+            let overlay = match paint.overlay {
+                Some(ref overlay) => overlay,
+                None => continue,
+            };
+            let pattern = match overlay.contents {
+                PaintContents::Pattern(ref pattern) => pattern,
+                PaintContents::Gradient(_) => continue,
+            };
+            if let PatternSource::ExternalTexture { id, size } = *pattern.source() {
+                external_texture_metadata.entry(id).or_insert_with(|| {
+                    let location = texture_manager.allocator.allocate_image(size);
+                    transient_paint_locations.push(location);
+                    location
+                });
+            }
+        }
+        external_texture_metadata
+    }
+
     fn assign_paint_locations(&self,
                               render_target_metadata: &[RenderTargetMetadata],
-                              texture_manager: &mut PaintTextureManager,
-                              transient_paint_locations: &mut Vec<TextureLocation>)
+                              external_texture_metadata: &HashMap<ExternalTextureId,
+                                                                  TextureLocation>,
+                              texture_manager: &mut PaintTextureManager)
                               -> PaintLocationsInfo {
         let mut paint_metadata = vec![];
-        let mut gradient_tile_builder = GradientTileBuilder::new();
+        let mut gradient_texel_info = vec![];
         let mut image_texel_info = vec![];
+        let mut used_gradient_hashes = HashSet::new();
         let mut used_image_hashes = HashSet::new();
         for paint in &self.paints {
-            let allocator = &mut texture_manager.allocator;
             let color_texture_metadata = match paint.overlay {
                 None => None,
                 Some(ref overlay) => {
@@ -474,15 +535,29 @@ impl Palette {
                                 GradientWrap::Clamp => {}
                             }
 
+                            // Reuse the ramp from a previous build if one with the same stops
+                            // exists; otherwise, sample the gradient into a fresh row.
+                            //
                             // FIXME(pcwalton): The gradient size might not be big enough. Detect
                             // this.
-                            let location =
-                                gradient_tile_builder.allocate(allocator,
-                                                               transient_paint_locations,
-                                                               gradient);
+                            let ramp_hash = gradient_ramp_hash(gradient);
+                            used_gradient_hashes.insert(ramp_hash);
+                            let location = match texture_manager.cached_gradients
+                                                                .get(&ramp_hash) {
+                                Some(&location) => location,
+                                None => {
+                                    let location = texture_manager.allocate_gradient_row();
+                                    texture_manager.cached_gradients.insert(ramp_hash, location);
+                                    gradient_texel_info.push(ImageTexelInfo {
+                                        location,
+                                        texels: Arc::new(build_gradient_ramp(gradient)),
+                                    });
+                                    location
+                                }
+                            };
                             Some(PaintColorTextureMetadata {
                                 location,
-                                page_scale: allocator.page_scale(location.page),
+                                page_scale: texture_manager.allocator.page_scale(location.page),
                                 sampling_flags,
                                 filter: match gradient.geometry {
                                     GradientGeometry::Linear(_) => PaintFilter::None,
@@ -505,32 +580,36 @@ impl Palette {
                                     let index = render_target_id.render_target as usize;
                                     location = render_target_metadata[index].location;
                                 }
+                                PatternSource::ExternalTexture { id, .. } => {
+                                    location = external_texture_metadata[&id];
+                                }
                                 PatternSource::Image(ref image) => {
                                     // TODO(pcwalton): We should be able to use tile cleverness to
                                     // repeat inside the atlas in some cases.
                                     let image_hash = image.get_hash();
+                                    used_image_hashes.insert(image_hash);
                                     match texture_manager.cached_images.get(&image_hash) {
                                         Some(cached_location) => {
+                                            // The texels are already on the GPU; skip the upload.
                                             location = *cached_location;
-                                            used_image_hashes.insert(image_hash);
                                         }
                                         None => {
                                             // Leave a pixel of border on the side.
                                             let allocation_mode = AllocationMode::OwnPage;
-                                            location = allocator.allocate(
+                                            location = texture_manager.allocator.allocate(
                                                 image.size() + border * 2,
                                                 allocation_mode);
                                             texture_manager.cached_images.insert(image_hash,
                                                                                  location);
+                                            image_texel_info.push(ImageTexelInfo {
+                                                location: TextureLocation {
+                                                    page: location.page,
+                                                    rect: location.rect.contract(border),
+                                                },
+                                                texels: (*image.pixels()).clone(),
+                                            });
                                         }
                                     }
-                                    image_texel_info.push(ImageTexelInfo {
-                                        location: TextureLocation {
-                                            page: location.page,
-                                            rect: location.rect.contract(border),
-                                        },
-                                        texels: (*image.pixels()).clone(),
-                                    });
                                 }
                             }
 
@@ -553,7 +632,7 @@ impl Palette {
 
                             Some(PaintColorTextureMetadata {
                                 location,
-                                page_scale: allocator.page_scale(location.page),
+                                page_scale: texture_manager.allocator.page_scale(location.page),
                                 sampling_flags,
                                 filter,
                                 transform: Transform2F::from_translation(border.to_f32()),
@@ -576,8 +655,9 @@ impl Palette {
 
         PaintLocationsInfo {
             paint_metadata,
-            gradient_tile_builder,
+            gradient_texel_info,
             image_texel_info,
+            used_gradient_hashes,
             used_image_hashes,
         }
     }
@@ -617,7 +697,7 @@ impl Palette {
                 }) => transform.inverse(),
                 PaintContents::Pattern(ref pattern) => {
                     match pattern.source() {
-                        PatternSource::Image(_) => {
+                        PatternSource::Image(_) | PatternSource::ExternalTexture { .. } => {
                             let texture_origin_uv =
                                 rect_to_uv(texture_rect, texture_scale).origin();
                             Transform2F::from_scale(texture_scale).translate(texture_origin_uv) *
@@ -660,11 +740,18 @@ impl Palette {
 
     fn allocate_textures(&self,
                          render_commands: &mut Vec<RenderCommand>,
-                         texture_manager: &mut PaintTextureManager) {
+                         texture_manager: &mut PaintTextureManager,
+                         external_texture_metadata: &HashMap<ExternalTextureId,
+                                                             TextureLocation>) {
         for page_id in texture_manager.allocator.page_ids() {
             let page_size = texture_manager.allocator.page_size(page_id);
             let descriptor = TexturePageDescriptor { size: page_size };
 
+            // Pages resolved to external textures have no GPU storage of their own.
+            if external_texture_metadata.values().any(|location| location.page == page_id) {
+                continue;
+            }
+
             if texture_manager.allocator.page_is_new(page_id) {
                 render_commands.push(RenderCommand::AllocateTexturePage { page_id, descriptor });
             }
@@ -675,7 +762,9 @@ impl Palette {
     fn create_render_commands(&self,
                               render_commands: &mut Vec<RenderCommand>,
                               render_target_metadata: Vec<RenderTargetMetadata>,
-                              gradient_tile_builder: GradientTileBuilder,
+                              external_texture_metadata: HashMap<ExternalTextureId,
+                                                                 TextureLocation>,
+                              gradient_texel_info: Vec<ImageTexelInfo>,
                               image_texel_info: Vec<ImageTexelInfo>) {
         for (index, metadata) in render_target_metadata.iter().enumerate() {
             let id = RenderTargetId { scene: self.scene_id.0, render_target: index as u32 };
@@ -684,11 +773,13 @@ impl Palette {
                 location: metadata.location,
             });
         }
-        gradient_tile_builder.create_render_commands(render_commands);
-        for image_texel_info in image_texel_info {
+        for (id, location) in external_texture_metadata {
+            render_commands.push(RenderCommand::DeclareExternalTexture { id, location });
+        }
+        for texel_info in gradient_texel_info.into_iter().chain(image_texel_info.into_iter()) {
             render_commands.push(RenderCommand::UploadTexelData {
-                texels: image_texel_info.texels,
-                location: image_texel_info.location,
+                texels: texel_info.texels,
+                location: texel_info.location,
             });
         }
     }
@@ -701,6 +792,23 @@ impl Palette {
         }
     }
 
+    // Frees gradient ramps that are cached but not used this frame.
+    fn free_unused_gradients(&self,
+                             texture_manager: &mut PaintTextureManager,
+                             used_gradient_hashes: HashSet<GradientRampHash>) {
+        let mut freed_locations = vec![];
+        texture_manager.cached_gradients.retain(|ramp_hash, location| {
+            let keep = used_gradient_hashes.contains(ramp_hash);
+            if !keep {
+                freed_locations.push(*location);
+            }
+            keep
+        });
+        for location in freed_locations {
+            texture_manager.free_gradient_row(location);
+        }
+    }
+
     // Frees images that are cached but not used this frame.
     fn free_unused_images(&self,
                           texture_manager: &mut PaintTextureManager,
@@ -769,6 +877,44 @@ impl PaintTextureManager {
         PaintTextureManager {
             allocator: TextureAllocator::new(),
             cached_images: HashMap::new(),
+            cached_gradients: HashMap::new(),
+            gradient_pages: vec![],
+        }
+    }
+
+    // Reserves a row for a gradient ramp, opening a new gradient page if every row of every
+    // existing page is in use.
+    fn allocate_gradient_row(&mut self) -> TextureLocation {
+        for page in &mut self.gradient_pages {
+            let row = match page.free_rows.pop() {
+                Some(row) => row,
+                None if page.next_row < GRADIENT_TILE_LENGTH => {
+                    let row = page.next_row;
+                    page.next_row += 1;
+                    row
+                }
+                None => continue,
+            };
+            return TextureLocation { page: page.location.page, rect: gradient_row_rect(row) };
+        }
+
+        let size = Vector2I::splat(GRADIENT_TILE_LENGTH as i32);
+        let location = self.allocator.allocate(size, AllocationMode::OwnPage);
+        self.gradient_pages.push(GradientPage { location, next_row: 1, free_rows: vec![] });
+        TextureLocation { page: location.page, rect: gradient_row_rect(0) }
+    }
+
+    // Returns a gradient ramp's row to its page, freeing the page once all its rows are free.
+    fn free_gradient_row(&mut self, location: TextureLocation) {
+        let page_index = self.gradient_pages
+                             .iter()
+                             .position(|page| page.location.page == location.page)
+                             .expect("No gradient page for freed ramp!");
+        let page = &mut self.gradient_pages[page_index];
+        page.free_rows.push(location.rect.origin_y() as u32);
+        if page.free_rows.len() as u32 == page.next_row {
+            let page = self.gradient_pages.swap_remove(page_index);
+            self.allocator.free(page.location);
         }
     }
 }
@@ -810,77 +956,37 @@ fn rect_to_uv(rect: RectI, texture_scale: Vector2F) -> RectF {
 
 // Gradient allocation
 
-struct GradientTileBuilder {
-    tiles: Vec<GradientTile>,
+fn gradient_row_rect(row: u32) -> RectI {
+    RectI::new(vec2i(0, row as i32), vec2i(GRADIENT_TILE_LENGTH as i32, 1))
 }
 
-struct GradientTile {
-    texels: Vec<ColorU>,
-    page: TexturePageId,
-    next_index: u32,
+fn gradient_ramp_hash(gradient: &Gradient) -> GradientRampHash {
+    let mut hasher = DefaultHasher::new();
+    for stop in gradient.stops() {
+        stop.offset.to_bits().hash(&mut hasher);
+        stop.color.hash(&mut hasher);
+    }
+    GradientRampHash(hasher.finish())
 }
 
-impl GradientTileBuilder {
-    fn new() -> GradientTileBuilder {
-        GradientTileBuilder { tiles: vec![] }
-    }
-
-    fn allocate(&mut self,
-                allocator: &mut TextureAllocator,
-                transient_paint_locations: &mut Vec<TextureLocation>,
-                gradient: &Gradient)
-                -> TextureLocation {
-        if self.tiles.is_empty() ||
-                self.tiles.last().unwrap().next_index == GRADIENT_TILE_LENGTH {
-            let size = Vector2I::splat(GRADIENT_TILE_LENGTH as i32);
-            let area = size.x() as usize * size.y() as usize;
-            let page_location = allocator.allocate(size, AllocationMode::OwnPage);
-            transient_paint_locations.push(page_location);
-            self.tiles.push(GradientTile {
-                texels: vec![ColorU::black(); area],
-                page: page_location.page,
-                next_index: 0,
-            })
-        }
-
-        let mut data = self.tiles.last_mut().unwrap();
-        let location = TextureLocation {
-            page: data.page,
-            rect: RectI::new(vec2i(0, data.next_index as i32),
-                             vec2i(GRADIENT_TILE_LENGTH as i32, 1)),
-        };
-        data.next_index += 1;
-
-        // FIXME(pcwalton): Paint transparent if gradient line has zero size, per spec.
-        // TODO(pcwalton): Optimize this:
-        // 1. Calculate ∇t up front and use differencing in the inner loop.
-        // 2. Go four pixels at a time with SIMD.
-        let first_address = location.rect.origin_y() as usize * GRADIENT_TILE_LENGTH as usize;
-        for x in 0..(GRADIENT_TILE_LENGTH as i32) {
-            let t = (x as f32 + 0.5) / GRADIENT_TILE_LENGTH as f32;
-            data.texels[first_address + x as usize] = gradient.sample(t);
-        }
-
-        location
-    }
-
-    fn create_render_commands(self, render_commands: &mut Vec<RenderCommand>) {
-        for tile in self.tiles {
-            render_commands.push(RenderCommand::UploadTexelData {
-                texels: Arc::new(tile.texels),
-                location: TextureLocation {
-                    rect: RectI::new(vec2i(0, 0), Vector2I::splat(GRADIENT_TILE_LENGTH as i32)),
-                    page: tile.page,
-                },
-            });
-        }
-    }
+fn build_gradient_ramp(gradient: &Gradient) -> Vec<ColorU> {
+    // FIXME(pcwalton): Paint transparent if gradient line has zero size, per spec.
+    // TODO(pcwalton): Optimize this:
+    // 1. Calculate ∇t up front and use differencing in the inner loop.
+    // 2. Go four pixels at a time with SIMD.
+    let mut texels = Vec::with_capacity(GRADIENT_TILE_LENGTH as usize);
+    for x in 0..GRADIENT_TILE_LENGTH {
+        let t = (x as f32 + 0.5) / GRADIENT_TILE_LENGTH as f32;
+        texels.push(gradient.sample(t));
+    }
+    texels
 }
 
 struct PaintLocationsInfo {
     paint_metadata: Vec<PaintMetadata>,
-    gradient_tile_builder: GradientTileBuilder,
+    gradient_texel_info: Vec<ImageTexelInfo>,
     image_texel_info: Vec<ImageTexelInfo>,
+    used_gradient_hashes: HashSet<GradientRampHash>,
     used_image_hashes: HashSet<ImageHash>,
 }
 
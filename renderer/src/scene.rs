@@ -10,7 +10,7 @@
 
 //! The vector scene to be rendered.
 
-use crate::builder::SceneBuilder;
+use crate::builder::{SceneBuildCache, SceneBuilder, SymbolTileCache};
 use crate::concurrent::executor::Executor;
 use crate::gpu::options::RendererLevel;
 use crate::gpu::renderer::Renderer;
@@ -18,33 +18,47 @@ use crate::gpu_data::RenderCommand;
 use crate::options::{BuildOptions, PreparedBuildOptions};
 use crate::options::{PreparedRenderTransform, RenderCommandListener};
 use crate::paint::{MergedPaletteInfo, Paint, PaintId, PaintInfo, PaintTextureManager, Palette};
+use fxhash::FxHashSet;
 use pathfinder_content::effects::BlendMode;
 use pathfinder_content::fill::FillRule;
-use pathfinder_content::outline::Outline;
+use pathfinder_content::outline::{Outline, OutlineArena};
 use pathfinder_content::render_target::RenderTargetId;
+use pathfinder_content::stroke::StrokeStyle;
 use pathfinder_geometry::rect::RectF;
 use pathfinder_geometry::transform2d::Transform2F;
 use pathfinder_geometry::vector::{Vector2I, vec2f};
 use pathfinder_gpu::Device;
 use std::mem;
 use std::ops::Range;
-use std::sync::atomic::{AtomicUsize, Ordering};
+use std::sync::atomic::{AtomicU64, AtomicUsize, Ordering};
 use std::sync::{Arc, Mutex};
 use std::u64;
 
 static NEXT_SCENE_ID: AtomicUsize = AtomicUsize::new(0);
+static NEXT_SYMBOL_RENDER_KEY: AtomicU64 = AtomicU64::new(0);
 
 /// The vector scene to be rendered.
 #[derive(Clone)]
 pub struct Scene {
-    display_list: Vec<DisplayItem>,
-    draw_paths: Vec<DrawPath>,
-    clip_paths: Vec<ClipPath>,
-    palette: Palette,
+    pub(crate) display_list: Vec<DisplayItem>,
+    pub(crate) draw_paths: Vec<DrawPath>,
+    pub(crate) clip_paths: Vec<ClipPath>,
+    pub(crate) palette: Palette,
     bounds: RectF,
     view_box: RectF,
     id: SceneId,
     epoch: SceneEpoch,
+    dirty_draw_paths: DirtyDrawPaths,
+}
+
+/// Tracks which draw paths have been mutated since the scene was last built, so that the builder
+/// can reuse built tile data for the rest.
+#[derive(Clone)]
+pub(crate) enum DirtyDrawPaths {
+    /// Everything must be rebuilt.
+    All,
+    /// Only the given draw paths changed since the last build.
+    Paths(FxHashSet<DrawPathId>),
 }
 
 /// A globally-unique identifier for the scene.
@@ -65,6 +79,7 @@ impl Scene {
             view_box: RectF::default(),
             id: scene_id,
             epoch: SceneEpoch::new(0, 1),
+            dirty_draw_paths: DirtyDrawPaths::All,
         }
     }
 
@@ -91,9 +106,72 @@ impl Scene {
             _ => self.display_list.push(DisplayItem::DrawPaths(draw_path_id..end_path_id)),
         }
 
+        self.mark_draw_path_dirty(draw_path_id);
+    }
+
+    /// Replaces the draw path with the given ID with a new one.
+    ///
+    /// The path keeps its ID and its position in the drawing order. Only the replaced path is
+    /// marked dirty, so the next build can reuse built tile data for all other paths.
+    pub fn replace_draw_path(&mut self, draw_path_id: DrawPathId, new_draw_path: DrawPath) {
+        self.draw_paths[draw_path_id.0 as usize] = new_draw_path;
+        self.recompute_bounds();
+        self.mark_draw_path_dirty(draw_path_id);
+    }
+
+    /// Applies an affine transform to the draw path with the given ID.
+    pub fn transform_draw_path(&mut self, draw_path_id: DrawPathId, transform: &Transform2F) {
+        self.draw_paths[draw_path_id.0 as usize].outline.transform(transform);
+        self.recompute_bounds();
+        self.mark_draw_path_dirty(draw_path_id);
+    }
+
+    /// Changes the paint of the draw path with the given ID.
+    pub fn set_draw_path_paint(&mut self, draw_path_id: DrawPathId, new_paint: PaintId) {
+        self.draw_paths[draw_path_id.0 as usize].paint = new_paint;
+        self.mark_draw_path_dirty(draw_path_id);
+    }
+
+    /// Sets or clears the clip path of the draw path with the given ID.
+    pub fn set_draw_path_clip_path(&mut self,
+                                   draw_path_id: DrawPathId,
+                                   new_clip_path: Option<ClipPathId>) {
+        self.draw_paths[draw_path_id.0 as usize].clip_path = new_clip_path;
+        self.mark_draw_path_dirty(draw_path_id);
+    }
+
+    /// Removes the draw path with the given ID from the scene.
+    ///
+    /// So that the IDs of all other paths remain stable, the path is replaced with an empty one
+    /// rather than shifting subsequent paths down.
+    pub fn remove_draw_path(&mut self, draw_path_id: DrawPathId) {
+        let paint = self.draw_paths[draw_path_id.0 as usize].paint;
+        self.replace_draw_path(draw_path_id, DrawPath::new(Outline::new(), paint));
+    }
+
+    fn recompute_bounds(&mut self) {
+        self.bounds = RectF::default();
+        for clip_path in &self.clip_paths {
+            self.bounds = self.bounds.union_rect(clip_path.outline.bounds());
+        }
+        for draw_path in &self.draw_paths {
+            self.bounds = self.bounds.union_rect(draw_path.outline.bounds());
+        }
+    }
+
+    fn mark_draw_path_dirty(&mut self, draw_path_id: DrawPathId) {
+        if let DirtyDrawPaths::Paths(ref mut dirty_paths) = self.dirty_draw_paths {
+            dirty_paths.insert(draw_path_id);
+        }
         self.epoch.next();
     }
 
+    /// Returns the set of draw paths mutated since the last build and resets the tracking, so
+    /// that subsequent mutations are recorded relative to this build.
+    pub(crate) fn take_dirty_draw_paths(&mut self) -> DirtyDrawPaths {
+        mem::replace(&mut self.dirty_draw_paths, DirtyDrawPaths::Paths(FxHashSet::default()))
+    }
+
     /// Defines a clip path. Returns an ID that can be used to later clip draw paths.
     pub fn push_clip_path(&mut self, clip_path: ClipPath) -> ClipPathId {
         self.bounds = self.bounds.union_rect(clip_path.outline.bounds());
@@ -150,6 +228,8 @@ impl Scene {
                 }),
                 fill_rule: draw_path.fill_rule,
                 blend_mode: draw_path.blend_mode,
+                stroke_style: draw_path.stroke_style,
+                symbol_key: draw_path.symbol_key,
                 name: draw_path.name,
             });
         }
@@ -211,6 +291,17 @@ impl Scene {
         self.epoch.next();
     }
 
+    /// Consumes this scene, returning the point storage of all of its paths to the given arena
+    /// so that later path construction can reuse it.
+    pub fn recycle_storage(self, arena: &mut OutlineArena) {
+        for draw_path in self.draw_paths {
+            arena.recycle_outline(draw_path.outline);
+        }
+        for clip_path in self.clip_paths {
+            arena.recycle_outline(clip_path.outline);
+        }
+    }
+
     /// Returns the view box, which defines the visible portion of the scene.
     #[inline]
     pub fn view_box(&self) -> RectF {
@@ -386,6 +477,8 @@ pub struct SceneSink<'a> {
     pub(crate) renderer_level: RendererLevel,
     pub(crate) last_scene: Option<LastSceneInfo>,
     pub(crate) paint_texture_manager: PaintTextureManager,
+    pub(crate) build_cache: Option<SceneBuildCache>,
+    pub(crate) symbol_tile_cache: SymbolTileCache,
 }
 
 pub(crate) struct LastSceneInfo {
@@ -432,6 +525,8 @@ impl<'a> SceneSink<'a> {
             renderer_level,
             last_scene: None,
             paint_texture_manager: PaintTextureManager::new(),
+            build_cache: None,
+            symbol_tile_cache: SymbolTileCache::new(),
         }
     }
 }
@@ -449,12 +544,38 @@ pub struct DrawPath {
     pub fill_rule: FillRule,
     /// How to blend this path with everything below it.
     pub blend_mode: BlendMode,
+    /// If present, the outline is a stroke centerline to be expanded by this style, rather than a
+    /// fill boundary.
+    pub stroke_style: Option<StrokeStyle>,
+    /// An optional key identifying the symbol this path is an instance of, if it is one of many
+    /// copies of a shared shape (a glyph, a map marker, and so on).
+    pub symbol_key: Option<SymbolRenderKey>,
     /// The name of this path, for debugging.
     ///
     /// Pass the empty string (which does not allocate) if debugging is not needed.
     pub name: String,
 }
 
+/// An opaque key identifying a symbol: a shape that is drawn many times at translated positions,
+/// such as a glyph of text or a map marker. The key identifies the shape itself — for a glyph,
+/// its font, glyph ID, size, and any transform applied during layout — but not its position.
+///
+/// Clients attach these to draw paths via `DrawPath::set_symbol_key()` so that the renderer can
+/// share built tile data among repeated instances of the same symbol. Text layout engines
+/// typically hash the glyph identity into a key; other clients can allocate fresh keys with
+/// `SymbolRenderKey::new()`.
+#[derive(Clone, Copy, PartialEq, Eq, Hash, Debug)]
+pub struct SymbolRenderKey(pub u64);
+
+impl SymbolRenderKey {
+    /// Allocates a key that no other call to this function will return for the lifetime of the
+    /// process.
+    #[inline]
+    pub fn new() -> SymbolRenderKey {
+        SymbolRenderKey(NEXT_SYMBOL_RENDER_KEY.fetch_add(1, Ordering::Relaxed))
+    }
+}
+
 /// Describes a path that can be used to clip other paths.
 #[derive(Clone, Debug)]
 pub struct ClipPath {
@@ -521,6 +642,8 @@ impl DrawPath {
             clip_path: None,
             fill_rule: FillRule::Winding,
             blend_mode: BlendMode::SrcOver,
+            stroke_style: None,
+            symbol_key: None,
             name: String::new(),
         }
     }
@@ -555,6 +678,16 @@ impl DrawPath {
         self.fill_rule
     }
 
+    // The fill rule that the built path will actually be filled with. Stroked paths are always
+    // filled with the winding rule, since stroke expansion produces overlapping geometry.
+    #[inline]
+    pub(crate) fn effective_fill_rule(&self) -> FillRule {
+        match self.stroke_style {
+            Some(_) => FillRule::Winding,
+            None => self.fill_rule,
+        }
+    }
+
     /// Sets the fill rule: even-odd or winding.
     #[inline]
     pub fn set_fill_rule(&mut self, new_fill_rule: FillRule) {
@@ -573,6 +706,37 @@ impl DrawPath {
         self.blend_mode = new_blend_mode
     }
 
+    #[inline]
+    pub(crate) fn stroke_style(&self) -> Option<StrokeStyle> {
+        self.stroke_style
+    }
+
+    /// Marks the outline of this path as a stroke centerline to be expanded by the given style,
+    /// rather than a fill boundary.
+    ///
+    /// On the Direct3D 11-level renderer, paths with round joins and caps are stroked by a GPU
+    /// compute stage; other paths are stroked on CPU during scene building. The fill rule is
+    /// ignored for stroked paths, which are always filled with the winding rule.
+    #[inline]
+    pub fn set_stroke_style(&mut self, new_stroke_style: Option<StrokeStyle>) {
+        self.stroke_style = new_stroke_style
+    }
+
+    #[inline]
+    pub(crate) fn symbol_key(&self) -> Option<SymbolRenderKey> {
+        self.symbol_key
+    }
+
+    /// Marks this path as an instance of a symbol, so that the renderer can share built tile
+    /// data among repeated instances of the same symbol.
+    ///
+    /// The key must fully determine the shape of the outline up to translation: two draw paths
+    /// may carry the same key only if their outlines are translates of each other.
+    #[inline]
+    pub fn set_symbol_key(&mut self, new_symbol_key: Option<SymbolRenderKey>) {
+        self.symbol_key = new_symbol_key
+    }
+
     /// Assigns a name to this path, for debugging.
     #[inline]
     pub fn set_name(&mut self, new_name: String) {
@@ -643,6 +807,11 @@ impl RenderTarget {
     pub fn size(&self) -> Vector2I {
         self.size
     }
+
+    #[inline]
+    pub(crate) fn name(&self) -> &str {
+        &self.name
+    }
 }
 
 impl DrawPathId {
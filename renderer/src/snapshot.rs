@@ -0,0 +1,782 @@
+// pathfinder/renderer/src/snapshot.rs
+//
+// Copyright © 2021 The Pathfinder Project Developers.
+//
+// Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+// http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+// <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+// option. This file may not be copied, modified, or distributed
+// except according to those terms.
+
+//! A versioned binary snapshot format for scenes.
+//!
+//! Loading a large vector document through a front end like the SVG importer costs seconds of
+//! parsing, stroking, and path assembly at startup. Snapshots instead store a scene the way
+//! Pathfinder keeps it in memory — the outline point and flag arrays, the paint palette, and the
+//! display list — in a fixed little-endian layout. All fields are 4-byte aligned and bulk data
+//! (points, point flags, image pixels) is stored as raw arrays, so a snapshot can be loaded from
+//! a memory-mapped file with no parsing beyond a handful of bounds checks and bulk copies, and
+//! the resulting scene handed straight to the scene builder.
+//!
+//! Paints backed by render targets, and patterns with filters attached, can't be represented in
+//! version 1 of the format; writing a scene that contains them fails with
+//! `SnapshotError::UnsupportedPaint`.
+
+use crate::paint::{Paint, PaintCompositeOp, PaintContents, PaintId};
+use crate::scene::{ClipPath, ClipPathId, DisplayItem, DrawPath, DrawPathId, SymbolRenderKey};
+use crate::scene::{RenderTarget, Scene};
+use pathfinder_color::ColorU;
+use pathfinder_content::effects::BlendMode;
+use pathfinder_content::fill::FillRule;
+use pathfinder_content::gradient::{ColorStop, Gradient, GradientGeometry, GradientWrap};
+use pathfinder_content::outline::{Contour, Outline, PointFlags};
+use pathfinder_content::pattern::{Image, Pattern, PatternSource};
+use pathfinder_content::render_target::RenderTargetId;
+use pathfinder_geometry::line_segment::LineSegment2F;
+use pathfinder_geometry::rect::RectF;
+use pathfinder_geometry::transform2d::Transform2F;
+use pathfinder_geometry::vector::{Vector2F, vec2f, vec2i};
+use pathfinder_simd::default::F32x2;
+use std::io::{self, Write};
+use std::sync::Arc;
+
+/// The first four bytes of every scene snapshot.
+pub const SNAPSHOT_MAGIC: [u8; 4] = *b"PFSS";
+
+/// The version of the snapshot format this build reads and writes.
+pub const SNAPSHOT_VERSION: u32 = 1;
+
+const NO_CLIP: u32 = !0;
+
+/// Errors that can arise when writing or loading a scene snapshot.
+#[derive(Debug)]
+pub enum SnapshotError {
+    /// An I/O error occurred while writing.
+    Io(io::Error),
+    /// The data doesn't begin with the snapshot magic number.
+    BadMagic,
+    /// The snapshot was written by a version of the format this build doesn't understand.
+    UnsupportedVersion(u32),
+    /// The scene contains a paint that the snapshot format can't represent: a pattern backed by a
+    /// render target, or a pattern with a filter attached.
+    UnsupportedPaint,
+    /// The data ended prematurely or contains an invalid value.
+    Corrupt,
+}
+
+impl From<io::Error> for SnapshotError {
+    #[inline]
+    fn from(error: io::Error) -> SnapshotError {
+        SnapshotError::Io(error)
+    }
+}
+
+impl Scene {
+    /// Serializes this scene into the binary snapshot format.
+    ///
+    /// The snapshot captures everything needed to rebuild the scene: outlines, paints, render
+    /// target declarations, and the display list. Load it again with `Scene::from_snapshot()`.
+    pub fn write_snapshot<W>(&self, writer: &mut W) -> Result<(), SnapshotError> where W: Write {
+        let mut writer = SnapshotWriter { writer };
+        writer.write_bytes(&SNAPSHOT_MAGIC)?;
+        writer.write_u32(SNAPSHOT_VERSION)?;
+        writer.write_rect(self.view_box())?;
+
+        // Palette.
+        writer.write_u32(self.palette.paints.len() as u32)?;
+        for paint in &self.palette.paints {
+            writer.write_paint(paint)?;
+        }
+        writer.write_u32(self.palette.render_targets().len() as u32)?;
+        for render_target in self.palette.render_targets() {
+            writer.write_i32(render_target.size().x())?;
+            writer.write_i32(render_target.size().y())?;
+            writer.write_string(render_target.name())?;
+        }
+
+        // Clip paths.
+        writer.write_u32(self.clip_paths.len() as u32)?;
+        for clip_path in &self.clip_paths {
+            writer.write_outline(clip_path.outline())?;
+            writer.write_u32(clip_path.clip_path.map(|id| id.0).unwrap_or(NO_CLIP))?;
+            writer.write_u32(fill_rule_to_u32(clip_path.fill_rule))?;
+            writer.write_string(&clip_path.name)?;
+        }
+
+        // Draw paths.
+        writer.write_u32(self.draw_paths.len() as u32)?;
+        for draw_path in &self.draw_paths {
+            writer.write_outline(draw_path.outline())?;
+            writer.write_u32(draw_path.paint.0 as u32)?;
+            writer.write_u32(draw_path.clip_path.map(|id| id.0).unwrap_or(NO_CLIP))?;
+            writer.write_u32(fill_rule_to_u32(draw_path.fill_rule))?;
+            writer.write_u32(blend_mode_to_u32(draw_path.blend_mode))?;
+            match draw_path.symbol_key {
+                None => {
+                    writer.write_u32(0)?;
+                    writer.write_u64(0)?;
+                }
+                Some(symbol_key) => {
+                    writer.write_u32(1)?;
+                    writer.write_u64(symbol_key.0)?;
+                }
+            }
+            writer.write_string(&draw_path.name)?;
+        }
+
+        // Display list.
+        writer.write_u32(self.display_list.len() as u32)?;
+        for display_item in &self.display_list {
+            match *display_item {
+                DisplayItem::DrawPaths(ref range) => {
+                    writer.write_u32(0)?;
+                    writer.write_u32(range.start.0)?;
+                    writer.write_u32(range.end.0)?;
+                }
+                DisplayItem::PushRenderTarget(render_target_id) => {
+                    writer.write_u32(1)?;
+                    writer.write_u32(render_target_id.render_target)?;
+                }
+                DisplayItem::PopRenderTarget => writer.write_u32(2)?,
+            }
+        }
+
+        Ok(())
+    }
+
+    /// Loads a scene from snapshot data, such as the contents of a memory-mapped file.
+    ///
+    /// The returned scene receives a fresh scene ID; it is in every other respect identical to
+    /// the one that was written.
+    pub fn from_snapshot(data: &[u8]) -> Result<Scene, SnapshotError> {
+        let mut reader = SnapshotReader { data, position: 0 };
+        if reader.read_bytes(4)? != SNAPSHOT_MAGIC {
+            return Err(SnapshotError::BadMagic);
+        }
+        let version = reader.read_u32()?;
+        if version != SNAPSHOT_VERSION {
+            return Err(SnapshotError::UnsupportedVersion(version));
+        }
+
+        let mut scene = Scene::new();
+        let view_box = reader.read_rect()?;
+        scene.set_view_box(view_box);
+
+        // Palette.
+        let paint_count = reader.read_u32()? as usize;
+        for paint_index in 0..paint_count {
+            let paint = reader.read_paint()?;
+            let paint_id = scene.palette.push_paint(&paint);
+            debug_assert_eq!(paint_id, PaintId(paint_index as u16));
+        }
+        let render_target_count = reader.read_u32()? as usize;
+        for _ in 0..render_target_count {
+            let size = vec2i(reader.read_i32()?, reader.read_i32()?);
+            let name = reader.read_string()?;
+            scene.palette.push_render_target(RenderTarget::new(size, name));
+        }
+
+        // Clip paths.
+        let mut bounds = RectF::default();
+        let clip_path_count = reader.read_u32()? as usize;
+        for _ in 0..clip_path_count {
+            let outline = reader.read_outline()?;
+            bounds = bounds.union_rect(outline.bounds());
+            let mut clip_path = ClipPath::new(outline);
+            clip_path.set_clip_path(reader.read_clip_path_id(clip_path_count)?);
+            clip_path.set_fill_rule(fill_rule_from_u32(reader.read_u32()?)?);
+            clip_path.set_name(reader.read_string()?);
+            scene.clip_paths.push(clip_path);
+        }
+
+        // Draw paths.
+        let draw_path_count = reader.read_u32()? as usize;
+        for _ in 0..draw_path_count {
+            let outline = reader.read_outline()?;
+            bounds = bounds.union_rect(outline.bounds());
+            let paint_id = reader.read_u32()?;
+            if paint_id as usize >= paint_count {
+                return Err(SnapshotError::Corrupt);
+            }
+            let mut draw_path = DrawPath::new(outline, PaintId(paint_id as u16));
+            draw_path.set_clip_path(reader.read_clip_path_id(clip_path_count)?);
+            draw_path.set_fill_rule(fill_rule_from_u32(reader.read_u32()?)?);
+            draw_path.set_blend_mode(blend_mode_from_u32(reader.read_u32()?)?);
+            let has_symbol_key = reader.read_u32()? != 0;
+            let symbol_key = reader.read_u64()?;
+            if has_symbol_key {
+                draw_path.set_symbol_key(Some(SymbolRenderKey(symbol_key)));
+            }
+            draw_path.set_name(reader.read_string()?);
+            scene.draw_paths.push(draw_path);
+        }
+        scene.set_bounds(bounds);
+
+        // Display list.
+        let display_item_count = reader.read_u32()? as usize;
+        for _ in 0..display_item_count {
+            let display_item = match reader.read_u32()? {
+                0 => {
+                    let start = reader.read_u32()?;
+                    let end = reader.read_u32()?;
+                    if start > end || end as usize > draw_path_count {
+                        return Err(SnapshotError::Corrupt);
+                    }
+                    DisplayItem::DrawPaths(DrawPathId(start)..DrawPathId(end))
+                }
+                1 => {
+                    let render_target = reader.read_u32()?;
+                    if render_target as usize >= render_target_count {
+                        return Err(SnapshotError::Corrupt);
+                    }
+                    DisplayItem::PushRenderTarget(RenderTargetId {
+                        scene: scene.id().0,
+                        render_target,
+                    })
+                }
+                2 => DisplayItem::PopRenderTarget,
+                _ => return Err(SnapshotError::Corrupt),
+            };
+            scene.display_list.push(display_item);
+        }
+
+        Ok(scene)
+    }
+}
+
+struct SnapshotWriter<'a, W> where W: Write {
+    writer: &'a mut W,
+}
+
+impl<'a, W> SnapshotWriter<'a, W> where W: Write {
+    fn write_bytes(&mut self, bytes: &[u8]) -> Result<(), SnapshotError> {
+        self.writer.write_all(bytes)?;
+        Ok(())
+    }
+
+    fn write_u32(&mut self, value: u32) -> Result<(), SnapshotError> {
+        self.write_bytes(&value.to_le_bytes())
+    }
+
+    fn write_i32(&mut self, value: i32) -> Result<(), SnapshotError> {
+        self.write_bytes(&value.to_le_bytes())
+    }
+
+    fn write_u64(&mut self, value: u64) -> Result<(), SnapshotError> {
+        self.write_bytes(&value.to_le_bytes())
+    }
+
+    fn write_f32(&mut self, value: f32) -> Result<(), SnapshotError> {
+        self.write_bytes(&value.to_le_bytes())
+    }
+
+    fn write_vector(&mut self, value: Vector2F) -> Result<(), SnapshotError> {
+        self.write_f32(value.x())?;
+        self.write_f32(value.y())
+    }
+
+    fn write_rect(&mut self, value: RectF) -> Result<(), SnapshotError> {
+        self.write_vector(value.origin())?;
+        self.write_vector(value.size())
+    }
+
+    fn write_line_segment(&mut self, value: LineSegment2F) -> Result<(), SnapshotError> {
+        self.write_vector(value.from())?;
+        self.write_vector(value.to())
+    }
+
+    fn write_transform(&mut self, value: Transform2F) -> Result<(), SnapshotError> {
+        self.write_f32(value.m11())?;
+        self.write_f32(value.m12())?;
+        self.write_f32(value.m13())?;
+        self.write_f32(value.m21())?;
+        self.write_f32(value.m22())?;
+        self.write_f32(value.m23())
+    }
+
+    fn write_color(&mut self, color: ColorU) -> Result<(), SnapshotError> {
+        self.write_bytes(&[color.r, color.g, color.b, color.a])
+    }
+
+    // Writes a length-prefixed byte run, zero-padded so that the next field is 4-byte aligned.
+    fn write_padded_bytes(&mut self, bytes: &[u8]) -> Result<(), SnapshotError> {
+        self.write_u32(bytes.len() as u32)?;
+        self.write_bytes(bytes)?;
+        let padding = [0; 4];
+        self.write_bytes(&padding[0..padded_length(bytes.len()) - bytes.len()])
+    }
+
+    fn write_string(&mut self, string: &str) -> Result<(), SnapshotError> {
+        self.write_padded_bytes(string.as_bytes())
+    }
+
+    fn write_outline(&mut self, outline: &Outline) -> Result<(), SnapshotError> {
+        self.write_u32(outline.contours().len() as u32)?;
+        for contour in outline.contours() {
+            let point_count = contour.len();
+            self.write_u32(point_count)?;
+            self.write_u32(contour.is_closed() as u32)?;
+            for point_index in 0..point_count {
+                self.write_vector(contour.position_of(point_index))?;
+            }
+            let mut flag_bytes = Vec::with_capacity(padded_length(point_count as usize));
+            for point_index in 0..point_count {
+                flag_bytes.push(contour.flags_of(point_index).bits());
+            }
+            flag_bytes.resize(padded_length(point_count as usize), 0);
+            self.write_bytes(&flag_bytes)?;
+        }
+        Ok(())
+    }
+
+    fn write_paint(&mut self, paint: &Paint) -> Result<(), SnapshotError> {
+        self.write_color(paint.base_color())?;
+        let overlay = match *paint.overlay() {
+            None => return self.write_u32(0),
+            Some(ref overlay) => overlay,
+        };
+        self.write_u32(1)?;
+        self.write_u32(overlay.composite_op() as u32)?;
+        match *overlay.contents() {
+            PaintContents::Gradient(ref gradient) => {
+                self.write_u32(0)?;
+                self.write_gradient(gradient)
+            }
+            PaintContents::Pattern(ref pattern) => {
+                self.write_u32(1)?;
+                self.write_pattern(pattern)
+            }
+        }
+    }
+
+    fn write_gradient(&mut self, gradient: &Gradient) -> Result<(), SnapshotError> {
+        match gradient.geometry {
+            GradientGeometry::Linear(line) => {
+                self.write_u32(0)?;
+                self.write_line_segment(line)?;
+            }
+            GradientGeometry::Radial { line, radii, transform } => {
+                self.write_u32(1)?;
+                self.write_line_segment(line)?;
+                self.write_f32(radii.x())?;
+                self.write_f32(radii.y())?;
+                self.write_transform(transform)?;
+            }
+        }
+        self.write_u32(match gradient.wrap {
+            GradientWrap::Clamp => 0,
+            GradientWrap::Repeat => 1,
+        })?;
+        self.write_u32(gradient.stops().len() as u32)?;
+        for stop in gradient.stops() {
+            self.write_f32(stop.offset)?;
+            self.write_color(stop.color)?;
+        }
+        Ok(())
+    }
+
+    fn write_pattern(&mut self, pattern: &Pattern) -> Result<(), SnapshotError> {
+        if pattern.filter().is_some() {
+            return Err(SnapshotError::UnsupportedPaint);
+        }
+        let image = match *pattern.source() {
+            PatternSource::Image(ref image) => image,
+            // Render target and external texture contents live on the GPU, so we can't
+            // serialize them.
+            PatternSource::RenderTarget { .. } |
+            PatternSource::ExternalTexture { .. } => return Err(SnapshotError::UnsupportedPaint),
+        };
+
+        self.write_i32(image.size().x())?;
+        self.write_i32(image.size().y())?;
+        for color in image.pixels().iter() {
+            self.write_color(*color)?;
+        }
+
+        self.write_transform(pattern.transform())?;
+        let mut flags = 0;
+        if pattern.repeat_x() {
+            flags |= 1;
+        }
+        if pattern.repeat_y() {
+            flags |= 2;
+        }
+        if pattern.smoothing_enabled() {
+            flags |= 4;
+        }
+        self.write_u32(flags)
+    }
+}
+
+struct SnapshotReader<'a> {
+    data: &'a [u8],
+    position: usize,
+}
+
+impl<'a> SnapshotReader<'a> {
+    fn read_bytes(&mut self, len: usize) -> Result<&'a [u8], SnapshotError> {
+        if len > self.data.len() - self.position {
+            return Err(SnapshotError::Corrupt);
+        }
+        let bytes = &self.data[self.position..self.position + len];
+        self.position += len;
+        Ok(bytes)
+    }
+
+    fn read_u32(&mut self) -> Result<u32, SnapshotError> {
+        let bytes = self.read_bytes(4)?;
+        Ok(u32::from_le_bytes([bytes[0], bytes[1], bytes[2], bytes[3]]))
+    }
+
+    fn read_i32(&mut self) -> Result<i32, SnapshotError> {
+        Ok(self.read_u32()? as i32)
+    }
+
+    fn read_u64(&mut self) -> Result<u64, SnapshotError> {
+        let lo = self.read_u32()? as u64;
+        let hi = self.read_u32()? as u64;
+        Ok(lo | (hi << 32))
+    }
+
+    fn read_f32(&mut self) -> Result<f32, SnapshotError> {
+        Ok(f32::from_bits(self.read_u32()?))
+    }
+
+    fn read_vector(&mut self) -> Result<Vector2F, SnapshotError> {
+        Ok(vec2f(self.read_f32()?, self.read_f32()?))
+    }
+
+    fn read_rect(&mut self) -> Result<RectF, SnapshotError> {
+        Ok(RectF::new(self.read_vector()?, self.read_vector()?))
+    }
+
+    fn read_line_segment(&mut self) -> Result<LineSegment2F, SnapshotError> {
+        Ok(LineSegment2F::new(self.read_vector()?, self.read_vector()?))
+    }
+
+    fn read_transform(&mut self) -> Result<Transform2F, SnapshotError> {
+        let (m11, m12, m13) = (self.read_f32()?, self.read_f32()?, self.read_f32()?);
+        let (m21, m22, m23) = (self.read_f32()?, self.read_f32()?, self.read_f32()?);
+        Ok(Transform2F::row_major(m11, m12, m13, m21, m22, m23))
+    }
+
+    fn read_color(&mut self) -> Result<ColorU, SnapshotError> {
+        let bytes = self.read_bytes(4)?;
+        Ok(ColorU { r: bytes[0], g: bytes[1], b: bytes[2], a: bytes[3] })
+    }
+
+    fn read_padded_bytes(&mut self) -> Result<&'a [u8], SnapshotError> {
+        let len = self.read_u32()? as usize;
+        let bytes = self.read_bytes(padded_length(len))?;
+        Ok(&bytes[0..len])
+    }
+
+    fn read_string(&mut self) -> Result<String, SnapshotError> {
+        let bytes = self.read_padded_bytes()?;
+        String::from_utf8(bytes.to_vec()).map_err(|_| SnapshotError::Corrupt)
+    }
+
+    fn read_clip_path_id(&mut self, clip_path_count: usize)
+                         -> Result<Option<ClipPathId>, SnapshotError> {
+        match self.read_u32()? {
+            NO_CLIP => Ok(None),
+            id if (id as usize) < clip_path_count => Ok(Some(ClipPathId(id))),
+            _ => Err(SnapshotError::Corrupt),
+        }
+    }
+
+    fn read_outline(&mut self) -> Result<Outline, SnapshotError> {
+        let contour_count = self.read_u32()? as usize;
+        let mut outline = Outline::with_capacity(contour_count);
+        for _ in 0..contour_count {
+            let point_count = self.read_u32()? as usize;
+            let closed = self.read_u32()? != 0;
+
+            let point_bytes = self.read_bytes(point_count * 8)?;
+            let mut points = Vec::with_capacity(point_count);
+            for point in point_bytes.chunks_exact(8) {
+                let x = f32::from_le_bytes([point[0], point[1], point[2], point[3]]);
+                let y = f32::from_le_bytes([point[4], point[5], point[6], point[7]]);
+                if x.is_nan() || y.is_nan() {
+                    return Err(SnapshotError::Corrupt);
+                }
+                points.push(vec2f(x, y));
+            }
+
+            let flag_bytes = self.read_bytes(padded_length(point_count))?;
+            let flags: Vec<PointFlags> = flag_bytes[0..point_count]
+                .iter()
+                .map(|&bits| PointFlags::from_bits_truncate(bits))
+                .collect();
+
+            let mut contour = Contour::with_capacity(point_count);
+            contour.push_points(&points, &flags);
+            if closed {
+                contour.close();
+            }
+            outline.push_contour(contour);
+        }
+        Ok(outline)
+    }
+
+    fn read_paint(&mut self) -> Result<Paint, SnapshotError> {
+        let base_color = self.read_color()?;
+        if self.read_u32()? == 0 {
+            return Ok(Paint::from_color(base_color));
+        }
+
+        let composite_op = self.read_u32()?;
+        let mut paint = match self.read_u32()? {
+            0 => Paint::from_gradient(self.read_gradient()?),
+            1 => Paint::from_pattern(self.read_pattern()?),
+            _ => return Err(SnapshotError::Corrupt),
+        };
+        paint.set_base_color(base_color);
+
+        let overlay = paint.overlay_mut().as_mut().expect("Paint should have an overlay!");
+        match composite_op {
+            0 => overlay.set_composite_op(PaintCompositeOp::SrcIn),
+            1 => overlay.set_composite_op(PaintCompositeOp::DestIn),
+            _ => return Err(SnapshotError::Corrupt),
+        }
+        Ok(paint)
+    }
+
+    fn read_gradient(&mut self) -> Result<Gradient, SnapshotError> {
+        let mut gradient = match self.read_u32()? {
+            0 => Gradient::linear(self.read_line_segment()?),
+            1 => {
+                let line = self.read_line_segment()?;
+                let radii = F32x2::new(self.read_f32()?, self.read_f32()?);
+                let transform = self.read_transform()?;
+                let mut gradient = Gradient::radial(line, radii);
+                if let GradientGeometry::Radial { transform: ref mut dest, .. } =
+                        gradient.geometry {
+                    *dest = transform;
+                }
+                gradient
+            }
+            _ => return Err(SnapshotError::Corrupt),
+        };
+        gradient.wrap = match self.read_u32()? {
+            0 => GradientWrap::Clamp,
+            1 => GradientWrap::Repeat,
+            _ => return Err(SnapshotError::Corrupt),
+        };
+        let stop_count = self.read_u32()? as usize;
+        for _ in 0..stop_count {
+            let offset = self.read_f32()?;
+            let color = self.read_color()?;
+            gradient.add(ColorStop::new(color, offset));
+        }
+        Ok(gradient)
+    }
+
+    fn read_pattern(&mut self) -> Result<Pattern, SnapshotError> {
+        let size = vec2i(self.read_i32()?, self.read_i32()?);
+        if size.x() < 0 || size.y() < 0 {
+            return Err(SnapshotError::Corrupt);
+        }
+        let pixel_count = size.x() as usize * size.y() as usize;
+        let pixel_bytes = self.read_bytes(pixel_count * 4)?;
+        let mut pixels = Vec::with_capacity(pixel_count);
+        for pixel in pixel_bytes.chunks_exact(4) {
+            pixels.push(ColorU { r: pixel[0], g: pixel[1], b: pixel[2], a: pixel[3] });
+        }
+
+        let transform = self.read_transform()?;
+        let flags = self.read_u32()?;
+
+        let mut pattern = Pattern::from_image(Image::new(size, Arc::new(pixels)));
+        pattern.apply_transform(transform);
+        pattern.set_repeat_x(flags & 1 != 0);
+        pattern.set_repeat_y(flags & 2 != 0);
+        pattern.set_smoothing_enabled(flags & 4 != 0);
+        Ok(pattern)
+    }
+}
+
+// Rounds a byte length up to the next multiple of 4, so that following fields stay aligned.
+fn padded_length(len: usize) -> usize {
+    (len + 3) & !3
+}
+
+fn fill_rule_to_u32(fill_rule: FillRule) -> u32 {
+    match fill_rule {
+        FillRule::Winding => 0,
+        FillRule::EvenOdd => 1,
+    }
+}
+
+fn fill_rule_from_u32(value: u32) -> Result<FillRule, SnapshotError> {
+    match value {
+        0 => Ok(FillRule::Winding),
+        1 => Ok(FillRule::EvenOdd),
+        _ => Err(SnapshotError::Corrupt),
+    }
+}
+
+// The mapping here is part of the format and must not change, so don't be tempted to replace it
+// with a cast of the Rust enum discriminant.
+fn blend_mode_to_u32(blend_mode: BlendMode) -> u32 {
+    match blend_mode {
+        BlendMode::Clear => 0,
+        BlendMode::Copy => 1,
+        BlendMode::SrcIn => 2,
+        BlendMode::SrcOut => 3,
+        BlendMode::SrcOver => 4,
+        BlendMode::SrcAtop => 5,
+        BlendMode::DestIn => 6,
+        BlendMode::DestOut => 7,
+        BlendMode::DestOver => 8,
+        BlendMode::DestAtop => 9,
+        BlendMode::Xor => 10,
+        BlendMode::Lighter => 11,
+        BlendMode::Darken => 12,
+        BlendMode::Lighten => 13,
+        BlendMode::Multiply => 14,
+        BlendMode::Screen => 15,
+        BlendMode::HardLight => 16,
+        BlendMode::Overlay => 17,
+        BlendMode::ColorDodge => 18,
+        BlendMode::ColorBurn => 19,
+        BlendMode::SoftLight => 20,
+        BlendMode::Difference => 21,
+        BlendMode::Exclusion => 22,
+        BlendMode::Hue => 23,
+        BlendMode::Saturation => 24,
+        BlendMode::Color => 25,
+        BlendMode::Luminosity => 26,
+    }
+}
+
+fn blend_mode_from_u32(value: u32) -> Result<BlendMode, SnapshotError> {
+    Ok(match value {
+        0 => BlendMode::Clear,
+        1 => BlendMode::Copy,
+        2 => BlendMode::SrcIn,
+        3 => BlendMode::SrcOut,
+        4 => BlendMode::SrcOver,
+        5 => BlendMode::SrcAtop,
+        6 => BlendMode::DestIn,
+        7 => BlendMode::DestOut,
+        8 => BlendMode::DestOver,
+        9 => BlendMode::DestAtop,
+        10 => BlendMode::Xor,
+        11 => BlendMode::Lighter,
+        12 => BlendMode::Darken,
+        13 => BlendMode::Lighten,
+        14 => BlendMode::Multiply,
+        15 => BlendMode::Screen,
+        16 => BlendMode::HardLight,
+        17 => BlendMode::Overlay,
+        18 => BlendMode::ColorDodge,
+        19 => BlendMode::ColorBurn,
+        20 => BlendMode::SoftLight,
+        21 => BlendMode::Difference,
+        22 => BlendMode::Exclusion,
+        23 => BlendMode::Hue,
+        24 => BlendMode::Saturation,
+        25 => BlendMode::Color,
+        26 => BlendMode::Luminosity,
+        _ => return Err(SnapshotError::Corrupt),
+    })
+}
+
+#[cfg(test)]
+mod test {
+    use crate::paint::Paint;
+    use crate::scene::{ClipPath, DrawPath, Scene};
+    use pathfinder_color::ColorU;
+    use pathfinder_content::fill::FillRule;
+    use pathfinder_content::outline::Outline;
+    use pathfinder_geometry::rect::RectF;
+    use pathfinder_geometry::vector::vec2f;
+
+    use super::{NO_CLIP, SnapshotError};
+
+    fn test_scene() -> Scene {
+        let mut scene = Scene::new();
+        scene.set_view_box(RectF::new(vec2f(0.0, 0.0), vec2f(200.0, 100.0)));
+        let paint_id = scene.push_paint(&Paint::from_color(ColorU::new(255, 0, 0, 255)));
+
+        let mut clip_path =
+            ClipPath::new(Outline::from_rect(RectF::new(vec2f(10.0, 10.0), vec2f(50.0, 50.0))));
+        clip_path.set_fill_rule(FillRule::EvenOdd);
+        let clip_path_id = scene.push_clip_path(clip_path);
+
+        let mut draw_path =
+            DrawPath::new(Outline::from_rect(RectF::new(vec2f(0.0, 0.0), vec2f(100.0, 100.0))),
+                          paint_id);
+        draw_path.set_clip_path(Some(clip_path_id));
+        scene.push_draw_path(draw_path);
+
+        let draw_path =
+            DrawPath::new(Outline::from_rect(RectF::new(vec2f(100.0, 0.0), vec2f(100.0, 100.0))),
+                          paint_id);
+        scene.push_draw_path(draw_path);
+
+        scene
+    }
+
+    fn snapshot(scene: &Scene) -> Vec<u8> {
+        let mut data = vec![];
+        scene.write_snapshot(&mut data).unwrap();
+        data
+    }
+
+    #[test]
+    fn test_round_trip() {
+        let scene = test_scene();
+        let copy = Scene::from_snapshot(&snapshot(&scene)).unwrap();
+        assert_eq!(copy.view_box(), scene.view_box());
+        assert_eq!(copy.bounds(), scene.bounds());
+        // The scene ID aside, the copy must be indistinguishable from the original, so
+        // re-snapshotting it must reproduce the snapshot byte for byte.
+        assert_eq!(snapshot(&copy), snapshot(&scene));
+    }
+
+    #[test]
+    fn test_truncation() {
+        let data = snapshot(&test_scene());
+        for len in 0..data.len() {
+            assert!(Scene::from_snapshot(&data[0..len]).is_err());
+        }
+    }
+
+    #[test]
+    fn test_bad_draw_path_clip_id() {
+        let mut data = snapshot(&test_scene());
+        // The last draw path's clip reference is followed by its fill rule, blend mode, symbol
+        // key flag and value, and empty name, and then by the single-item display list.
+        let offset = data.len() - 44;
+        assert_eq!(&data[offset..offset + 4], &NO_CLIP.to_le_bytes());
+
+        // The scene has one clip path, so 1 is the first out-of-range reference.
+        data[offset..offset + 4].copy_from_slice(&1u32.to_le_bytes());
+        match Scene::from_snapshot(&data) {
+            Err(SnapshotError::Corrupt) => {}
+            result => panic!("Unexpected result: {:?}", result.map(|_| ())),
+        }
+
+        // An in-range reference in the same spot is accepted.
+        data[offset..offset + 4].copy_from_slice(&0u32.to_le_bytes());
+        assert!(Scene::from_snapshot(&data).is_ok());
+    }
+
+    #[test]
+    fn test_bad_nested_clip_path_id() {
+        let mut scene = Scene::new();
+        scene.push_clip_path(ClipPath::new(Outline::new()));
+        let mut data = snapshot(&scene);
+
+        // The header (24 bytes), empty palette (8), clip path count (4), and the empty outline's
+        // contour count (4) put the clip path's own clip reference at offset 40.
+        assert_eq!(&data[40..44], &NO_CLIP.to_le_bytes());
+        data[40..44].copy_from_slice(&1u32.to_le_bytes());
+        match Scene::from_snapshot(&data) {
+            Err(SnapshotError::Corrupt) => {}
+            result => panic!("Unexpected result: {:?}", result.map(|_| ())),
+        }
+    }
+}
@@ -11,6 +11,228 @@
 use pathfinder_geometry::rect::RectI;
 use pathfinder_geometry::vector::{Vector2I, vec2i};
 
+/// The length in tiles of one side of a sparse tile map chunk.
+pub const SPARSE_CHUNK_LENGTH: i32 = 16;
+
+const SPARSE_CHUNK_AREA: usize = (SPARSE_CHUNK_LENGTH * SPARSE_CHUNK_LENGTH) as usize;
+
+/// An entry that can populate a tile map from a coordinate-independent template.
+pub trait TileMapEntry: Clone + Copy {
+    /// Returns a copy of this template entry rebased at the given tile coordinates.
+    fn at_coords(&self, coords: Vector2I) -> Self;
+}
+
+/// Per-path tile storage: either a dense array over the whole tile rect or a sparse two-level
+/// index that only materializes the chunks a path actually touches.
+#[derive(Clone, Debug)]
+pub enum TileMap<T> where T: TileMapEntry {
+    Dense(DenseTileMap<T>),
+    Sparse(SparseTileMap<T>),
+}
+
+impl<T> TileMap<T> where T: TileMapEntry {
+    #[inline]
+    pub fn rect(&self) -> RectI {
+        match *self {
+            TileMap::Dense(ref map) => map.rect,
+            TileMap::Sparse(ref map) => map.rect,
+        }
+    }
+
+    /// Moves the tile rect by a whole number of tiles. The entries themselves are not rewritten;
+    /// callers that store tile coordinates in the entries must update them separately.
+    #[inline]
+    pub fn translate(&mut self, delta: Vector2I) {
+        match *self {
+            TileMap::Dense(ref mut map) => {
+                map.rect = RectI::new(map.rect.origin() + delta, map.rect.size())
+            }
+            TileMap::Sparse(ref mut map) => {
+                map.rect = RectI::new(map.rect.origin() + delta, map.rect.size())
+            }
+        }
+    }
+
+    /// Returns the tile at the given coordinates, if it's in bounds and has been materialized.
+    #[inline]
+    pub fn get(&self, coords: Vector2I) -> Option<&T> {
+        match *self {
+            TileMap::Dense(ref map) => map.get(coords),
+            TileMap::Sparse(ref map) => map.get(coords),
+        }
+    }
+
+    /// Returns the tile at the given coordinates for writing, materializing its chunk if
+    /// necessary. Returns `None` only if the coordinates are out of bounds.
+    #[inline]
+    pub fn get_mut(&mut self, coords: Vector2I) -> Option<&mut T> {
+        match *self {
+            TileMap::Dense(ref mut map) => map.get_mut(coords),
+            TileMap::Sparse(ref mut map) => map.get_mut(coords),
+        }
+    }
+
+    /// Calls `f` on every tile in storage: all tiles of a dense map, or the tiles of every
+    /// materialized chunk of a sparse one.
+    pub fn for_each<F>(&self, mut f: F) where F: FnMut(&T) {
+        match *self {
+            TileMap::Dense(ref map) => {
+                for tile in &map.data {
+                    f(tile)
+                }
+            }
+            TileMap::Sparse(ref map) => {
+                for chunk in &map.chunks {
+                    if let Some(ref chunk) = *chunk {
+                        for tile in chunk.iter() {
+                            f(tile)
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /// The mutable counterpart of `for_each`.
+    pub fn for_each_mut<F>(&mut self, mut f: F) where F: FnMut(&mut T) {
+        match *self {
+            TileMap::Dense(ref mut map) => {
+                for tile in &mut map.data {
+                    f(tile)
+                }
+            }
+            TileMap::Sparse(ref mut map) => {
+                for chunk in &mut map.chunks {
+                    if let Some(ref mut chunk) = *chunk {
+                        for tile in chunk.iter_mut() {
+                            f(tile)
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/// A two-level tile map: a coarse grid of chunk pointers, with each chunk holding
+/// `SPARSE_CHUNK_LENGTH` × `SPARSE_CHUNK_LENGTH` tiles, materialized on first write.
+///
+/// Paths with large tile rects but little coverage (long thin strokes, diagonals) only pay for
+/// the chunks they touch. Chunks are full-sized even at the edges of the rect; the overhanging
+/// entries stay at their template defaults and are never returned by bounds-checked accessors.
+#[derive(Clone, Debug)]
+pub struct SparseTileMap<T> where T: TileMapEntry {
+    chunks: Vec<Option<Box<[T]>>>,
+    template: T,
+    chunks_across: i32,
+    chunks_down: i32,
+    pub rect: RectI,
+}
+
+impl<T> SparseTileMap<T> where T: TileMapEntry {
+    pub fn new(template: T, rect: RectI) -> SparseTileMap<T> {
+        let chunks_across = (rect.width() + SPARSE_CHUNK_LENGTH - 1) / SPARSE_CHUNK_LENGTH;
+        let chunks_down = (rect.height() + SPARSE_CHUNK_LENGTH - 1) / SPARSE_CHUNK_LENGTH;
+        SparseTileMap {
+            chunks: vec![None; chunks_across as usize * chunks_down as usize],
+            template,
+            chunks_across,
+            chunks_down,
+            rect,
+        }
+    }
+
+    #[inline]
+    pub fn chunks_across(&self) -> i32 {
+        self.chunks_across
+    }
+
+    #[inline]
+    pub fn chunks_down(&self) -> i32 {
+        self.chunks_down
+    }
+
+    /// Returns the size in tiles of the given chunk, clipped to the tile rect.
+    #[inline]
+    pub fn chunk_tile_size(&self, chunk_coords: Vector2I) -> Vector2I {
+        vec2i((self.rect.width() - chunk_coords.x() * SPARSE_CHUNK_LENGTH)
+                  .min(SPARSE_CHUNK_LENGTH),
+              (self.rect.height() - chunk_coords.y() * SPARSE_CHUNK_LENGTH)
+                  .min(SPARSE_CHUNK_LENGTH))
+    }
+
+    #[inline]
+    pub fn chunk_is_present(&self, chunk_coords: Vector2I) -> bool {
+        self.chunks[self.chunk_coords_to_index(chunk_coords)].is_some()
+    }
+
+    /// Returns the tiles of the given chunk, materializing it if necessary. Tiles within a chunk
+    /// are stored row-major, `SPARSE_CHUNK_LENGTH` to a row.
+    #[inline]
+    pub fn chunk_mut(&mut self, chunk_coords: Vector2I) -> &mut [T] {
+        let chunk_index = self.chunk_coords_to_index(chunk_coords);
+        if self.chunks[chunk_index].is_none() {
+            self.materialize_chunk(chunk_index);
+        }
+        &mut **self.chunks[chunk_index].as_mut().unwrap()
+    }
+
+    #[inline]
+    pub fn get(&self, coords: Vector2I) -> Option<&T> {
+        if !self.rect.contains_point(coords) {
+            return None;
+        }
+        match self.chunks[self.coords_to_chunk_index(coords)] {
+            Some(ref chunk) => Some(&chunk[self.coords_to_index_in_chunk(coords)]),
+            None => None,
+        }
+    }
+
+    #[inline]
+    pub fn get_mut(&mut self, coords: Vector2I) -> Option<&mut T> {
+        if !self.rect.contains_point(coords) {
+            return None;
+        }
+        let chunk_index = self.coords_to_chunk_index(coords);
+        if self.chunks[chunk_index].is_none() {
+            self.materialize_chunk(chunk_index);
+        }
+        let index_in_chunk = self.coords_to_index_in_chunk(coords);
+        Some(&mut self.chunks[chunk_index].as_mut().unwrap()[index_in_chunk])
+    }
+
+    #[inline]
+    fn chunk_coords_to_index(&self, chunk_coords: Vector2I) -> usize {
+        (chunk_coords.y() * self.chunks_across + chunk_coords.x()) as usize
+    }
+
+    #[inline]
+    fn coords_to_chunk_index(&self, coords: Vector2I) -> usize {
+        let offset = coords - self.rect.origin();
+        self.chunk_coords_to_index(vec2i(offset.x() / SPARSE_CHUNK_LENGTH,
+                                         offset.y() / SPARSE_CHUNK_LENGTH))
+    }
+
+    #[inline]
+    fn coords_to_index_in_chunk(&self, coords: Vector2I) -> usize {
+        let offset = coords - self.rect.origin();
+        (offset.y() % SPARSE_CHUNK_LENGTH * SPARSE_CHUNK_LENGTH +
+            offset.x() % SPARSE_CHUNK_LENGTH) as usize
+    }
+
+    fn materialize_chunk(&mut self, chunk_index: usize) {
+        let chunk_coords = vec2i(chunk_index as i32 % self.chunks_across,
+                                 chunk_index as i32 / self.chunks_across);
+        let chunk_origin = self.rect.origin() + chunk_coords * SPARSE_CHUNK_LENGTH;
+        let template = self.template;
+        let chunk: Vec<T> = (0..SPARSE_CHUNK_AREA as i32).map(|index| {
+            template.at_coords(chunk_origin + vec2i(index % SPARSE_CHUNK_LENGTH,
+                                                    index / SPARSE_CHUNK_LENGTH))
+        }).collect();
+        self.chunks[chunk_index] = Some(chunk.into_boxed_slice());
+    }
+}
+
 #[derive(Clone, Debug)]
 pub struct DenseTileMap<T> where T: Clone + Copy {
     pub data: Vec<T>,
@@ -12,11 +12,14 @@
 //! of General Vector Graphics" 2006.
 
 use crate::builder::{BuiltPath, BuiltPathBinCPUData, BuiltPathData, ObjectBuilder, SceneBuilder};
+use crate::concurrent::executor::Executor;
 use crate::gpu::options::RendererLevel;
-use crate::gpu_data::AlphaTileId;
+use crate::gpu_data::{AlphaTileId, Clip, TileObjectPrimitive};
 use crate::options::PrepareMode;
 use crate::scene::{ClipPathId, PathId};
+use crate::tile_map::{DenseTileMap, SPARSE_CHUNK_LENGTH, TileMap};
 use crate::tiles::{TILE_HEIGHT, TILE_WIDTH, TilingPathInfo};
+use instant::Instant;
 use pathfinder_content::clip;
 use pathfinder_content::fill::FillRule;
 use pathfinder_content::outline::{ContourIterFlags, Outline};
@@ -29,6 +32,12 @@ use std::f32::NEG_INFINITY;
 
 const FLATTENING_TOLERANCE: f32 = 0.25;
 
+/// Paths with at least this many segments have their fills generated in parallel.
+const PARALLEL_FILL_SEGMENT_THRESHOLD: usize = 4096;
+
+/// The number of segments that each parallel fill worker processes at a time.
+const PARALLEL_FILL_CHUNK_SIZE: usize = 1024;
+
 pub(crate) struct Tiler<'a, 'b, 'c, 'd> {
     scene_builder: &'a SceneBuilder<'b, 'a, 'c, 'd>,
     pub(crate) object_builder: ObjectBuilder,
@@ -65,11 +74,19 @@ impl<'a, 'b, 'c, 'd> Tiler<'a, 'b, 'c, 'd> {
         Tiler { scene_builder, object_builder, outline, clip_path }
     }
 
-    pub(crate) fn generate_tiles(&mut self) {
+    pub(crate) fn generate_tiles<E>(&mut self, executor: &E) where E: Executor {
         match self.object_builder.built_path.data {
             BuiltPathData::CPU(_) => {
-                self.generate_fills();
+                let fill_start_time = Instant::now();
+                self.generate_fills(executor);
+                let tile_prepare_start_time = Instant::now();
+                self.scene_builder
+                    .build_time_counters
+                    .add_fill_time(tile_prepare_start_time - fill_start_time);
                 self.prepare_tiles();
+                self.scene_builder
+                    .build_time_counters
+                    .add_tile_prepare_time(tile_prepare_start_time.elapsed());
             }
             BuiltPathData::TransformCPUBinGPU(ref mut data) => {
                 data.outline = (*self.outline).clone();
@@ -80,9 +97,18 @@ impl<'a, 'b, 'c, 'd> Tiler<'a, 'b, 'c, 'd> {
         }
     }
 
-    fn generate_fills(&mut self) {
+    fn generate_fills<E>(&mut self, executor: &E) where E: Executor {
         debug_assert_eq!(self.scene_builder.sink.renderer_level, RendererLevel::D3D9);
 
+        let segment_count: usize = self.outline
+                                       .contours()
+                                       .iter()
+                                       .map(|contour| contour.len() as usize)
+                                       .sum();
+        if segment_count >= PARALLEL_FILL_SEGMENT_THRESHOLD {
+            return self.generate_fills_in_parallel(executor);
+        }
+
         for contour in self.outline.contours() {
             for segment in contour.iter(ContourIterFlags::empty()) {
                 process_segment(&segment, self.scene_builder, &mut self.object_builder);
@@ -90,6 +116,61 @@ impl<'a, 'b, 'c, 'd> Tiler<'a, 'b, 'c, 'd> {
         }
     }
 
+    // Splits the segments of a large path into fixed-size chunks, walks the tile lattice for each
+    // chunk in parallel into per-worker fill buffers, and then replays the buffers into the object
+    // builder. Fills and backdrop deltas are additive, so the order in which the chunks land
+    // doesn't affect the rendered result.
+    fn generate_fills_in_parallel<E>(&mut self, executor: &E) where E: Executor {
+        let segments: Vec<Segment> =
+            self.outline
+                .contours()
+                .iter()
+                .flat_map(|contour| contour.iter(ContourIterFlags::empty()))
+                .collect();
+
+        let scene_builder = self.scene_builder;
+        let chunk_count = (segments.len() + PARALLEL_FILL_CHUNK_SIZE - 1) /
+            PARALLEL_FILL_CHUNK_SIZE;
+        let fill_buffers = executor.build_vector(chunk_count, |chunk_index| {
+            let chunk_start = chunk_index * PARALLEL_FILL_CHUNK_SIZE;
+            let chunk_end = (chunk_start + PARALLEL_FILL_CHUNK_SIZE).min(segments.len());
+            let mut fill_buffer = vec![];
+            for segment in &segments[chunk_start..chunk_end] {
+                process_segment(segment, scene_builder, &mut fill_buffer);
+            }
+            fill_buffer
+        });
+
+        for fill_buffer in fill_buffers {
+            // Consume buffered fills two at a time, so that the fixed-point conversion runs eight
+            // lanes wide. Backdrop adjustments land in separate arrays, so fills can be paired up
+            // across them freely.
+            let mut pending_fill = None;
+            for buffered_fill in fill_buffer {
+                match buffered_fill {
+                    BufferedFill::Fill { segment, tile_coords } => {
+                        match pending_fill.take() {
+                            None => pending_fill = Some((segment, tile_coords)),
+                            Some((pending_segment, pending_tile_coords)) => {
+                                self.object_builder.add_fill_pair(scene_builder,
+                                                                  pending_segment,
+                                                                  pending_tile_coords,
+                                                                  segment,
+                                                                  tile_coords)
+                            }
+                        }
+                    }
+                    BufferedFill::Backdrop { tile_coords, delta } => {
+                        self.object_builder.adjust_alpha_tile_backdrop(tile_coords, delta)
+                    }
+                }
+            }
+            if let Some((segment, tile_coords)) = pending_fill {
+                self.object_builder.add_fill(scene_builder, segment, tile_coords);
+            }
+        }
+    }
+
     fn prepare_tiles(&mut self) {
         // Don't do this here if the GPU will do it.
         let (backdrops, tiles, clips) = match self.object_builder.built_path.data {
@@ -102,85 +183,197 @@ impl<'a, 'b, 'c, 'd> Tiler<'a, 'b, 'c, 'd> {
         };
 
         // Propagate backdrops.
-        let tiles_across = tiles.rect.width() as usize;
-        for (draw_tile_index, draw_tile) in tiles.data.iter_mut().enumerate() {
-            let tile_coords = vec2i(draw_tile.tile_x as i32, draw_tile.tile_y as i32);
-            let column = draw_tile_index % tiles_across;
-            let delta = draw_tile.backdrop as i32;
-
-            let mut draw_alpha_tile_id = draw_tile.alpha_tile_id;
-            let mut draw_tile_backdrop = backdrops[column] as i8;
-
-            if let Some(built_clip_path) = self.clip_path {
-                let clip_tiles = match built_clip_path.data {
-                    BuiltPathData::CPU(BuiltPathBinCPUData { ref tiles, .. }) => tiles,
-                    _ => unreachable!(),
-                };
-                match clip_tiles.get(tile_coords) {
-                    Some(clip_tile) => {
-                        if clip_tile.alpha_tile_id != AlphaTileId(!0) &&
-                                draw_alpha_tile_id != AlphaTileId(!0) {
-                            // Hard case: We have an alpha tile and a clip tile with masks. Add a
-                            // job to combine the two masks. Because the mask combining step
-                            // applies the backdrops, zero out the backdrop in the draw tile itself
-                            // so that we don't double-count it.
-                            let clip = clips.as_mut()
-                                            .expect("Where are the clips?")
-                                            .get_mut(tile_coords)
-                                            .unwrap();
-                            clip.dest_tile_id = draw_tile.alpha_tile_id;
-                            clip.dest_backdrop = draw_tile_backdrop as i32;
-                            clip.src_tile_id = clip_tile.alpha_tile_id;
-                            clip.src_backdrop = clip_tile.backdrop as i32;
-                            draw_tile_backdrop = 0;
-                        } else if clip_tile.alpha_tile_id != AlphaTileId(!0) &&
-                                draw_alpha_tile_id == AlphaTileId(!0) &&
-                                draw_tile_backdrop != 0 {
-                            // This is a solid draw tile, but there's a clip applied. Replace it
-                            // with an alpha tile pointing directly to the clip mask.
-                            draw_alpha_tile_id = clip_tile.alpha_tile_id;
-                            draw_tile_backdrop = clip_tile.backdrop;
-                        } else if clip_tile.alpha_tile_id == AlphaTileId(!0) &&
-                                clip_tile.backdrop == 0 {
-                            // This is a blank clip tile. Cull the draw tile entirely.
-                            draw_alpha_tile_id = AlphaTileId(!0);
-                            draw_tile_backdrop = 0;
+        match *tiles {
+            TileMap::Dense(ref mut tiles) => {
+                let tiles_across = tiles.rect.width() as usize;
+                for (draw_tile_index, draw_tile) in tiles.data.iter_mut().enumerate() {
+                    let column = draw_tile_index % tiles_across;
+                    let delta =
+                        prepare_draw_tile(draw_tile, backdrops[column] as i8, self.clip_path,
+                                          clips);
+                    backdrops[column] += delta;
+                }
+            }
+            TileMap::Sparse(ref mut tiles) => {
+                // Backdrop propagation is independent per column, so the chunks can be visited
+                // band by band as long as each column is still walked top to bottom. Before a
+                // band is processed, any absent chunk whose columns carry a nonzero backdrop must
+                // be materialized: its tiles lie in the interior of the path and have to be
+                // emitted as solid tiles.
+                for chunk_y in 0..tiles.chunks_down() {
+                    for chunk_x in 0..tiles.chunks_across() {
+                        let chunk_coords = vec2i(chunk_x, chunk_y);
+                        if tiles.chunk_is_present(chunk_coords) {
+                            continue;
+                        }
+                        let first_column = (chunk_x * SPARSE_CHUNK_LENGTH) as usize;
+                        let column_count = tiles.chunk_tile_size(chunk_coords).x() as usize;
+                        if backdrops[first_column..first_column + column_count]
+                                .iter()
+                                .any(|&backdrop| backdrop != 0) {
+                            tiles.chunk_mut(chunk_coords);
                         }
                     }
-                    None => {
-                        // This draw tile is outside the clip path rect. Cull the tile.
-                        draw_alpha_tile_id = AlphaTileId(!0);
-                        draw_tile_backdrop = 0;
+
+                    // Within a band, a column only accumulates deltas from its own chunk, so the
+                    // present chunks of the band can be processed one after another.
+                    for chunk_x in 0..tiles.chunks_across() {
+                        let chunk_coords = vec2i(chunk_x, chunk_y);
+                        if !tiles.chunk_is_present(chunk_coords) {
+                            continue;
+                        }
+                        let chunk_tile_size = tiles.chunk_tile_size(chunk_coords);
+                        let chunk = tiles.chunk_mut(chunk_coords);
+                        for row in 0..chunk_tile_size.y() {
+                            for column_in_chunk in 0..chunk_tile_size.x() {
+                                let draw_tile = &mut chunk[(row * SPARSE_CHUNK_LENGTH +
+                                                            column_in_chunk) as usize];
+                                let column =
+                                    (chunk_x * SPARSE_CHUNK_LENGTH + column_in_chunk) as usize;
+                                let delta = prepare_draw_tile(draw_tile,
+                                                              backdrops[column] as i8,
+                                                              self.clip_path,
+                                                              clips);
+                                backdrops[column] += delta;
+                            }
+                        }
                     }
                 }
             }
+        }
+    }
+}
 
-            draw_tile.alpha_tile_id = draw_alpha_tile_id;
-            draw_tile.backdrop = draw_tile_backdrop;
-
-            backdrops[column] += delta;
+// Applies the clip and the propagated column backdrop to a single draw tile, returning the
+// backdrop delta the tile contributes to its column.
+fn prepare_draw_tile(draw_tile: &mut TileObjectPrimitive,
+                     column_backdrop: i8,
+                     clip_path: Option<&BuiltPath>,
+                     clips: &mut Option<DenseTileMap<Clip>>)
+                     -> i32 {
+    let tile_coords = vec2i(draw_tile.tile_x as i32, draw_tile.tile_y as i32);
+    let delta = draw_tile.backdrop as i32;
+
+    let mut draw_alpha_tile_id = draw_tile.alpha_tile_id;
+    let mut draw_tile_backdrop = column_backdrop;
+
+    if let Some(built_clip_path) = clip_path {
+        let clip_tiles = match built_clip_path.data {
+            BuiltPathData::CPU(BuiltPathBinCPUData { ref tiles, .. }) => tiles,
+            _ => unreachable!(),
+        };
+        match clip_tiles.get(tile_coords) {
+            Some(clip_tile) => {
+                if clip_tile.alpha_tile_id != AlphaTileId(!0) &&
+                        draw_alpha_tile_id != AlphaTileId(!0) {
+                    // Hard case: We have an alpha tile and a clip tile with masks. Add a
+                    // job to combine the two masks. Because the mask combining step
+                    // applies the backdrops, zero out the backdrop in the draw tile itself
+                    // so that we don't double-count it.
+                    let clip = clips.as_mut()
+                                    .expect("Where are the clips?")
+                                    .get_mut(tile_coords)
+                                    .unwrap();
+                    clip.dest_tile_id = draw_tile.alpha_tile_id;
+                    clip.dest_backdrop = draw_tile_backdrop as i32;
+                    clip.src_tile_id = clip_tile.alpha_tile_id;
+                    clip.src_backdrop = clip_tile.backdrop as i32;
+                    draw_tile_backdrop = 0;
+                } else if clip_tile.alpha_tile_id != AlphaTileId(!0) &&
+                        draw_alpha_tile_id == AlphaTileId(!0) &&
+                        draw_tile_backdrop != 0 {
+                    // This is a solid draw tile, but there's a clip applied. Replace it
+                    // with an alpha tile pointing directly to the clip mask.
+                    draw_alpha_tile_id = clip_tile.alpha_tile_id;
+                    draw_tile_backdrop = clip_tile.backdrop;
+                } else if clip_tile.alpha_tile_id == AlphaTileId(!0) &&
+                        clip_tile.backdrop == 0 {
+                    // This is a blank clip tile. Cull the draw tile entirely.
+                    draw_alpha_tile_id = AlphaTileId(!0);
+                    draw_tile_backdrop = 0;
+                }
+            }
+            None => {
+                // This draw tile is outside the clip path rect, or the clip path never
+                // touched it. Cull the tile.
+                draw_alpha_tile_id = AlphaTileId(!0);
+                draw_tile_backdrop = 0;
+            }
         }
     }
+
+    draw_tile.alpha_tile_id = draw_alpha_tile_id;
+    draw_tile.backdrop = draw_tile_backdrop;
+
+    delta
+}
+
+// Receives the fills and backdrop adjustments that the lattice walk emits.
+//
+// In the common case this is the `ObjectBuilder` itself; when a large path has its fills
+// generated in parallel, each worker instead buffers into a `Vec<BufferedFill>` for later replay.
+trait FillReceiver {
+    fn add_fill(&mut self,
+                scene_builder: &SceneBuilder,
+                segment: LineSegment2F,
+                tile_coords: Vector2I);
+    fn adjust_alpha_tile_backdrop(&mut self, tile_coords: Vector2I, delta: i8);
+}
+
+impl FillReceiver for ObjectBuilder {
+    #[inline]
+    fn add_fill(&mut self,
+                scene_builder: &SceneBuilder,
+                segment: LineSegment2F,
+                tile_coords: Vector2I) {
+        ObjectBuilder::add_fill(self, scene_builder, segment, tile_coords)
+    }
+
+    #[inline]
+    fn adjust_alpha_tile_backdrop(&mut self, tile_coords: Vector2I, delta: i8) {
+        ObjectBuilder::adjust_alpha_tile_backdrop(self, tile_coords, delta)
+    }
+}
+
+// A fill or backdrop adjustment produced by a parallel fill worker, to be replayed into the
+// object builder on the thread that owns it.
+enum BufferedFill {
+    Fill { segment: LineSegment2F, tile_coords: Vector2I },
+    Backdrop { tile_coords: Vector2I, delta: i8 },
+}
+
+impl FillReceiver for Vec<BufferedFill> {
+    #[inline]
+    fn add_fill(&mut self,
+                _: &SceneBuilder,
+                segment: LineSegment2F,
+                tile_coords: Vector2I) {
+        self.push(BufferedFill::Fill { segment, tile_coords })
+    }
+
+    #[inline]
+    fn adjust_alpha_tile_backdrop(&mut self, tile_coords: Vector2I, delta: i8) {
+        self.push(BufferedFill::Backdrop { tile_coords, delta })
+    }
 }
 
-fn process_segment(segment: &Segment,
-                   scene_builder: &SceneBuilder,
-                   object_builder: &mut ObjectBuilder) {
+fn process_segment<R>(segment: &Segment, scene_builder: &SceneBuilder, fill_receiver: &mut R)
+                      where R: FillReceiver {
     // TODO(pcwalton): Stop degree elevating.
     if segment.is_quadratic() {
         let cubic = segment.to_cubic();
-        return process_segment(&cubic, scene_builder, object_builder);
+        return process_segment(&cubic, scene_builder, fill_receiver);
     }
 
     if segment.is_line() ||
             (segment.is_cubic() && segment.as_cubic_segment().is_flat(FLATTENING_TOLERANCE)) {
-        return process_line_segment(segment.baseline, scene_builder, object_builder);
+        return process_line_segment(segment.baseline, scene_builder, fill_receiver);
     }
 
     // TODO(pcwalton): Use a smarter flattening algorithm.
     let (prev, next) = segment.split(0.5);
-    process_segment(&prev, scene_builder, object_builder);
-    process_segment(&next, scene_builder, object_builder);
+    process_segment(&prev, scene_builder, fill_receiver);
+    process_segment(&next, scene_builder, fill_receiver);
 }
 
 // This is the meat of the technique. It implements the fast lattice-clipping algorithm from
@@ -188,9 +381,10 @@ fn process_segment(segment: &Segment,
 //
 // The algorithm to step through tiles is Amanatides and Woo, "A Fast Voxel Traversal Algorithm for
 // Ray Tracing" 1987: http://www.cse.yorku.ca/~amana/research/grid.pdf
-fn process_line_segment(line_segment: LineSegment2F,
-                        scene_builder: &SceneBuilder,
-                        object_builder: &mut ObjectBuilder) {
+fn process_line_segment<R>(line_segment: LineSegment2F,
+                           scene_builder: &SceneBuilder,
+                           fill_receiver: &mut R)
+                           where R: FillReceiver {
     let view_box = scene_builder.scene.view_box();
     let clip_box = RectF::from_points(vec2f(view_box.min_x(), NEG_INFINITY),
                                       view_box.lower_right());
@@ -259,28 +453,28 @@ fn process_line_segment(line_segment: LineSegment2F,
 
         let next_position = line_segment.sample(next_t);
         let clipped_line_segment = LineSegment2F::new(current_position, next_position);
-        object_builder.add_fill(scene_builder, clipped_line_segment, tile_coords);
+        fill_receiver.add_fill(scene_builder, clipped_line_segment, tile_coords);
 
         // Add extra fills if necessary.
         if step.y() < 0 && next_step_direction == Some(StepDirection::Y) {
             // Leaves through top boundary.
             let auxiliary_segment = LineSegment2F::new(clipped_line_segment.to(),
                                                        tile_coords.to_f32() * tile_size);
-            object_builder.add_fill(scene_builder, auxiliary_segment, tile_coords);
+            fill_receiver.add_fill(scene_builder, auxiliary_segment, tile_coords);
         } else if step.y() > 0 && last_step_direction == Some(StepDirection::Y) {
             // Enters through top boundary.
             let auxiliary_segment = LineSegment2F::new(tile_coords.to_f32() * tile_size,
                                                        clipped_line_segment.from());
-            object_builder.add_fill(scene_builder, auxiliary_segment, tile_coords);
+            fill_receiver.add_fill(scene_builder, auxiliary_segment, tile_coords);
         }
 
         // Adjust backdrop if necessary.
         if step.x() < 0 && last_step_direction == Some(StepDirection::X) {
             // Entered through right boundary.
-            object_builder.adjust_alpha_tile_backdrop(tile_coords, 1);
+            fill_receiver.adjust_alpha_tile_backdrop(tile_coords, 1);
         } else if step.x() > 0 && next_step_direction == Some(StepDirection::X) {
             // Leaving through right boundary.
-            object_builder.adjust_alpha_tile_backdrop(tile_coords, -1);
+            fill_receiver.adjust_alpha_tile_backdrop(tile_coords, -1);
         }
 
         // Take a step.
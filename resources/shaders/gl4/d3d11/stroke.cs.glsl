@@ -0,0 +1,129 @@
+#version {{version}}
+// Automatically generated from files in pathfinder/shaders/. Do not edit!
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+precision highp float;
+
+#ifdef GL_ES
+precision highp sampler2D;
+#endif
+
+layout(local_size_x = 64)in;
+
+uniform int uStrokeSegmentCount;
+
+layout(std430, binding = 0)buffer bStrokeSegments {
+
+
+
+
+    restrict readonly uvec4 iStrokeSegments[];
+};
+
+layout(std430, binding = 1)buffer bPoints {
+    restrict vec2 iPoints[];
+};
+
+vec2 normalizeDirection(vec2 vector, vec2 fallback) {
+    float vectorLength = length(vector);
+    if(vectorLength < 0.00001)
+        return fallback;
+    return vector / vectorLength;
+}
+
+vec2 perp(vec2 vector) {
+    return vec2(-vector.y, vector.x);
+}
+
+void main() {
+    uint strokeSegmentIndex = gl_GlobalInvocationID.x;
+    if(strokeSegmentIndex >= uStrokeSegmentCount)
+        return;
+
+    uvec4 strokeSegment = iStrokeSegments[strokeSegmentIndex];
+    uint inputPointIndex = strokeSegment.x, outputPointIndex = strokeSegment.y;
+    uint flags = strokeSegment.z;
+    float radius = uintBitsToFloat(strokeSegment.w);
+
+
+    vec2 p0 = iPoints[inputPointIndex], ctrl0, ctrl1, p3;
+    if((flags & 0x40000000u) != 0u) {
+        ctrl0 = iPoints[inputPointIndex + 1];
+        ctrl1 = iPoints[inputPointIndex + 2];
+        p3 = iPoints[inputPointIndex + 3];
+    } else if((flags & 0x80000000u) != 0u) {
+        vec2 ctrl = iPoints[inputPointIndex + 1];
+        p3 = iPoints[inputPointIndex + 2];
+        ctrl0 = (p0 + ctrl * 2.0) * (1.0 / 3.0);
+        ctrl1 = (p3 + ctrl * 2.0) * (1.0 / 3.0);
+    } else {
+        p3 = iPoints[inputPointIndex + 1];
+        ctrl0 = mix(p0, p3, 1.0 / 3.0);
+        ctrl1 = mix(p0, p3, 2.0 / 3.0);
+    }
+
+
+    vec2 startDirection = ctrl0 - p0;
+    if(dot(startDirection, startDirection) < 0.00001 * 0.00001)
+        startDirection = ctrl1 - p0;
+    if(dot(startDirection, startDirection) < 0.00001 * 0.00001)
+        startDirection = p3 - p0;
+    startDirection = normalizeDirection(startDirection, vec2(1.0, 0.0));
+    vec2 endDirection = p3 - ctrl1;
+    if(dot(endDirection, endDirection) < 0.00001 * 0.00001)
+        endDirection = p3 - ctrl0;
+    endDirection = normalizeDirection(endDirection, startDirection);
+
+    vec2 startNormal = perp(startDirection), endNormal = perp(endDirection);
+
+
+
+    vec2 ctrlNormal = normalizeDirection(startNormal + endNormal, startNormal);
+
+
+    iPoints[outputPointIndex + 0]  = p0 + startNormal * radius;
+    iPoints[outputPointIndex + 1]  = ctrl0 + ctrlNormal * radius;
+    iPoints[outputPointIndex + 2]  = ctrl1 + ctrlNormal * radius;
+    iPoints[outputPointIndex + 7]  = p3 - endNormal * radius;
+    iPoints[outputPointIndex + 8]  = ctrl1 - ctrlNormal * radius;
+    iPoints[outputPointIndex + 9]  = ctrl0 - ctrlNormal * radius;
+
+
+
+
+    iPoints[outputPointIndex + 3]  = p3 + endNormal * radius;
+    iPoints[outputPointIndex + 4]  = p3 + (endNormal + endDirection) * radius;
+    iPoints[outputPointIndex + 5]  = p3 + endDirection * radius;
+    iPoints[outputPointIndex + 6]  = p3 + (endDirection - endNormal) * radius;
+    iPoints[outputPointIndex + 10] = p0 - startNormal * radius;
+    iPoints[outputPointIndex + 11] = p0 - (startNormal + startDirection) * radius;
+    iPoints[outputPointIndex + 12] = p0 - startDirection * radius;
+    iPoints[outputPointIndex + 13] = p0 + (startNormal - startDirection) * radius;
+
+
+    iPoints[outputPointIndex + 14] = iPoints[outputPointIndex + 0];
+}
+
@@ -0,0 +1,117 @@
+// Automatically generated from files in pathfinder/shaders/. Do not edit!
+#include <metal_stdlib>
+#include <simd/simd.h>
+
+using namespace metal;
+
+struct bStrokeSegments
+{
+    uint4 iStrokeSegments[1];
+};
+
+struct bPoints
+{
+    float2 iPoints[1];
+};
+
+constant uint3 gl_WorkGroupSize [[maybe_unused]] = uint3(64u, 1u, 1u);
+
+static inline __attribute__((always_inline))
+float2 normalizeDirection(thread const float2& vector0, thread const float2& fallback)
+{
+    float vectorLength = length(vector0);
+    if (vectorLength < 9.9999997473787516355514526367188e-06)
+    {
+        return fallback;
+    }
+    return vector0 / float2(vectorLength);
+}
+
+static inline __attribute__((always_inline))
+float2 perp(thread const float2& vector0)
+{
+    return float2(-vector0.y, vector0.x);
+}
+
+kernel void main0(constant int& uStrokeSegmentCount [[buffer(0)]], const device bStrokeSegments& _71 [[buffer(1)]], device bPoints& _95 [[buffer(2)]], uint3 gl_GlobalInvocationID [[thread_position_in_grid]])
+{
+    uint strokeSegmentIndex = gl_GlobalInvocationID.x;
+    if (strokeSegmentIndex >= uint(uStrokeSegmentCount))
+    {
+        return;
+    }
+    uint4 strokeSegment = _71.iStrokeSegments[strokeSegmentIndex];
+    uint inputPointIndex = strokeSegment.x;
+    uint outputPointIndex = strokeSegment.y;
+    uint flags = strokeSegment.z;
+    float radius = as_type<float>(strokeSegment.w);
+    float2 p0 = _95.iPoints[inputPointIndex];
+    float2 ctrl0;
+    float2 ctrl1;
+    float2 p3;
+    if ((flags & 1073741824u) != 0u)
+    {
+        ctrl0 = _95.iPoints[inputPointIndex + 1u];
+        ctrl1 = _95.iPoints[inputPointIndex + 2u];
+        p3 = _95.iPoints[inputPointIndex + 3u];
+    }
+    else
+    {
+        if ((flags & 2147483648u) != 0u)
+        {
+            float2 ctrl = _95.iPoints[inputPointIndex + 1u];
+            p3 = _95.iPoints[inputPointIndex + 2u];
+            ctrl0 = (p0 + (ctrl * 2.0)) * 0.3333333432674407958984375;
+            ctrl1 = (p3 + (ctrl * 2.0)) * 0.3333333432674407958984375;
+        }
+        else
+        {
+            p3 = _95.iPoints[inputPointIndex + 1u];
+            ctrl0 = mix(p0, p3, float2(0.3333333432674407958984375));
+            ctrl1 = mix(p0, p3, float2(0.666666686534881591796875));
+        }
+    }
+    float2 startDirection = ctrl0 - p0;
+    if (dot(startDirection, startDirection) < 9.9999999439624928954718215391648e-11)
+    {
+        startDirection = ctrl1 - p0;
+    }
+    if (dot(startDirection, startDirection) < 9.9999999439624928954718215391648e-11)
+    {
+        startDirection = p3 - p0;
+    }
+    float2 param = startDirection;
+    float2 param_1 = float2(1.0, 0.0);
+    startDirection = normalizeDirection(param, param_1);
+    float2 endDirection = p3 - ctrl1;
+    if (dot(endDirection, endDirection) < 9.9999999439624928954718215391648e-11)
+    {
+        endDirection = p3 - ctrl0;
+    }
+    float2 param_2 = endDirection;
+    float2 param_3 = startDirection;
+    endDirection = normalizeDirection(param_2, param_3);
+    float2 param_4 = startDirection;
+    float2 startNormal = perp(param_4);
+    float2 param_5 = endDirection;
+    float2 endNormal = perp(param_5);
+    float2 param_6 = startNormal + endNormal;
+    float2 param_7 = startNormal;
+    float2 ctrlNormal = normalizeDirection(param_6, param_7);
+    _95.iPoints[outputPointIndex + 0u] = p0 + (startNormal * radius);
+    _95.iPoints[outputPointIndex + 1u] = ctrl0 + (ctrlNormal * radius);
+    _95.iPoints[outputPointIndex + 2u] = ctrl1 + (ctrlNormal * radius);
+    _95.iPoints[outputPointIndex + 7u] = p3 - (endNormal * radius);
+    _95.iPoints[outputPointIndex + 8u] = ctrl1 - (ctrlNormal * radius);
+    _95.iPoints[outputPointIndex + 9u] = ctrl0 - (ctrlNormal * radius);
+    _95.iPoints[outputPointIndex + 3u] = p3 + (endNormal * radius);
+    _95.iPoints[outputPointIndex + 4u] = p3 + ((endNormal + endDirection) * radius);
+    _95.iPoints[outputPointIndex + 5u] = p3 + (endDirection * radius);
+    _95.iPoints[outputPointIndex + 6u] = p3 + ((endDirection - endNormal) * radius);
+    _95.iPoints[outputPointIndex + 10u] = p0 - (startNormal * radius);
+    _95.iPoints[outputPointIndex + 11u] = p0 - ((startNormal + startDirection) * radius);
+    _95.iPoints[outputPointIndex + 12u] = p0 - (startDirection * radius);
+    _95.iPoints[outputPointIndex + 13u] = p0 + ((startNormal - startDirection) * radius);
+    _95.iPoints[outputPointIndex + 14u] = _95.iPoints[outputPointIndex + 0u];
+}
+
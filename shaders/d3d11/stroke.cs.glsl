@@ -0,0 +1,126 @@
+#version 430
+
+// pathfinder/shaders/stroke.cs.glsl
+//
+// Copyright © 2020 The Pathfinder Project Developers.
+//
+// Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+// http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+// <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+// option. This file may not be copied, modified, or distributed
+// except according to those terms.
+
+// Expands stroke centerline segments into stroke-boundary geometry.
+//
+// Each input segment becomes a closed "capsule": an offset curve down each side and a round cap
+// at each end. Because every capsule is traced with the same orientation, the union of a path's
+// capsules under the winding fill rule is exactly the stroked region, with round joins and caps
+// falling out of the overlapping end caps. The capsule's point layout is fixed, so the CPU lays
+// out the segment indices in advance and this shader only writes points.
+
+#define FLAGS_PATH_INDEX_CURVE_IS_QUADRATIC   0x80000000u
+#define FLAGS_PATH_INDEX_CURVE_IS_CUBIC       0x40000000u
+
+#define EPSILON 0.00001
+
+precision highp float;
+
+#ifdef GL_ES
+precision highp sampler2D;
+#endif
+
+layout(local_size_x = 64) in;
+
+uniform int uStrokeSegmentCount;
+
+layout(std430, binding = 0) buffer bStrokeSegments {
+    // x: input point index
+    // y: output point index
+    // z: flags (curve type)
+    // w: radius (bitcast)
+    restrict readonly uvec4 iStrokeSegments[];
+};
+
+layout(std430, binding = 1) buffer bPoints {
+    restrict vec2 iPoints[];
+};
+
+vec2 normalizeDirection(vec2 vector, vec2 fallback) {
+    float vectorLength = length(vector);
+    if (vectorLength < EPSILON)
+        return fallback;
+    return vector / vectorLength;
+}
+
+vec2 perp(vec2 vector) {
+    return vec2(-vector.y, vector.x);
+}
+
+void main() {
+    uint strokeSegmentIndex = gl_GlobalInvocationID.x;
+    if (strokeSegmentIndex >= uStrokeSegmentCount)
+        return;
+
+    uvec4 strokeSegment = iStrokeSegments[strokeSegmentIndex];
+    uint inputPointIndex = strokeSegment.x, outputPointIndex = strokeSegment.y;
+    uint flags = strokeSegment.z;
+    float radius = uintBitsToFloat(strokeSegment.w);
+
+    // Fetch the input segment as a cubic, elevating lines and quadratics.
+    vec2 p0 = iPoints[inputPointIndex], ctrl0, ctrl1, p3;
+    if ((flags & FLAGS_PATH_INDEX_CURVE_IS_CUBIC) != 0u) {
+        ctrl0 = iPoints[inputPointIndex + 1];
+        ctrl1 = iPoints[inputPointIndex + 2];
+        p3 = iPoints[inputPointIndex + 3];
+    } else if ((flags & FLAGS_PATH_INDEX_CURVE_IS_QUADRATIC) != 0u) {
+        vec2 ctrl = iPoints[inputPointIndex + 1];
+        p3 = iPoints[inputPointIndex + 2];
+        ctrl0 = (p0 + ctrl * 2.0) * (1.0 / 3.0);
+        ctrl1 = (p3 + ctrl * 2.0) * (1.0 / 3.0);
+    } else {
+        p3 = iPoints[inputPointIndex + 1];
+        ctrl0 = mix(p0, p3, 1.0 / 3.0);
+        ctrl1 = mix(p0, p3, 2.0 / 3.0);
+    }
+
+    // Endpoint tangents, with fallbacks for degenerate control points.
+    vec2 startDirection = ctrl0 - p0;
+    if (dot(startDirection, startDirection) < EPSILON * EPSILON)
+        startDirection = ctrl1 - p0;
+    if (dot(startDirection, startDirection) < EPSILON * EPSILON)
+        startDirection = p3 - p0;
+    startDirection = normalizeDirection(startDirection, vec2(1.0, 0.0));
+    vec2 endDirection = p3 - ctrl1;
+    if (dot(endDirection, endDirection) < EPSILON * EPSILON)
+        endDirection = p3 - ctrl0;
+    endDirection = normalizeDirection(endDirection, startDirection);
+
+    vec2 startNormal = perp(startDirection), endNormal = perp(endDirection);
+
+    // Offset the control points along the average normal. This is an approximation, but the
+    // overlap of neighboring capsules hides the error for the flatness tolerances we dice to.
+    vec2 ctrlNormal = normalizeDirection(startNormal + endNormal, startNormal);
+
+    // One offset cubic down each side of the centerline…
+    iPoints[outputPointIndex + 0]  = p0 + startNormal * radius;
+    iPoints[outputPointIndex + 1]  = ctrl0 + ctrlNormal * radius;
+    iPoints[outputPointIndex + 2]  = ctrl1 + ctrlNormal * radius;
+    iPoints[outputPointIndex + 7]  = p3 - endNormal * radius;
+    iPoints[outputPointIndex + 8]  = ctrl1 - ctrlNormal * radius;
+    iPoints[outputPointIndex + 9]  = ctrl0 - ctrlNormal * radius;
+
+    // …and two quadratic arcs around each end cap, with control points at the corners of the
+    // bounding square. The quadratics bulge slightly past the true circle (about 6% of the
+    // radius at the arc midpoint), which errs on the side of covering the joint.
+    iPoints[outputPointIndex + 3]  = p3 + endNormal * radius;
+    iPoints[outputPointIndex + 4]  = p3 + (endNormal + endDirection) * radius;
+    iPoints[outputPointIndex + 5]  = p3 + endDirection * radius;
+    iPoints[outputPointIndex + 6]  = p3 + (endDirection - endNormal) * radius;
+    iPoints[outputPointIndex + 10] = p0 - startNormal * radius;
+    iPoints[outputPointIndex + 11] = p0 - (startNormal + startDirection) * radius;
+    iPoints[outputPointIndex + 12] = p0 - startDirection * radius;
+    iPoints[outputPointIndex + 13] = p0 + (startNormal - startDirection) * radius;
+
+    // Close the capsule contour.
+    iPoints[outputPointIndex + 14] = iPoints[outputPointIndex + 0];
+}
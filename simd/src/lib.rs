@@ -20,10 +20,17 @@ pub use crate::arm as default;
     not(any(
         target_arch = "x86",
         target_arch = "x86_64",
-        all(pf_rustc_nightly, target_arch = "aarch64")
+        all(pf_rustc_nightly, target_arch = "aarch64"),
+        all(target_arch = "wasm32", target_feature = "simd128")
     ))
 ))]
 pub use crate::scalar as default;
+#[cfg(all(
+    not(feature = "pf-no-simd"),
+    target_arch = "wasm32",
+    target_feature = "simd128"
+))]
+pub use crate::wasm32 as default;
 #[cfg(all(
     not(feature = "pf-no-simd"),
     any(target_arch = "x86", target_arch = "x86_64")
@@ -34,6 +41,9 @@ pub use crate::x86 as default;
 pub mod arm;
 mod extras;
 pub mod scalar;
+pub mod wide;
+#[cfg(all(target_arch = "wasm32", target_feature = "simd128"))]
+pub mod wasm32;
 #[cfg(any(target_arch = "x86", target_arch = "x86_64"))]
 pub mod x86;
 
@@ -10,6 +10,7 @@
 
 use crate::default::{F32x4, I32x4, U32x4};
 use crate::scalar::F32x4 as F32x4S;
+use crate::wide::{F32x8, I32x8};
 
 // F32x4
 
@@ -689,3 +690,62 @@ fn test_f32x4s_basic_ops() {
     assert_eq!(c.ceil(), F32x4S::new(-1.0, 2.0, -20.0, 4.0));
     assert_eq!(c.to_i32x4().to_f32x4(), F32x4S::new(-1.0, 1.0, -20.0, 4.0));
 }
+
+// F32x8
+
+#[test]
+fn test_f32x8_constructors() {
+    let a = F32x8::new(1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0);
+    assert_eq!((a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7]),
+               (1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0));
+    let b = F32x8::splat(10.0);
+    assert_eq!(b, F32x8::new(10.0, 10.0, 10.0, 10.0, 10.0, 10.0, 10.0, 10.0));
+    let c = F32x8::from_halves(F32x4::new(1.0, 2.0, 3.0, 4.0), F32x4::new(5.0, 6.0, 7.0, 8.0));
+    assert_eq!(c, a);
+    assert_eq!(c.lo(), F32x4::new(1.0, 2.0, 3.0, 4.0));
+    assert_eq!(c.hi(), F32x4::new(5.0, 6.0, 7.0, 8.0));
+}
+
+#[test]
+fn test_f32x8_basic_ops() {
+    let a = F32x8::new(1.0, 3.0, 5.0, 7.0, 9.0, 11.0, 13.0, 15.0);
+    let b = F32x8::new(2.0, 2.0, 6.0, 6.0, 10.0, 10.0, 14.0, 14.0);
+    assert_eq!(a.min(b), F32x8::new(1.0, 2.0, 5.0, 6.0, 9.0, 10.0, 13.0, 14.0));
+    assert_eq!(a.max(b), F32x8::new(2.0, 3.0, 6.0, 7.0, 10.0, 11.0, 14.0, 15.0));
+    let c = F32x8::new(-1.0, 1.3, -20.0, 3.6, 0.5, -0.5, 2.5, -2.5);
+    assert_eq!(c.clamp(F32x8::splat(-1.5), F32x8::splat(1.5)),
+               F32x8::new(-1.0, 1.3, -1.5, 1.5, 0.5, -0.5, 1.5, -1.5));
+    assert_eq!(c.abs(), F32x8::new(1.0, 1.3, 20.0, 3.6, 0.5, 0.5, 2.5, 2.5));
+    assert_eq!(c.floor(), F32x8::new(-1.0, 1.0, -20.0, 3.0, 0.0, -1.0, 2.0, -3.0));
+    assert_eq!(c.ceil(), F32x8::new(-1.0, 2.0, -20.0, 4.0, 1.0, 0.0, 3.0, -2.0));
+}
+
+#[test]
+fn test_f32x8_arithmetic_overloads() {
+    let a = F32x8::new(4.0, -1.0, 6.0, -32.0, 1.0, 2.0, 3.0, 4.0);
+    let b = F32x8::new(0.5, 0.5, 10.0, 3.0, 1.0, 2.0, 3.0, 4.0);
+    assert_eq!(a + b, F32x8::new(4.5, -0.5, 16.0, -29.0, 2.0, 4.0, 6.0, 8.0));
+    assert_eq!(a - b, F32x8::new(3.5, -1.5, -4.0, -35.0, 0.0, 0.0, 0.0, 0.0));
+    assert_eq!(a * b, F32x8::new(2.0, -0.5, 60.0, -96.0, 1.0, 4.0, 9.0, 16.0));
+    assert_eq!(a / b, F32x8::new(8.0, -2.0, 0.6, -32.0 / 3.0, 1.0, 1.0, 1.0, 1.0));
+}
+
+#[test]
+fn test_i32x8_basic_ops() {
+    let a = I32x8::new(6, 2, 4, 8, 10, -4, 0, 12);
+    let b = I32x8::new(7, 3, 3, 9, 9, -5, 1, 11);
+    assert_eq!(a.min(b), I32x8::new(6, 2, 3, 8, 9, -5, 0, 11));
+    assert_eq!(a.max(b), I32x8::new(7, 3, 4, 9, 10, -4, 1, 12));
+    assert_eq!(a + b, I32x8::new(13, 5, 7, 17, 19, -9, 1, 23));
+    assert_eq!(a - b, I32x8::new(-1, -1, 1, -1, 1, 1, -1, 1));
+    assert_eq!(a.to_f32x8(), F32x8::new(6.0, 2.0, 4.0, 8.0, 10.0, -4.0, 0.0, 12.0));
+}
+
+#[test]
+fn test_f32x8_conversions() {
+    let a = F32x8::new(1.3, -2.5, 3.6, -4.0, 0.5, 1.5, 2.5, 3.5);
+    // Note that rounding is to the nearest even number.
+    assert_eq!(a.to_i32x8(), I32x8::new(1, -2, 4, -4, 0, 2, 2, 4));
+    assert_eq!(a.to_i32x8().lo(), I32x4::new(1, -2, 4, -4));
+    assert_eq!(a.to_i32x8().hi(), I32x4::new(0, 2, 2, 4));
+}
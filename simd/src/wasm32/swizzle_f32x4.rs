@@ -0,0 +1,1294 @@
+// pathfinder/simd/src/wasm32/swizzle_f32x4.rs
+//
+// Copyright © 2019 The Pathfinder Project Developers.
+//
+// Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+// http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+// <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+// option. This file may not be copied, modified, or distributed
+// except according to those terms.
+
+use crate::wasm32::F32x4;
+use std::arch::wasm32 as wasm;
+
+impl F32x4 {
+    #[inline]
+    pub fn xxxx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 0, 0, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yxxx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 0, 0, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zxxx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 0, 0, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wxxx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 0, 0, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xyxx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 1, 0, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yyxx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 1, 0, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zyxx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 1, 0, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wyxx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 1, 0, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xzxx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 2, 0, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yzxx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 2, 0, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zzxx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 2, 0, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wzxx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 2, 0, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xwxx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 3, 0, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn ywxx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 3, 0, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zwxx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 3, 0, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wwxx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 3, 0, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xxyx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 0, 1, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yxyx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 0, 1, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zxyx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 0, 1, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wxyx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 0, 1, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xyyx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 1, 1, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yyyx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 1, 1, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zyyx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 1, 1, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wyyx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 1, 1, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xzyx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 2, 1, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yzyx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 2, 1, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zzyx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 2, 1, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wzyx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 2, 1, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xwyx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 3, 1, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn ywyx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 3, 1, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zwyx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 3, 1, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wwyx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 3, 1, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xxzx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 0, 2, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yxzx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 0, 2, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zxzx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 0, 2, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wxzx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 0, 2, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xyzx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 1, 2, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yyzx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 1, 2, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zyzx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 1, 2, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wyzx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 1, 2, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xzzx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 2, 2, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yzzx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 2, 2, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zzzx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 2, 2, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wzzx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 2, 2, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xwzx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 3, 2, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn ywzx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 3, 2, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zwzx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 3, 2, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wwzx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 3, 2, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xxwx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 0, 3, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yxwx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 0, 3, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zxwx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 0, 3, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wxwx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 0, 3, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xywx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 1, 3, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yywx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 1, 3, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zywx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 1, 3, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wywx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 1, 3, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xzwx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 2, 3, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yzwx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 2, 3, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zzwx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 2, 3, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wzwx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 2, 3, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xwwx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 3, 3, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn ywwx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 3, 3, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zwwx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 3, 3, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wwwx(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 3, 3, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xxxy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 0, 0, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yxxy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 0, 0, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zxxy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 0, 0, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wxxy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 0, 0, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xyxy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 1, 0, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yyxy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 1, 0, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zyxy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 1, 0, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wyxy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 1, 0, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xzxy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 2, 0, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yzxy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 2, 0, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zzxy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 2, 0, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wzxy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 2, 0, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xwxy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 3, 0, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn ywxy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 3, 0, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zwxy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 3, 0, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wwxy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 3, 0, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xxyy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 0, 1, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yxyy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 0, 1, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zxyy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 0, 1, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wxyy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 0, 1, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xyyy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 1, 1, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yyyy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 1, 1, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zyyy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 1, 1, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wyyy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 1, 1, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xzyy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 2, 1, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yzyy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 2, 1, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zzyy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 2, 1, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wzyy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 2, 1, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xwyy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 3, 1, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn ywyy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 3, 1, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zwyy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 3, 1, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wwyy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 3, 1, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xxzy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 0, 2, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yxzy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 0, 2, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zxzy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 0, 2, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wxzy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 0, 2, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xyzy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 1, 2, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yyzy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 1, 2, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zyzy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 1, 2, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wyzy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 1, 2, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xzzy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 2, 2, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yzzy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 2, 2, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zzzy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 2, 2, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wzzy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 2, 2, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xwzy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 3, 2, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn ywzy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 3, 2, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zwzy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 3, 2, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wwzy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 3, 2, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xxwy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 0, 3, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yxwy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 0, 3, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zxwy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 0, 3, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wxwy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 0, 3, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xywy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 1, 3, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yywy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 1, 3, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zywy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 1, 3, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wywy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 1, 3, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xzwy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 2, 3, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yzwy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 2, 3, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zzwy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 2, 3, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wzwy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 2, 3, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xwwy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 3, 3, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn ywwy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 3, 3, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zwwy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 3, 3, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wwwy(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 3, 3, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xxxz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 0, 0, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yxxz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 0, 0, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zxxz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 0, 0, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wxxz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 0, 0, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xyxz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 1, 0, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yyxz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 1, 0, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zyxz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 1, 0, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wyxz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 1, 0, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xzxz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 2, 0, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yzxz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 2, 0, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zzxz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 2, 0, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wzxz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 2, 0, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xwxz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 3, 0, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn ywxz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 3, 0, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zwxz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 3, 0, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wwxz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 3, 0, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xxyz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 0, 1, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yxyz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 0, 1, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zxyz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 0, 1, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wxyz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 0, 1, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xyyz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 1, 1, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yyyz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 1, 1, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zyyz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 1, 1, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wyyz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 1, 1, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xzyz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 2, 1, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yzyz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 2, 1, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zzyz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 2, 1, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wzyz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 2, 1, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xwyz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 3, 1, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn ywyz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 3, 1, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zwyz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 3, 1, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wwyz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 3, 1, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xxzz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 0, 2, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yxzz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 0, 2, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zxzz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 0, 2, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wxzz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 0, 2, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xyzz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 1, 2, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yyzz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 1, 2, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zyzz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 1, 2, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wyzz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 1, 2, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xzzz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 2, 2, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yzzz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 2, 2, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zzzz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 2, 2, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wzzz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 2, 2, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xwzz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 3, 2, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn ywzz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 3, 2, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zwzz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 3, 2, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wwzz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 3, 2, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xxwz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 0, 3, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yxwz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 0, 3, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zxwz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 0, 3, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wxwz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 0, 3, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xywz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 1, 3, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yywz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 1, 3, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zywz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 1, 3, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wywz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 1, 3, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xzwz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 2, 3, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yzwz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 2, 3, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zzwz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 2, 3, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wzwz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 2, 3, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xwwz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 3, 3, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn ywwz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 3, 3, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zwwz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 3, 3, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wwwz(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 3, 3, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xxxw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 0, 0, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yxxw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 0, 0, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zxxw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 0, 0, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wxxw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 0, 0, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xyxw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 1, 0, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yyxw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 1, 0, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zyxw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 1, 0, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wyxw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 1, 0, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xzxw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 2, 0, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yzxw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 2, 0, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zzxw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 2, 0, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wzxw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 2, 0, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xwxw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 3, 0, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn ywxw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 3, 0, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zwxw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 3, 0, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wwxw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 3, 0, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xxyw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 0, 1, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yxyw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 0, 1, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zxyw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 0, 1, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wxyw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 0, 1, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xyyw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 1, 1, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yyyw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 1, 1, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zyyw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 1, 1, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wyyw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 1, 1, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xzyw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 2, 1, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yzyw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 2, 1, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zzyw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 2, 1, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wzyw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 2, 1, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xwyw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 3, 1, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn ywyw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 3, 1, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zwyw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 3, 1, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wwyw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 3, 1, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xxzw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 0, 2, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yxzw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 0, 2, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zxzw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 0, 2, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wxzw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 0, 2, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xyzw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 1, 2, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yyzw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 1, 2, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zyzw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 1, 2, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wyzw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 1, 2, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xzzw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 2, 2, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yzzw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 2, 2, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zzzw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 2, 2, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wzzw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 2, 2, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xwzw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 3, 2, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn ywzw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 3, 2, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zwzw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 3, 2, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wwzw(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 3, 2, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xxww(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 0, 3, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yxww(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 0, 3, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zxww(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 0, 3, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wxww(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 0, 3, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xyww(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 1, 3, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yyww(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 1, 3, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zyww(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 1, 3, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wyww(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 1, 3, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xzww(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 2, 3, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yzww(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 2, 3, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zzww(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 2, 3, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wzww(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 2, 3, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xwww(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<0, 3, 3, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn ywww(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<1, 3, 3, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zwww(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<2, 3, 3, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wwww(self) -> F32x4 {
+        F32x4(wasm::i32x4_shuffle::<3, 3, 3, 3>(self.0, self.0))
+    }
+}
@@ -0,0 +1,1294 @@
+// pathfinder/simd/src/wasm32/swizzle_i32x4.rs
+//
+// Copyright © 2019 The Pathfinder Project Developers.
+//
+// Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+// http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+// <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+// option. This file may not be copied, modified, or distributed
+// except according to those terms.
+
+use crate::wasm32::I32x4;
+use std::arch::wasm32 as wasm;
+
+impl I32x4 {
+    #[inline]
+    pub fn xxxx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 0, 0, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yxxx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 0, 0, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zxxx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 0, 0, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wxxx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 0, 0, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xyxx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 1, 0, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yyxx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 1, 0, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zyxx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 1, 0, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wyxx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 1, 0, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xzxx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 2, 0, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yzxx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 2, 0, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zzxx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 2, 0, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wzxx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 2, 0, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xwxx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 3, 0, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn ywxx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 3, 0, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zwxx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 3, 0, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wwxx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 3, 0, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xxyx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 0, 1, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yxyx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 0, 1, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zxyx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 0, 1, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wxyx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 0, 1, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xyyx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 1, 1, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yyyx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 1, 1, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zyyx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 1, 1, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wyyx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 1, 1, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xzyx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 2, 1, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yzyx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 2, 1, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zzyx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 2, 1, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wzyx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 2, 1, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xwyx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 3, 1, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn ywyx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 3, 1, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zwyx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 3, 1, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wwyx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 3, 1, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xxzx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 0, 2, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yxzx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 0, 2, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zxzx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 0, 2, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wxzx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 0, 2, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xyzx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 1, 2, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yyzx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 1, 2, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zyzx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 1, 2, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wyzx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 1, 2, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xzzx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 2, 2, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yzzx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 2, 2, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zzzx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 2, 2, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wzzx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 2, 2, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xwzx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 3, 2, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn ywzx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 3, 2, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zwzx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 3, 2, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wwzx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 3, 2, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xxwx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 0, 3, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yxwx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 0, 3, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zxwx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 0, 3, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wxwx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 0, 3, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xywx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 1, 3, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yywx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 1, 3, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zywx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 1, 3, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wywx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 1, 3, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xzwx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 2, 3, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yzwx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 2, 3, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zzwx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 2, 3, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wzwx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 2, 3, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xwwx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 3, 3, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn ywwx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 3, 3, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zwwx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 3, 3, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wwwx(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 3, 3, 0>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xxxy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 0, 0, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yxxy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 0, 0, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zxxy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 0, 0, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wxxy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 0, 0, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xyxy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 1, 0, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yyxy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 1, 0, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zyxy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 1, 0, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wyxy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 1, 0, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xzxy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 2, 0, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yzxy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 2, 0, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zzxy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 2, 0, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wzxy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 2, 0, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xwxy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 3, 0, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn ywxy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 3, 0, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zwxy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 3, 0, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wwxy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 3, 0, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xxyy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 0, 1, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yxyy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 0, 1, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zxyy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 0, 1, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wxyy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 0, 1, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xyyy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 1, 1, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yyyy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 1, 1, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zyyy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 1, 1, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wyyy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 1, 1, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xzyy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 2, 1, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yzyy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 2, 1, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zzyy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 2, 1, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wzyy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 2, 1, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xwyy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 3, 1, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn ywyy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 3, 1, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zwyy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 3, 1, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wwyy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 3, 1, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xxzy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 0, 2, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yxzy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 0, 2, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zxzy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 0, 2, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wxzy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 0, 2, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xyzy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 1, 2, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yyzy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 1, 2, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zyzy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 1, 2, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wyzy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 1, 2, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xzzy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 2, 2, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yzzy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 2, 2, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zzzy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 2, 2, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wzzy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 2, 2, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xwzy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 3, 2, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn ywzy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 3, 2, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zwzy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 3, 2, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wwzy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 3, 2, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xxwy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 0, 3, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yxwy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 0, 3, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zxwy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 0, 3, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wxwy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 0, 3, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xywy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 1, 3, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yywy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 1, 3, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zywy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 1, 3, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wywy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 1, 3, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xzwy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 2, 3, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yzwy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 2, 3, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zzwy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 2, 3, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wzwy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 2, 3, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xwwy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 3, 3, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn ywwy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 3, 3, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zwwy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 3, 3, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wwwy(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 3, 3, 1>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xxxz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 0, 0, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yxxz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 0, 0, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zxxz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 0, 0, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wxxz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 0, 0, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xyxz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 1, 0, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yyxz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 1, 0, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zyxz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 1, 0, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wyxz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 1, 0, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xzxz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 2, 0, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yzxz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 2, 0, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zzxz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 2, 0, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wzxz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 2, 0, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xwxz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 3, 0, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn ywxz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 3, 0, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zwxz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 3, 0, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wwxz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 3, 0, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xxyz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 0, 1, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yxyz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 0, 1, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zxyz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 0, 1, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wxyz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 0, 1, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xyyz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 1, 1, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yyyz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 1, 1, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zyyz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 1, 1, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wyyz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 1, 1, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xzyz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 2, 1, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yzyz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 2, 1, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zzyz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 2, 1, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wzyz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 2, 1, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xwyz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 3, 1, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn ywyz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 3, 1, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zwyz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 3, 1, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wwyz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 3, 1, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xxzz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 0, 2, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yxzz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 0, 2, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zxzz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 0, 2, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wxzz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 0, 2, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xyzz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 1, 2, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yyzz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 1, 2, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zyzz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 1, 2, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wyzz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 1, 2, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xzzz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 2, 2, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yzzz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 2, 2, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zzzz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 2, 2, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wzzz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 2, 2, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xwzz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 3, 2, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn ywzz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 3, 2, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zwzz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 3, 2, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wwzz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 3, 2, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xxwz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 0, 3, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yxwz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 0, 3, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zxwz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 0, 3, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wxwz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 0, 3, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xywz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 1, 3, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yywz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 1, 3, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zywz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 1, 3, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wywz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 1, 3, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xzwz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 2, 3, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yzwz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 2, 3, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zzwz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 2, 3, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wzwz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 2, 3, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xwwz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 3, 3, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn ywwz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 3, 3, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zwwz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 3, 3, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wwwz(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 3, 3, 2>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xxxw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 0, 0, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yxxw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 0, 0, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zxxw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 0, 0, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wxxw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 0, 0, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xyxw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 1, 0, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yyxw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 1, 0, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zyxw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 1, 0, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wyxw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 1, 0, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xzxw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 2, 0, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yzxw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 2, 0, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zzxw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 2, 0, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wzxw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 2, 0, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xwxw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 3, 0, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn ywxw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 3, 0, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zwxw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 3, 0, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wwxw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 3, 0, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xxyw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 0, 1, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yxyw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 0, 1, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zxyw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 0, 1, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wxyw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 0, 1, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xyyw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 1, 1, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yyyw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 1, 1, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zyyw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 1, 1, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wyyw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 1, 1, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xzyw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 2, 1, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yzyw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 2, 1, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zzyw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 2, 1, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wzyw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 2, 1, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xwyw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 3, 1, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn ywyw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 3, 1, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zwyw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 3, 1, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wwyw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 3, 1, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xxzw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 0, 2, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yxzw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 0, 2, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zxzw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 0, 2, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wxzw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 0, 2, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xyzw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 1, 2, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yyzw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 1, 2, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zyzw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 1, 2, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wyzw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 1, 2, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xzzw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 2, 2, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yzzw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 2, 2, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zzzw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 2, 2, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wzzw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 2, 2, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xwzw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 3, 2, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn ywzw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 3, 2, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zwzw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 3, 2, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wwzw(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 3, 2, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xxww(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 0, 3, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yxww(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 0, 3, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zxww(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 0, 3, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wxww(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 0, 3, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xyww(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 1, 3, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yyww(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 1, 3, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zyww(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 1, 3, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wyww(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 1, 3, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xzww(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 2, 3, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn yzww(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 2, 3, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zzww(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 2, 3, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wzww(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 2, 3, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn xwww(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<0, 3, 3, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn ywww(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<1, 3, 3, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn zwww(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<2, 3, 3, 3>(self.0, self.0))
+    }
+
+    #[inline]
+    pub fn wwww(self) -> I32x4 {
+        I32x4(wasm::i32x4_shuffle::<3, 3, 3, 3>(self.0, self.0))
+    }
+}
@@ -0,0 +1,882 @@
+// pathfinder/simd/src/wide.rs
+//
+// Copyright © 2021 The Pathfinder Project Developers.
+//
+// Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+// http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+// <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+// option. This file may not be copied, modified, or distributed
+// except according to those terms.
+
+//! Eight-wide SIMD vectors.
+//!
+//! On most targets these are represented as a pair of four-wide vectors. When AVX2 is enabled at
+//! compile time (e.g. with `RUSTFLAGS="-C target-feature=+avx2"`), a single 256-bit register is
+//! used instead. Because these are value types that may be embedded in other structures, the
+//! representation can't vary at runtime; rebuild with the target feature enabled to use the wide
+//! registers.
+
+#[cfg(all(
+    not(feature = "pf-no-simd"),
+    any(target_arch = "x86", target_arch = "x86_64"),
+    target_feature = "avx2"
+))]
+pub use crate::wide::avx2::{F32x8, I32x8, U32x8};
+#[cfg(not(all(
+    not(feature = "pf-no-simd"),
+    any(target_arch = "x86", target_arch = "x86_64"),
+    target_feature = "avx2"
+)))]
+pub use crate::wide::portable::{F32x8, I32x8, U32x8};
+
+#[cfg(not(all(
+    not(feature = "pf-no-simd"),
+    any(target_arch = "x86", target_arch = "x86_64"),
+    target_feature = "avx2"
+)))]
+mod portable {
+    use crate::default::{F32x4, I32x4, U32x4};
+    use std::fmt::{self, Debug, Formatter};
+    use std::ops::{Add, BitAnd, BitOr, Div, Index, IndexMut, Mul, Sub};
+
+    // Eight 32-bit floats
+
+    #[derive(Clone, Copy)]
+    pub struct F32x8(pub F32x4, pub F32x4);
+
+    impl F32x8 {
+        // Constructors
+
+        #[inline]
+        pub fn new(a: f32, b: f32, c: f32, d: f32, e: f32, f: f32, g: f32, h: f32) -> F32x8 {
+            F32x8(F32x4::new(a, b, c, d), F32x4::new(e, f, g, h))
+        }
+
+        #[inline]
+        pub fn splat(x: f32) -> F32x8 {
+            F32x8(F32x4::splat(x), F32x4::splat(x))
+        }
+
+        #[inline]
+        pub fn from_halves(lo: F32x4, hi: F32x4) -> F32x8 {
+            F32x8(lo, hi)
+        }
+
+        // Extraction
+
+        #[inline]
+        pub fn lo(self) -> F32x4 {
+            self.0
+        }
+
+        #[inline]
+        pub fn hi(self) -> F32x4 {
+            self.1
+        }
+
+        // Basic operations
+
+        #[inline]
+        pub fn approx_recip(self) -> F32x8 {
+            F32x8(self.0.approx_recip(), self.1.approx_recip())
+        }
+
+        #[inline]
+        pub fn min(self, other: F32x8) -> F32x8 {
+            F32x8(self.0.min(other.0), self.1.min(other.1))
+        }
+
+        #[inline]
+        pub fn max(self, other: F32x8) -> F32x8 {
+            F32x8(self.0.max(other.0), self.1.max(other.1))
+        }
+
+        #[inline]
+        pub fn clamp(self, min: F32x8, max: F32x8) -> F32x8 {
+            self.max(min).min(max)
+        }
+
+        #[inline]
+        pub fn abs(self) -> F32x8 {
+            F32x8(self.0.abs(), self.1.abs())
+        }
+
+        #[inline]
+        pub fn floor(self) -> F32x8 {
+            F32x8(self.0.floor(), self.1.floor())
+        }
+
+        #[inline]
+        pub fn ceil(self) -> F32x8 {
+            F32x8(self.0.ceil(), self.1.ceil())
+        }
+
+        #[inline]
+        pub fn sqrt(self) -> F32x8 {
+            F32x8(self.0.sqrt(), self.1.sqrt())
+        }
+
+        // Packed comparisons
+
+        #[inline]
+        pub fn packed_eq(self, other: F32x8) -> U32x8 {
+            U32x8(self.0.packed_eq(other.0), self.1.packed_eq(other.1))
+        }
+
+        #[inline]
+        pub fn packed_gt(self, other: F32x8) -> U32x8 {
+            U32x8(self.0.packed_gt(other.0), self.1.packed_gt(other.1))
+        }
+
+        #[inline]
+        pub fn packed_lt(self, other: F32x8) -> U32x8 {
+            other.packed_gt(self)
+        }
+
+        #[inline]
+        pub fn packed_le(self, other: F32x8) -> U32x8 {
+            U32x8(self.0.packed_le(other.0), self.1.packed_le(other.1))
+        }
+
+        // Conversions
+
+        /// Converts these packed floats to integers via rounding.
+        #[inline]
+        pub fn to_i32x8(self) -> I32x8 {
+            I32x8(self.0.to_i32x4(), self.1.to_i32x4())
+        }
+    }
+
+    impl Default for F32x8 {
+        #[inline]
+        fn default() -> F32x8 {
+            F32x8(F32x4::default(), F32x4::default())
+        }
+    }
+
+    impl Index<usize> for F32x8 {
+        type Output = f32;
+        #[inline]
+        fn index(&self, index: usize) -> &f32 {
+            if index < 4 {
+                &self.0[index]
+            } else {
+                &self.1[index - 4]
+            }
+        }
+    }
+
+    impl IndexMut<usize> for F32x8 {
+        #[inline]
+        fn index_mut(&mut self, index: usize) -> &mut f32 {
+            if index < 4 {
+                &mut self.0[index]
+            } else {
+                &mut self.1[index - 4]
+            }
+        }
+    }
+
+    impl Debug for F32x8 {
+        #[inline]
+        fn fmt(&self, f: &mut Formatter) -> Result<(), fmt::Error> {
+            write!(f, "<{}, {}, {}, {}, {}, {}, {}, {}>",
+                   self[0], self[1], self[2], self[3], self[4], self[5], self[6], self[7])
+        }
+    }
+
+    impl PartialEq for F32x8 {
+        #[inline]
+        fn eq(&self, other: &F32x8) -> bool {
+            self.packed_eq(*other).all_true()
+        }
+    }
+
+    impl Add<F32x8> for F32x8 {
+        type Output = F32x8;
+        #[inline]
+        fn add(self, other: F32x8) -> F32x8 {
+            F32x8(self.0 + other.0, self.1 + other.1)
+        }
+    }
+
+    impl Div<F32x8> for F32x8 {
+        type Output = F32x8;
+        #[inline]
+        fn div(self, other: F32x8) -> F32x8 {
+            F32x8(self.0 / other.0, self.1 / other.1)
+        }
+    }
+
+    impl Mul<F32x8> for F32x8 {
+        type Output = F32x8;
+        #[inline]
+        fn mul(self, other: F32x8) -> F32x8 {
+            F32x8(self.0 * other.0, self.1 * other.1)
+        }
+    }
+
+    impl Sub<F32x8> for F32x8 {
+        type Output = F32x8;
+        #[inline]
+        fn sub(self, other: F32x8) -> F32x8 {
+            F32x8(self.0 - other.0, self.1 - other.1)
+        }
+    }
+
+    // Eight 32-bit signed integers
+
+    #[derive(Clone, Copy)]
+    pub struct I32x8(pub I32x4, pub I32x4);
+
+    impl I32x8 {
+        // Constructors
+
+        #[inline]
+        pub fn new(a: i32, b: i32, c: i32, d: i32, e: i32, f: i32, g: i32, h: i32) -> I32x8 {
+            I32x8(I32x4::new(a, b, c, d), I32x4::new(e, f, g, h))
+        }
+
+        #[inline]
+        pub fn splat(x: i32) -> I32x8 {
+            I32x8(I32x4::splat(x), I32x4::splat(x))
+        }
+
+        #[inline]
+        pub fn from_halves(lo: I32x4, hi: I32x4) -> I32x8 {
+            I32x8(lo, hi)
+        }
+
+        // Extraction
+
+        #[inline]
+        pub fn lo(self) -> I32x4 {
+            self.0
+        }
+
+        #[inline]
+        pub fn hi(self) -> I32x4 {
+            self.1
+        }
+
+        // Basic operations
+
+        #[inline]
+        pub fn min(self, other: I32x8) -> I32x8 {
+            I32x8(self.0.min(other.0), self.1.min(other.1))
+        }
+
+        #[inline]
+        pub fn max(self, other: I32x8) -> I32x8 {
+            I32x8(self.0.max(other.0), self.1.max(other.1))
+        }
+
+        // Packed comparisons
+
+        #[inline]
+        pub fn packed_eq(self, other: I32x8) -> U32x8 {
+            U32x8(self.0.packed_eq(other.0), self.1.packed_eq(other.1))
+        }
+
+        #[inline]
+        pub fn packed_gt(self, other: I32x8) -> U32x8 {
+            U32x8(self.0.packed_gt(other.0), self.1.packed_gt(other.1))
+        }
+
+        #[inline]
+        pub fn packed_lt(self, other: I32x8) -> U32x8 {
+            other.packed_gt(self)
+        }
+
+        // Conversions
+
+        /// Converts these packed integers to floats.
+        #[inline]
+        pub fn to_f32x8(self) -> F32x8 {
+            F32x8(self.0.to_f32x4(), self.1.to_f32x4())
+        }
+    }
+
+    impl Default for I32x8 {
+        #[inline]
+        fn default() -> I32x8 {
+            I32x8(I32x4::default(), I32x4::default())
+        }
+    }
+
+    impl Index<usize> for I32x8 {
+        type Output = i32;
+        #[inline]
+        fn index(&self, index: usize) -> &i32 {
+            if index < 4 {
+                &self.0[index]
+            } else {
+                &self.1[index - 4]
+            }
+        }
+    }
+
+    impl IndexMut<usize> for I32x8 {
+        #[inline]
+        fn index_mut(&mut self, index: usize) -> &mut i32 {
+            if index < 4 {
+                &mut self.0[index]
+            } else {
+                &mut self.1[index - 4]
+            }
+        }
+    }
+
+    impl Debug for I32x8 {
+        #[inline]
+        fn fmt(&self, f: &mut Formatter) -> Result<(), fmt::Error> {
+            write!(f, "<{}, {}, {}, {}, {}, {}, {}, {}>",
+                   self[0], self[1], self[2], self[3], self[4], self[5], self[6], self[7])
+        }
+    }
+
+    impl PartialEq for I32x8 {
+        #[inline]
+        fn eq(&self, other: &I32x8) -> bool {
+            self.packed_eq(*other).all_true()
+        }
+    }
+
+    impl Add<I32x8> for I32x8 {
+        type Output = I32x8;
+        #[inline]
+        fn add(self, other: I32x8) -> I32x8 {
+            I32x8(self.0 + other.0, self.1 + other.1)
+        }
+    }
+
+    impl Sub<I32x8> for I32x8 {
+        type Output = I32x8;
+        #[inline]
+        fn sub(self, other: I32x8) -> I32x8 {
+            I32x8(self.0 - other.0, self.1 - other.1)
+        }
+    }
+
+    impl Mul<I32x8> for I32x8 {
+        type Output = I32x8;
+        #[inline]
+        fn mul(self, other: I32x8) -> I32x8 {
+            I32x8(self.0 * other.0, self.1 * other.1)
+        }
+    }
+
+    impl BitAnd<I32x8> for I32x8 {
+        type Output = I32x8;
+        #[inline]
+        fn bitand(self, other: I32x8) -> I32x8 {
+            I32x8(self.0 & other.0, self.1 & other.1)
+        }
+    }
+
+    impl BitOr<I32x8> for I32x8 {
+        type Output = I32x8;
+        #[inline]
+        fn bitor(self, other: I32x8) -> I32x8 {
+            I32x8(self.0 | other.0, self.1 | other.1)
+        }
+    }
+
+    // Eight 32-bit unsigned integers
+
+    #[derive(Clone, Copy)]
+    pub struct U32x8(pub U32x4, pub U32x4);
+
+    impl U32x8 {
+        // Constructors
+
+        #[inline]
+        pub fn from_halves(lo: U32x4, hi: U32x4) -> U32x8 {
+            U32x8(lo, hi)
+        }
+
+        // Extraction
+
+        #[inline]
+        pub fn lo(self) -> U32x4 {
+            self.0
+        }
+
+        #[inline]
+        pub fn hi(self) -> U32x4 {
+            self.1
+        }
+
+        // Basic operations
+
+        /// Returns true if all eight booleans in this vector are true.
+        ///
+        /// The result is *undefined* if all eight values in this vector are not booleans. A
+        /// boolean is a value with all bits set or all bits clear (i.e. !0 or 0).
+        #[inline]
+        pub fn all_true(self) -> bool {
+            self.0.all_true() && self.1.all_true()
+        }
+
+        /// Returns true if all eight booleans in this vector are false.
+        ///
+        /// The result is *undefined* if all eight values in this vector are not booleans. A
+        /// boolean is a value with all bits set or all bits clear (i.e. !0 or 0).
+        #[inline]
+        pub fn all_false(self) -> bool {
+            self.0.all_false() && self.1.all_false()
+        }
+    }
+
+    impl Debug for U32x8 {
+        #[inline]
+        fn fmt(&self, f: &mut Formatter) -> Result<(), fmt::Error> {
+            write!(f, "<{}, {}, {}, {}, {}, {}, {}, {}>",
+                   self.0[0], self.0[1], self.0[2], self.0[3],
+                   self.1[0], self.1[1], self.1[2], self.1[3])
+        }
+    }
+
+    impl PartialEq for U32x8 {
+        #[inline]
+        fn eq(&self, other: &U32x8) -> bool {
+            (0..4).all(|index| {
+                self.0[index] == other.0[index] && self.1[index] == other.1[index]
+            })
+        }
+    }
+}
+
+#[cfg(all(
+    not(feature = "pf-no-simd"),
+    any(target_arch = "x86", target_arch = "x86_64"),
+    target_feature = "avx2"
+))]
+mod avx2 {
+    use crate::default::{F32x4, I32x4, U32x4};
+    use std::fmt::{self, Debug, Formatter};
+    use std::mem;
+    use std::ops::{Add, BitAnd, BitOr, Div, Index, IndexMut, Mul, Sub};
+
+    #[cfg(target_pointer_width = "32")]
+    use std::arch::x86::{__m256, __m256i};
+    #[cfg(target_pointer_width = "32")]
+    use std::arch::x86;
+    #[cfg(target_pointer_width = "64")]
+    use std::arch::x86_64::{__m256, __m256i};
+    #[cfg(target_pointer_width = "64")]
+    use std::arch::x86_64 as x86;
+
+    // Eight 32-bit floats
+
+    #[derive(Clone, Copy)]
+    pub struct F32x8(pub __m256);
+
+    impl F32x8 {
+        // Constructors
+
+        #[inline]
+        pub fn new(a: f32, b: f32, c: f32, d: f32, e: f32, f: f32, g: f32, h: f32) -> F32x8 {
+            unsafe {
+                let vector = [a, b, c, d, e, f, g, h];
+                F32x8(x86::_mm256_loadu_ps(vector.as_ptr()))
+            }
+        }
+
+        #[inline]
+        pub fn splat(x: f32) -> F32x8 {
+            unsafe { F32x8(x86::_mm256_set1_ps(x)) }
+        }
+
+        #[inline]
+        pub fn from_halves(lo: F32x4, hi: F32x4) -> F32x8 {
+            unsafe { F32x8(x86::_mm256_set_m128(hi.0, lo.0)) }
+        }
+
+        // Extraction
+
+        #[inline]
+        pub fn lo(self) -> F32x4 {
+            unsafe { F32x4(x86::_mm256_castps256_ps128(self.0)) }
+        }
+
+        #[inline]
+        pub fn hi(self) -> F32x4 {
+            unsafe { F32x4(x86::_mm256_extractf128_ps::<1>(self.0)) }
+        }
+
+        // Basic operations
+
+        #[inline]
+        pub fn approx_recip(self) -> F32x8 {
+            unsafe { F32x8(x86::_mm256_rcp_ps(self.0)) }
+        }
+
+        #[inline]
+        pub fn min(self, other: F32x8) -> F32x8 {
+            unsafe { F32x8(x86::_mm256_min_ps(self.0, other.0)) }
+        }
+
+        #[inline]
+        pub fn max(self, other: F32x8) -> F32x8 {
+            unsafe { F32x8(x86::_mm256_max_ps(self.0, other.0)) }
+        }
+
+        #[inline]
+        pub fn clamp(self, min: F32x8, max: F32x8) -> F32x8 {
+            self.max(min).min(max)
+        }
+
+        #[inline]
+        pub fn abs(self) -> F32x8 {
+            unsafe {
+                let tmp = x86::_mm256_srli_epi32::<1>(I32x8::splat(-1).0);
+                F32x8(x86::_mm256_and_ps(x86::_mm256_castsi256_ps(tmp), self.0))
+            }
+        }
+
+        #[inline]
+        pub fn floor(self) -> F32x8 {
+            unsafe { F32x8(x86::_mm256_floor_ps(self.0)) }
+        }
+
+        #[inline]
+        pub fn ceil(self) -> F32x8 {
+            unsafe { F32x8(x86::_mm256_ceil_ps(self.0)) }
+        }
+
+        #[inline]
+        pub fn sqrt(self) -> F32x8 {
+            unsafe { F32x8(x86::_mm256_sqrt_ps(self.0)) }
+        }
+
+        // Packed comparisons
+
+        #[inline]
+        pub fn packed_eq(self, other: F32x8) -> U32x8 {
+            unsafe {
+                U32x8(x86::_mm256_castps_si256(x86::_mm256_cmp_ps::<{ x86::_CMP_EQ_OQ }>(
+                    self.0, other.0,
+                )))
+            }
+        }
+
+        #[inline]
+        pub fn packed_gt(self, other: F32x8) -> U32x8 {
+            unsafe {
+                U32x8(x86::_mm256_castps_si256(x86::_mm256_cmp_ps::<{ x86::_CMP_GT_OQ }>(
+                    self.0, other.0,
+                )))
+            }
+        }
+
+        #[inline]
+        pub fn packed_lt(self, other: F32x8) -> U32x8 {
+            other.packed_gt(self)
+        }
+
+        #[inline]
+        pub fn packed_le(self, other: F32x8) -> U32x8 {
+            unsafe {
+                U32x8(x86::_mm256_castps_si256(x86::_mm256_cmp_ps::<{ x86::_CMP_LE_OQ }>(
+                    self.0, other.0,
+                )))
+            }
+        }
+
+        // Conversions
+
+        /// Converts these packed floats to integers via rounding.
+        #[inline]
+        pub fn to_i32x8(self) -> I32x8 {
+            unsafe { I32x8(x86::_mm256_cvtps_epi32(self.0)) }
+        }
+    }
+
+    impl Default for F32x8 {
+        #[inline]
+        fn default() -> F32x8 {
+            unsafe { F32x8(x86::_mm256_setzero_ps()) }
+        }
+    }
+
+    impl Index<usize> for F32x8 {
+        type Output = f32;
+        #[inline]
+        fn index(&self, index: usize) -> &f32 {
+            unsafe { &mem::transmute::<&__m256, &[f32; 8]>(&self.0)[index] }
+        }
+    }
+
+    impl IndexMut<usize> for F32x8 {
+        #[inline]
+        fn index_mut(&mut self, index: usize) -> &mut f32 {
+            unsafe { &mut mem::transmute::<&mut __m256, &mut [f32; 8]>(&mut self.0)[index] }
+        }
+    }
+
+    impl Debug for F32x8 {
+        #[inline]
+        fn fmt(&self, f: &mut Formatter) -> Result<(), fmt::Error> {
+            write!(f, "<{}, {}, {}, {}, {}, {}, {}, {}>",
+                   self[0], self[1], self[2], self[3], self[4], self[5], self[6], self[7])
+        }
+    }
+
+    impl PartialEq for F32x8 {
+        #[inline]
+        fn eq(&self, other: &F32x8) -> bool {
+            self.packed_eq(*other).all_true()
+        }
+    }
+
+    impl Add<F32x8> for F32x8 {
+        type Output = F32x8;
+        #[inline]
+        fn add(self, other: F32x8) -> F32x8 {
+            unsafe { F32x8(x86::_mm256_add_ps(self.0, other.0)) }
+        }
+    }
+
+    impl Div<F32x8> for F32x8 {
+        type Output = F32x8;
+        #[inline]
+        fn div(self, other: F32x8) -> F32x8 {
+            unsafe { F32x8(x86::_mm256_div_ps(self.0, other.0)) }
+        }
+    }
+
+    impl Mul<F32x8> for F32x8 {
+        type Output = F32x8;
+        #[inline]
+        fn mul(self, other: F32x8) -> F32x8 {
+            unsafe { F32x8(x86::_mm256_mul_ps(self.0, other.0)) }
+        }
+    }
+
+    impl Sub<F32x8> for F32x8 {
+        type Output = F32x8;
+        #[inline]
+        fn sub(self, other: F32x8) -> F32x8 {
+            unsafe { F32x8(x86::_mm256_sub_ps(self.0, other.0)) }
+        }
+    }
+
+    // Eight 32-bit signed integers
+
+    #[derive(Clone, Copy)]
+    pub struct I32x8(pub __m256i);
+
+    impl I32x8 {
+        // Constructors
+
+        #[inline]
+        pub fn new(a: i32, b: i32, c: i32, d: i32, e: i32, f: i32, g: i32, h: i32) -> I32x8 {
+            unsafe {
+                let vector = [a, b, c, d, e, f, g, h];
+                I32x8(x86::_mm256_loadu_si256(vector.as_ptr() as *const __m256i))
+            }
+        }
+
+        #[inline]
+        pub fn splat(x: i32) -> I32x8 {
+            unsafe { I32x8(x86::_mm256_set1_epi32(x)) }
+        }
+
+        #[inline]
+        pub fn from_halves(lo: I32x4, hi: I32x4) -> I32x8 {
+            unsafe { I32x8(x86::_mm256_set_m128i(hi.0, lo.0)) }
+        }
+
+        // Extraction
+
+        #[inline]
+        pub fn lo(self) -> I32x4 {
+            unsafe { I32x4(x86::_mm256_castsi256_si128(self.0)) }
+        }
+
+        #[inline]
+        pub fn hi(self) -> I32x4 {
+            unsafe { I32x4(x86::_mm256_extracti128_si256::<1>(self.0)) }
+        }
+
+        // Basic operations
+
+        #[inline]
+        pub fn min(self, other: I32x8) -> I32x8 {
+            unsafe { I32x8(x86::_mm256_min_epi32(self.0, other.0)) }
+        }
+
+        #[inline]
+        pub fn max(self, other: I32x8) -> I32x8 {
+            unsafe { I32x8(x86::_mm256_max_epi32(self.0, other.0)) }
+        }
+
+        // Packed comparisons
+
+        #[inline]
+        pub fn packed_eq(self, other: I32x8) -> U32x8 {
+            unsafe { U32x8(x86::_mm256_cmpeq_epi32(self.0, other.0)) }
+        }
+
+        #[inline]
+        pub fn packed_gt(self, other: I32x8) -> U32x8 {
+            unsafe { U32x8(x86::_mm256_cmpgt_epi32(self.0, other.0)) }
+        }
+
+        #[inline]
+        pub fn packed_lt(self, other: I32x8) -> U32x8 {
+            other.packed_gt(self)
+        }
+
+        // Conversions
+
+        /// Converts these packed integers to floats.
+        #[inline]
+        pub fn to_f32x8(self) -> F32x8 {
+            unsafe { F32x8(x86::_mm256_cvtepi32_ps(self.0)) }
+        }
+    }
+
+    impl Default for I32x8 {
+        #[inline]
+        fn default() -> I32x8 {
+            unsafe { I32x8(x86::_mm256_setzero_si256()) }
+        }
+    }
+
+    impl Index<usize> for I32x8 {
+        type Output = i32;
+        #[inline]
+        fn index(&self, index: usize) -> &i32 {
+            unsafe { &mem::transmute::<&__m256i, &[i32; 8]>(&self.0)[index] }
+        }
+    }
+
+    impl IndexMut<usize> for I32x8 {
+        #[inline]
+        fn index_mut(&mut self, index: usize) -> &mut i32 {
+            unsafe { &mut mem::transmute::<&mut __m256i, &mut [i32; 8]>(&mut self.0)[index] }
+        }
+    }
+
+    impl Debug for I32x8 {
+        #[inline]
+        fn fmt(&self, f: &mut Formatter) -> Result<(), fmt::Error> {
+            write!(f, "<{}, {}, {}, {}, {}, {}, {}, {}>",
+                   self[0], self[1], self[2], self[3], self[4], self[5], self[6], self[7])
+        }
+    }
+
+    impl PartialEq for I32x8 {
+        #[inline]
+        fn eq(&self, other: &I32x8) -> bool {
+            self.packed_eq(*other).all_true()
+        }
+    }
+
+    impl Add<I32x8> for I32x8 {
+        type Output = I32x8;
+        #[inline]
+        fn add(self, other: I32x8) -> I32x8 {
+            unsafe { I32x8(x86::_mm256_add_epi32(self.0, other.0)) }
+        }
+    }
+
+    impl Sub<I32x8> for I32x8 {
+        type Output = I32x8;
+        #[inline]
+        fn sub(self, other: I32x8) -> I32x8 {
+            unsafe { I32x8(x86::_mm256_sub_epi32(self.0, other.0)) }
+        }
+    }
+
+    impl Mul<I32x8> for I32x8 {
+        type Output = I32x8;
+        #[inline]
+        fn mul(self, other: I32x8) -> I32x8 {
+            unsafe { I32x8(x86::_mm256_mullo_epi32(self.0, other.0)) }
+        }
+    }
+
+    impl BitAnd<I32x8> for I32x8 {
+        type Output = I32x8;
+        #[inline]
+        fn bitand(self, other: I32x8) -> I32x8 {
+            unsafe { I32x8(x86::_mm256_and_si256(self.0, other.0)) }
+        }
+    }
+
+    impl BitOr<I32x8> for I32x8 {
+        type Output = I32x8;
+        #[inline]
+        fn bitor(self, other: I32x8) -> I32x8 {
+            unsafe { I32x8(x86::_mm256_or_si256(self.0, other.0)) }
+        }
+    }
+
+    // Eight 32-bit unsigned integers
+
+    #[derive(Clone, Copy)]
+    pub struct U32x8(pub __m256i);
+
+    impl U32x8 {
+        // Constructors
+
+        #[inline]
+        pub fn from_halves(lo: U32x4, hi: U32x4) -> U32x8 {
+            unsafe { U32x8(x86::_mm256_set_m128i(hi.0, lo.0)) }
+        }
+
+        // Extraction
+
+        #[inline]
+        pub fn lo(self) -> U32x4 {
+            unsafe { U32x4(x86::_mm256_castsi256_si128(self.0)) }
+        }
+
+        #[inline]
+        pub fn hi(self) -> U32x4 {
+            unsafe { U32x4(x86::_mm256_extracti128_si256::<1>(self.0)) }
+        }
+
+        // Basic operations
+
+        /// Returns true if all eight booleans in this vector are true.
+        ///
+        /// The result is *undefined* if all eight values in this vector are not booleans. A
+        /// boolean is a value with all bits set or all bits clear (i.e. !0 or 0).
+        #[inline]
+        pub fn all_true(self) -> bool {
+            unsafe { x86::_mm256_movemask_ps(x86::_mm256_castsi256_ps(self.0)) == 0xff }
+        }
+
+        /// Returns true if all eight booleans in this vector are false.
+        ///
+        /// The result is *undefined* if all eight values in this vector are not booleans. A
+        /// boolean is a value with all bits set or all bits clear (i.e. !0 or 0).
+        #[inline]
+        pub fn all_false(self) -> bool {
+            unsafe { x86::_mm256_movemask_ps(x86::_mm256_castsi256_ps(self.0)) == 0x00 }
+        }
+    }
+
+    impl Debug for U32x8 {
+        #[inline]
+        fn fmt(&self, f: &mut Formatter) -> Result<(), fmt::Error> {
+            let (lo, hi) = (self.lo(), self.hi());
+            write!(f, "<{}, {}, {}, {}, {}, {}, {}, {}>",
+                   lo[0], lo[1], lo[2], lo[3], hi[0], hi[1], hi[2], hi[3])
+        }
+    }
+
+    impl PartialEq for U32x8 {
+        #[inline]
+        fn eq(&self, other: &U32x8) -> bool {
+            unsafe {
+                let equal = x86::_mm256_cmpeq_epi32(self.0, other.0);
+                x86::_mm256_movemask_ps(x86::_mm256_castsi256_ps(equal)) == 0xff
+            }
+        }
+    }
+}
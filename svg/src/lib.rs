@@ -26,10 +26,12 @@ use pathfinder_geometry::line_segment::LineSegment2F;
 use pathfinder_geometry::rect::RectF;
 use pathfinder_geometry::transform2d::Transform2F;
 use pathfinder_geometry::vector::{Vector2F, vec2f};
-use pathfinder_renderer::paint::Paint;
+use pathfinder_renderer::concurrent::executor::{Executor, SequentialExecutor};
+use pathfinder_renderer::paint::{Paint, PaintId};
 use pathfinder_renderer::scene::{ClipPath, ClipPathId, DrawPath, Scene};
 use pathfinder_simd::default::F32x2;
 use std::fmt::{Display, Formatter, Result as FormatResult};
+use std::mem;
 use usvg::{BaseGradient, Color as SvgColor, FillRule as UsvgFillRule, LineCap as UsvgLineCap};
 use usvg::{LineJoin as UsvgLineJoin, Node, NodeExt, NodeKind, Opacity, Paint as UsvgPaint};
 use usvg::{PathSegment as UsvgPathSegment, Rect as UsvgRect, SpreadMethod, Stop};
@@ -42,6 +44,9 @@ pub struct SVGScene {
     pub result_flags: BuildResultFlags,
     pub clip_paths: HashMap<String, Outline>,
     gradients: HashMap<String, GradientInfo>,
+    // Draw paths whose geometry conversion has been deferred so it can run in parallel after the
+    // tree walk.
+    pending_draw_paths: Vec<PendingDrawPath>,
 }
 
 bitflags! {
@@ -67,7 +72,21 @@ impl SVGScene {
     }
 
     // TODO(pcwalton): Allow a global transform to be set.
+    #[inline]
     pub fn from_tree_and_scene(tree: &Tree, scene: Scene) -> SVGScene {
+        SVGScene::from_tree_and_scene_with_executor(tree, scene, &SequentialExecutor)
+    }
+
+    /// Like `from_tree_and_scene()`, but converts path geometry in parallel using the given
+    /// executor.
+    ///
+    /// The usvg tree itself is walked on the calling thread, because usvg nodes can't cross
+    /// threads, but the expensive per-path work—flattening segments into outlines, dashing,
+    /// stroke-to-fill conversion, and transform application—is farmed out through the executor.
+    /// Pass a `RayonExecutor` to scale SVG loading with cores.
+    pub fn from_tree_and_scene_with_executor<E>(tree: &Tree, scene: Scene, executor: &E)
+                                                -> SVGScene
+                                                where E: Executor {
         // TODO(pcwalton): Maybe have a `SVGBuilder` type to hold the clip path IDs and other
         // transient data separate from `SVGScene`?
         let mut built_svg = SVGScene {
@@ -75,6 +94,7 @@ impl SVGScene {
             result_flags: BuildResultFlags::empty(),
             clip_paths: HashMap::new(),
             gradients: HashMap::new(),
+            pending_draw_paths: vec![],
         };
 
         let root = &tree.root();
@@ -88,6 +108,20 @@ impl SVGScene {
             _ => unreachable!(),
         }
 
+        // Convert the geometry of all deferred draw paths, in parallel if the executor allows,
+        // and push them in document order.
+        let pending_draw_paths = mem::replace(&mut built_svg.pending_draw_paths, vec![]);
+        let outlines = executor.build_vector(pending_draw_paths.len(), |path_index| {
+            pending_draw_paths[path_index].build_outline()
+        });
+        for (pending_draw_path, outline) in pending_draw_paths.into_iter().zip(outlines) {
+            let mut path = DrawPath::new(outline, pending_draw_path.paint_id);
+            path.set_clip_path(pending_draw_path.clip_path);
+            path.set_fill_rule(pending_draw_path.fill_rule);
+            path.set_name(pending_draw_path.name);
+            built_svg.scene.push_draw_path(path);
+        }
+
         built_svg
     }
 
@@ -133,16 +167,14 @@ impl SVGScene {
             NodeKind::Path(ref path) if state.path_destination == PathDestination::Draw &&
                     path.visibility == Visibility::Visible => {
                 if let Some(ref fill) = path.fill {
-                    let path = UsvgPathToSegments::new(path.data.iter().cloned());
-                    let outline = Outline::from_segments(path);
-
                     let name = format!("Fill({})", node.id());
-                    self.push_draw_path(outline,
-                                        name,
-                                        &state,
-                                        &fill.paint,
-                                        fill.opacity,
-                                        fill.rule);
+                    self.defer_draw_path(path.data.iter().cloned().collect(),
+                                         None,
+                                         name,
+                                         &state,
+                                         &fill.paint,
+                                         fill.opacity,
+                                         fill.rule);
                 }
 
                 if let Some(ref stroke) = path.stroke {
@@ -153,27 +185,18 @@ impl SVGScene {
                                                                  stroke.miterlimit.value() as f32),
                     };
 
-                    let path = UsvgPathToSegments::new(path.data.iter().cloned());
-                    let mut outline = Outline::from_segments(path);
-
-                    if let Some(ref dash_array) = stroke.dasharray {
-                        let dash_array: Vec<f32> = dash_array.iter().map(|&x| x as f32).collect();
-                        let mut dash = OutlineDash::new(&outline, &dash_array, stroke.dashoffset);
-                        dash.dash();
-                        outline = dash.into_outline();
-                    }
-
-                    let mut stroke_to_fill = OutlineStrokeToFill::new(&outline, stroke_style);
-                    stroke_to_fill.offset();
-                    let outline = stroke_to_fill.into_outline();
+                    let dash = stroke.dasharray.as_ref().map(|dash_array| {
+                        (dash_array.iter().map(|&x| x as f32).collect(), stroke.dashoffset)
+                    });
 
                     let name = format!("Stroke({})", node.id());
-                    self.push_draw_path(outline,
-                                        name,
-                                        &state,
-                                        &stroke.paint,
-                                        stroke.opacity,
-                                        UsvgFillRule::NonZero);
+                    self.defer_draw_path(path.data.iter().cloned().collect(),
+                                         Some(PendingStroke { style: stroke_style, dash }),
+                                         name,
+                                         &state,
+                                         &stroke.paint,
+                                         stroke.opacity,
+                                         UsvgFillRule::NonZero);
                 }
             }
             NodeKind::Path(..) => {}
@@ -264,26 +287,71 @@ impl SVGScene {
         self.gradients.insert(id, GradientInfo { gradient, transform });
     }
 
-    fn push_draw_path(&mut self,
-                      mut outline: Outline,
-                      name: String,
-                      state: &State,
-                      paint: &UsvgPaint,
-                      opacity: Opacity,
-                      fill_rule: UsvgFillRule) {
-        outline.transform(&state.transform);
+    // Resolves everything about a draw path except its geometry, which is deferred so that all
+    // paths' geometry can be converted in parallel once the tree walk finishes. Paints must be
+    // resolved here because they depend on the gradients seen so far in the walk.
+    fn defer_draw_path(&mut self,
+                       segments: Vec<UsvgPathSegment>,
+                       stroke: Option<PendingStroke>,
+                       name: String,
+                       state: &State,
+                       paint: &UsvgPaint,
+                       opacity: Opacity,
+                       fill_rule: UsvgFillRule) {
         let paint = Paint::from_svg_paint(paint,
                                           &state.transform,
                                           opacity,
                                           &self.gradients,
                                           &mut self.result_flags);
-        let style = self.scene.push_paint(&paint);
-        let fill_rule = FillRule::from_usvg_fill_rule(fill_rule);
-        let mut path = DrawPath::new(outline, style);
-        path.set_clip_path(state.clip_path);
-        path.set_fill_rule(fill_rule);
-        path.set_name(name);
-        self.scene.push_draw_path(path);
+        let paint_id = self.scene.push_paint(&paint);
+        self.pending_draw_paths.push(PendingDrawPath {
+            segments,
+            stroke,
+            transform: state.transform,
+            paint_id,
+            fill_rule: FillRule::from_usvg_fill_rule(fill_rule),
+            clip_path: state.clip_path,
+            name,
+        });
+    }
+}
+
+// A draw path from the SVG tree whose geometry conversion has been deferred. Everything here is
+// plain data, so outlines can be built on executor worker threads.
+struct PendingDrawPath {
+    segments: Vec<UsvgPathSegment>,
+    stroke: Option<PendingStroke>,
+    transform: Transform2F,
+    paint_id: PaintId,
+    fill_rule: FillRule,
+    clip_path: Option<ClipPathId>,
+    name: String,
+}
+
+struct PendingStroke {
+    style: StrokeStyle,
+    dash: Option<(Vec<f32>, f32)>,
+}
+
+impl PendingDrawPath {
+    fn build_outline(&self) -> Outline {
+        let segments = UsvgPathToSegments::new(self.segments.iter().cloned());
+        let mut outline = Outline::from_segments(segments);
+
+        if let Some(ref stroke) = self.stroke {
+            if let Some((ref dash_array, dash_offset)) = stroke.dash {
+                let mut dash = OutlineDash::new(&outline, dash_array, dash_offset);
+                dash.dash();
+                outline = dash.into_outline();
+            }
+
+            let mut stroke_to_fill = OutlineStrokeToFill::new(&outline, stroke.style);
+            stroke_to_fill.offset();
+            outline = stroke_to_fill.into_outline();
+        }
+
+        outline.transform(&self.transform);
+        outline
     }
 }
 
@@ -21,8 +21,11 @@ use swf_types::{Tag, SRgb8, Movie};
 
 use crate::shapes::{GraphicLayers, PaintOrLine};
 
+mod player;
 mod shapes;
 
+pub use crate::player::Player;
+
 type SymbolId = u16;
 
 // In swf, most values are specified in a fixed point format known as "twips" or twentieths of
@@ -0,0 +1,531 @@
+// pathfinder/swf/src/player.rs
+//
+// Copyright © 2020 The Pathfinder Project Developers.
+//
+// Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+// http://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+// <LICENSE-MIT or http://opensource.org/licenses/MIT>, at your
+// option. This file may not be copied, modified, or distributed
+// except according to those terms.
+
+//! Streaming SWF playback that keeps a persistent scene up to date.
+//!
+//! Rather than converting a whole movie into scene geometry up front, `Player` walks the tag
+//! stream one frame at a time and mutates a `Scene` in place: placing a character pushes draw
+//! paths, moving one retransforms the paths it already owns, and removing one empties its
+//! slots. The cost of advancing a frame therefore tracks the size of the display-list diff,
+//! not the size of the scene, which is what makes long looping animations cheap to play back.
+//!
+//! The player assumes it is the only thing adding draw paths to the scene, since it relies on
+//! draw path IDs matching the drawing order.
+
+use crate::shapes::{self, PaintOrLine};
+use crate::{Point2, Stage, Symbol, SymbolId, SymbolLibrary, Twips};
+use pathfinder_content::fill::FillRule;
+use pathfinder_content::outline::{Contour, Outline};
+use pathfinder_content::stroke::{OutlineStrokeToFill, StrokeStyle};
+use pathfinder_geometry::transform2d::Transform2F;
+use pathfinder_geometry::vector::vec2f;
+use pathfinder_renderer::scene::{DrawPath, DrawPathId, Scene};
+use std::collections::BTreeMap;
+use std::mem;
+use std::ops::Bound;
+use swf_types::tags::{PlaceObject, RemoveObject, SetBackgroundColor};
+use swf_types::{Matrix, Movie, Tag};
+
+/// Plays a movie back by incrementally updating a scene.
+pub struct Player {
+    movie: Movie,
+    symbol_library: SymbolLibrary,
+    stage: Stage,
+    next_tag_index: usize,
+    display_list: BTreeMap<u16, Placement>,
+    free_slots: Vec<DrawPathId>,
+}
+
+// A character currently on the display list, along with the scene slots its geometry occupies.
+struct Placement {
+    symbol_id: SymbolId,
+    transform: Transform2F,
+    draw_path_ids: Vec<DrawPathId>,
+}
+
+// Where the draw paths of a new placement should go in the scene.
+enum SlotAssignment {
+    // Reuse these freed slots, which lie between the placement's depth neighbors.
+    Reuse(Vec<DrawPathId>),
+    // The placement is above everything else; push fresh paths on top.
+    PushOnTop,
+    // There's no way to splice the placement in; the whole display list must be re-placed.
+    Rebuild,
+}
+
+impl Player {
+    /// Creates a player for the given movie.
+    ///
+    /// No tags are processed until `advance()` is called, so definitions interleaved with
+    /// frames are handled as playback reaches them.
+    pub fn new(movie: Movie) -> Player {
+        let stage_width = Twips(movie.header.frame_size.x_max);
+        let stage_height = Twips(movie.header.frame_size.y_max);
+        let stage = Stage {
+            background_color: swf_types::SRgb8 { r: 255, g: 255, b: 255 },
+            width: stage_width.as_f32() as i32,
+            height: stage_height.as_f32() as i32,
+        };
+        Player {
+            movie,
+            symbol_library: SymbolLibrary(Vec::new()),
+            stage,
+            next_tag_index: 0,
+            display_list: BTreeMap::new(),
+            free_slots: vec![],
+        }
+    }
+
+    /// Returns the stage metadata parsed so far.
+    ///
+    /// The background color isn't known until the `SetBackgroundColor` tag has been processed,
+    /// which normally happens on the first `advance()`.
+    #[inline]
+    pub fn stage(&self) -> &Stage {
+        &self.stage
+    }
+
+    /// Advances playback by one frame, applying the display-list diff to the scene.
+    ///
+    /// Returns false if the tag stream was already exhausted, in which case the scene is left
+    /// untouched. Call `rewind()` to loop.
+    pub fn advance(&mut self, scene: &mut Scene) -> bool {
+        let tags = mem::replace(&mut self.movie.tags, vec![]);
+        let mut frame_complete = false;
+        while self.next_tag_index < tags.len() && !frame_complete {
+            frame_complete = self.process_tag(&tags[self.next_tag_index], scene);
+            self.next_tag_index += 1;
+        }
+        self.movie.tags = tags;
+        frame_complete
+    }
+
+    /// Restarts playback from the first frame, emptying everything the player placed in the
+    /// scene. Call this when `advance()` returns false to loop the movie.
+    pub fn rewind(&mut self, scene: &mut Scene) {
+        let display_list = mem::replace(&mut self.display_list, BTreeMap::new());
+        for placement in display_list.values() {
+            for &draw_path_id in &placement.draw_path_ids {
+                scene.remove_draw_path(draw_path_id);
+                self.free_slot(draw_path_id);
+            }
+        }
+        self.next_tag_index = 0;
+    }
+
+    /// Processes a single tag, applying any display-list change to the scene.
+    ///
+    /// Callers that stream tags from `swf_parser` as they arrive can use this directly instead
+    /// of `advance()`. Returns true when the tag completes a frame.
+    pub fn process_tag(&mut self, tag: &Tag, scene: &mut Scene) -> bool {
+        match *tag {
+            Tag::SetBackgroundColor(SetBackgroundColor { color }) => {
+                self.stage.background_color = color;
+            }
+            Tag::DefineShape(ref shape) => {
+                // Tags are revisited when playback loops, so only define each symbol once. As
+                // in `process_swf_tags()`, symbol IDs are assumed to be sequential and 1-based.
+                if shape.id as usize == self.symbol_library.0.len() + 1 {
+                    self.symbol_library.add_symbol(Symbol::Graphic(shapes::decode_shape(shape)));
+                }
+            }
+            Tag::PlaceObject(ref place_object) => self.place_object(scene, place_object),
+            Tag::RemoveObject(ref remove_object) => self.remove_object(scene, remove_object),
+            Tag::ShowFrame => return true,
+            _ => {}
+        }
+        false
+    }
+
+    fn place_object(&mut self, scene: &mut Scene, place_object: &PlaceObject) {
+        let depth = place_object.depth;
+        let new_transform = place_object.matrix.as_ref().map(matrix_to_transform);
+
+        // An update (`is_move` in the SWF spec) that doesn't name a new character is a pure
+        // move: retransform the paths already in the scene rather than rebuilding them. The
+        // same applies to an update that re-states the character already at this depth.
+        let is_move = match (self.display_list.get(&depth), place_object.character_id) {
+            (Some(_), None) => place_object.is_update,
+            (Some(placement), Some(character_id)) => {
+                place_object.is_update && placement.symbol_id == character_id
+            }
+            (None, _) => false,
+        };
+        if is_move {
+            if let Some(new_transform) = new_transform {
+                let placement = self.display_list.get_mut(&depth).unwrap();
+                let delta = new_transform * placement.transform.inverse();
+                placement.transform = new_transform;
+                for &draw_path_id in &placement.draw_path_ids {
+                    scene.transform_draw_path(draw_path_id, &delta);
+                }
+            }
+            return;
+        }
+
+        // Everything else needs a character to place.
+        let symbol_id = match place_object.character_id {
+            Some(character_id) => character_id,
+            None => return,
+        };
+
+        // Replacing a character frees its slots first, so the new one can take them over and
+        // keep the drawing order.
+        let transform = new_transform.unwrap_or_default();
+        if let Some(old_placement) = self.display_list.remove(&depth) {
+            for &draw_path_id in &old_placement.draw_path_ids {
+                scene.remove_draw_path(draw_path_id);
+                self.free_slot(draw_path_id);
+            }
+        }
+
+        self.place_symbol(scene, depth, symbol_id, transform);
+    }
+
+    fn remove_object(&mut self, scene: &mut Scene, remove_object: &RemoveObject) {
+        if let Some(placement) = self.display_list.remove(&remove_object.depth) {
+            // The slots stay in the scene as empty paths, so all other IDs remain stable.
+            for &draw_path_id in &placement.draw_path_ids {
+                scene.remove_draw_path(draw_path_id);
+                self.free_slot(draw_path_id);
+            }
+        }
+    }
+
+    fn place_symbol(&mut self,
+                    scene: &mut Scene,
+                    depth: u16,
+                    symbol_id: SymbolId,
+                    transform: Transform2F) {
+        let draw_paths = build_symbol_draw_paths(&self.symbol_library,
+                                                symbol_id,
+                                                &transform,
+                                                scene);
+        let draw_path_ids = match self.assign_slots(depth, draw_paths.len()) {
+            SlotAssignment::Reuse(draw_path_ids) => {
+                for (&draw_path_id, draw_path) in draw_path_ids.iter().zip(draw_paths) {
+                    scene.replace_draw_path(draw_path_id, draw_path);
+                }
+                draw_path_ids
+            }
+            SlotAssignment::PushOnTop => {
+                draw_paths.into_iter().map(|draw_path| scene.push_draw_path(draw_path)).collect()
+            }
+            SlotAssignment::Rebuild => {
+                self.display_list.insert(depth, Placement {
+                    symbol_id,
+                    transform,
+                    draw_path_ids: vec![],
+                });
+                self.rebuild(scene);
+                return;
+            }
+        };
+        self.display_list.insert(depth, Placement { symbol_id, transform, draw_path_ids });
+    }
+
+    // Finds scene slots for `count` new draw paths at `depth` such that path ID order (which
+    // is the drawing order) matches depth order. Freed slots between the depth neighbors are
+    // reused, so churning placements don't grow the scene.
+    fn assign_slots(&mut self, depth: u16, count: usize) -> SlotAssignment {
+        let lower_bound = self.display_list
+                              .range(..depth)
+                              .rev()
+                              .filter_map(|(_, placement)| placement.draw_path_ids.last())
+                              .next()
+                              .map(|draw_path_id| draw_path_id.0 + 1)
+                              .unwrap_or(0);
+        let upper_bound = self.display_list
+                              .range((Bound::Excluded(depth), Bound::Unbounded))
+                              .filter_map(|(_, placement)| placement.draw_path_ids.first())
+                              .next()
+                              .map(|draw_path_id| draw_path_id.0);
+
+        let candidates: Vec<DrawPathId> =
+            self.free_slots
+                .iter()
+                .copied()
+                .filter(|draw_path_id| {
+                    draw_path_id.0 >= lower_bound &&
+                        upper_bound.map_or(true, |upper_bound| draw_path_id.0 < upper_bound)
+                })
+                .take(count)
+                .collect();
+        if candidates.len() == count {
+            self.free_slots.retain(|draw_path_id| !candidates.contains(draw_path_id));
+            return SlotAssignment::Reuse(candidates);
+        }
+
+        if upper_bound.is_none() {
+            return SlotAssignment::PushOnTop;
+        }
+        SlotAssignment::Rebuild
+    }
+
+    // The slow path: empties every slot the player owns and re-places all characters in depth
+    // order. This only happens when a character is placed below existing ones and no freed
+    // slots can accommodate it.
+    fn rebuild(&mut self, scene: &mut Scene) {
+        let mut freed_slots = vec![];
+        for placement in self.display_list.values_mut() {
+            freed_slots.append(&mut placement.draw_path_ids);
+        }
+        for &draw_path_id in &freed_slots {
+            scene.remove_draw_path(draw_path_id);
+            self.free_slot(draw_path_id);
+        }
+
+        let depths: Vec<u16> = self.display_list.keys().copied().collect();
+        for depth in depths {
+            let (symbol_id, transform) = {
+                let placement = &self.display_list[&depth];
+                (placement.symbol_id, placement.transform)
+            };
+            // With every slot free and depths processed in ascending order, each placement
+            // reuses freed slots, so this can't recurse.
+            self.place_symbol(scene, depth, symbol_id, transform);
+        }
+    }
+
+    fn free_slot(&mut self, draw_path_id: DrawPathId) {
+        let index = self.free_slots
+                        .binary_search_by_key(&draw_path_id.0, |draw_path_id| draw_path_id.0)
+                        .unwrap_or_else(|index| index);
+        self.free_slots.insert(index, draw_path_id);
+    }
+}
+
+// Converts a symbol's layers into transformed draw paths, ready to be spliced into the scene.
+#[allow(irrefutable_let_patterns)]
+fn build_symbol_draw_paths(symbol_library: &SymbolLibrary,
+                           symbol_id: SymbolId,
+                           transform: &Transform2F,
+                           scene: &mut Scene)
+                           -> Vec<DrawPath> {
+    // Symbol IDs are 1-based.
+    let symbol = &symbol_library.0[symbol_id as usize - 1];
+    let mut draw_paths = vec![];
+    if let Symbol::Graphic(graphic) = symbol {
+        for style_layer in graphic.layers() {
+            let mut path = Outline::new();
+            let paint_id = scene.push_paint(style_layer.fill());
+
+            for shape in style_layer.shapes() {
+                let mut contour = Contour::new();
+                let Point2 { x, y } = shape.outline.first().unwrap().from.as_f32();
+                contour.push_endpoint(vec2f(x, y));
+                for segment in &shape.outline {
+                    let Point2 { x, y } = segment.to.as_f32();
+                    match segment.ctrl {
+                        Some(ctrl) => {
+                            let Point2 { x: ctrl_x, y: ctrl_y } = ctrl.as_f32();
+                            contour.push_quadratic(vec2f(ctrl_x, ctrl_y), vec2f(x, y));
+                        }
+                        None => contour.push_endpoint(vec2f(x, y)),
+                    }
+                }
+                if shape.is_closed() {
+                    contour.close();
+                }
+                path.push_contour(contour);
+            }
+
+            if let PaintOrLine::Line(line) = style_layer.kind() {
+                let mut stroke_to_fill = OutlineStrokeToFill::new(&path, StrokeStyle {
+                    line_width: line.width.as_f32(),
+                    line_cap: line.cap,
+                    line_join: line.join,
+                });
+                stroke_to_fill.offset();
+                path = stroke_to_fill.into_outline();
+            }
+
+            // Transform after stroking, so that moves (which retransform these outlines in
+            // place) compose exactly.
+            path.transform(transform);
+
+            let mut draw_path = DrawPath::new(path, paint_id);
+            draw_path.set_fill_rule(FillRule::EvenOdd);
+            draw_paths.push(draw_path);
+        }
+    }
+    draw_paths
+}
+
+fn matrix_to_transform(matrix: &Matrix) -> Transform2F {
+    Transform2F::row_major(f64::from(matrix.scale_x) as f32,
+                           f64::from(matrix.rotate_skew1) as f32,
+                           Twips(matrix.translate_x).as_f32(),
+                           f64::from(matrix.rotate_skew0) as f32,
+                           f64::from(matrix.scale_y) as f32,
+                           Twips(matrix.translate_y).as_f32())
+}
+
+#[cfg(test)]
+mod tests {
+    use super::Player;
+    use pathfinder_geometry::rect::RectF;
+    use pathfinder_geometry::vector::vec2f;
+    use pathfinder_renderer::scene::{DrawPathId, Scene};
+    use swf_types::fill_styles::Solid;
+    use swf_types::fixed::{Sfixed16P16, Ufixed8P8};
+    use swf_types::shape_records::{Edge, StyleChange};
+    use swf_types::tags::{DefineShape, PlaceObject, RemoveObject};
+    use swf_types::{FillStyle, Header, Matrix, Movie, Rect, Shape, ShapeRecord};
+    use swf_types::{ShapeStyles, StraightSRgba8, Tag, Vector2D};
+
+    // A solid square of the given side length in twips, with a single fill layer.
+    fn define_square(id: u16, side: i32) -> Tag {
+        Tag::DefineShape(DefineShape {
+            id,
+            bounds: Rect { x_min: 0, x_max: side, y_min: 0, y_max: side },
+            edge_bounds: None,
+            has_fill_winding: false,
+            has_non_scaling_strokes: false,
+            has_scaling_strokes: false,
+            shape: Shape {
+                initial_styles: ShapeStyles {
+                    fill: vec![FillStyle::Solid(Solid {
+                        color: StraightSRgba8 { r: 255, g: 0, b: 0, a: 255 },
+                    })],
+                    line: vec![],
+                },
+                records: vec![
+                    ShapeRecord::StyleChange(StyleChange {
+                        move_to: Some(Vector2D { x: 0, y: 0 }),
+                        left_fill: None,
+                        right_fill: Some(1),
+                        line_style: None,
+                        new_styles: None,
+                    }),
+                    edge(side, 0),
+                    edge(0, side),
+                    edge(-side, 0),
+                    edge(0, -side),
+                ],
+            },
+        })
+    }
+
+    fn edge(x: i32, y: i32) -> ShapeRecord {
+        ShapeRecord::Edge(Edge { delta: Vector2D { x, y }, control_delta: None })
+    }
+
+    fn translate(x: i32, y: i32) -> Matrix {
+        Matrix {
+            scale_x: Sfixed16P16::from_value(1.0),
+            scale_y: Sfixed16P16::from_value(1.0),
+            rotate_skew0: Sfixed16P16::from_value(0.0),
+            rotate_skew1: Sfixed16P16::from_value(0.0),
+            translate_x: x,
+            translate_y: y,
+        }
+    }
+
+    fn place(depth: u16, character_id: Option<u16>, is_update: bool, matrix: Option<Matrix>)
+             -> Tag {
+        Tag::PlaceObject(PlaceObject {
+            is_update,
+            depth,
+            character_id,
+            class_name: None,
+            matrix,
+            color_transform: None,
+            ratio: None,
+            name: None,
+            clip_depth: None,
+            filters: None,
+            blend_mode: None,
+            bitmap_cache: None,
+            visible: None,
+            background_color: None,
+            clip_actions: None,
+        })
+    }
+
+    fn movie(tags: Vec<Tag>) -> Movie {
+        Movie {
+            header: Header {
+                swf_version: 6,
+                frame_size: Rect { x_min: 0, x_max: 2000, y_min: 0, y_max: 2000 },
+                frame_rate: Ufixed8P8::from_value(24.0),
+                frame_count: 3,
+            },
+            tags,
+        }
+    }
+
+    #[test]
+    fn place_move_remove() {
+        let movie = movie(vec![
+            define_square(1, 2000),
+            place(1, Some(1), false, Some(translate(0, 0))),
+            Tag::ShowFrame,
+            place(1, None, true, Some(translate(200, 0))),
+            Tag::ShowFrame,
+            Tag::RemoveObject(RemoveObject { character_id: None, depth: 1 }),
+            Tag::ShowFrame,
+        ]);
+
+        let mut scene = Scene::new();
+        let mut player = Player::new(movie.clone());
+
+        // Frame 1: the square is placed at the origin.
+        assert!(player.advance(&mut scene));
+        assert_eq!(scene.draw_path_count(), 1);
+        let bounds = scene.get_draw_path(DrawPathId(0)).outline().bounds();
+        assert_eq!(bounds, RectF::new(vec2f(0.0, 0.0), vec2f(100.0, 100.0)));
+
+        // Frame 2: the move retransforms the existing slot instead of adding paths.
+        assert!(player.advance(&mut scene));
+        assert_eq!(scene.draw_path_count(), 1);
+        let bounds = scene.get_draw_path(DrawPathId(0)).outline().bounds();
+        assert_eq!(bounds, RectF::new(vec2f(10.0, 0.0), vec2f(100.0, 100.0)));
+
+        // Frame 3: removal empties the slot; the ID stays in the scene.
+        assert!(player.advance(&mut scene));
+        assert_eq!(scene.draw_path_count(), 1);
+        assert_eq!(scene.get_draw_path(DrawPathId(0)).outline().bounds(), RectF::default());
+
+        // The stream is exhausted; rewinding loops back to the first frame.
+        assert!(!player.advance(&mut scene));
+        player.rewind(&mut scene);
+        assert!(player.advance(&mut scene));
+        assert_eq!(scene.draw_path_count(), 1);
+        let bounds = scene.get_draw_path(DrawPathId(0)).outline().bounds();
+        assert_eq!(bounds, RectF::new(vec2f(0.0, 0.0), vec2f(100.0, 100.0)));
+    }
+
+    #[test]
+    fn replace_reuses_slot() {
+        let movie = movie(vec![
+            define_square(1, 2000),
+            define_square(2, 1000),
+            place(1, Some(1), false, None),
+            Tag::ShowFrame,
+            place(1, Some(2), true, None),
+            Tag::ShowFrame,
+        ]);
+
+        let mut scene = Scene::new();
+        let mut player = Player::new(movie);
+
+        assert!(player.advance(&mut scene));
+        assert_eq!(scene.draw_path_count(), 1);
+        let bounds = scene.get_draw_path(DrawPathId(0)).outline().bounds();
+        assert_eq!(bounds.size(), vec2f(100.0, 100.0));
+
+        // Replacing the character at this depth reuses its slot rather than growing the scene.
+        assert!(player.advance(&mut scene));
+        assert_eq!(scene.draw_path_count(), 1);
+        let bounds = scene.get_draw_path(DrawPathId(0)).outline().bounds();
+        assert_eq!(bounds.size(), vec2f(50.0, 50.0));
+    }
+}
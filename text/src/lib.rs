@@ -21,9 +21,11 @@ use pathfinder_geometry::line_segment::LineSegment2F;
 use pathfinder_geometry::transform2d::Transform2F;
 use pathfinder_geometry::vector::{Vector2F, vec2f};
 use pathfinder_renderer::paint::PaintId;
-use pathfinder_renderer::scene::{ClipPathId, DrawPath, Scene};
+use pathfinder_renderer::scene::{ClipPathId, DrawPath, Scene, SymbolRenderKey};
 use skribo::{FontCollection, Layout, TextStyle};
 use std::collections::HashMap;
+use std::collections::hash_map::DefaultHasher;
+use std::hash::{Hash, Hasher};
 use std::mem;
 use std::sync::Arc;
 
@@ -152,6 +154,23 @@ impl<F> FontContext<F> where F: Loader {
         path.set_clip_path(render_options.clip_path);
         path.set_blend_mode(render_options.blend_mode);
 
+        // Tag the path with a symbol key identifying the glyph, so that the renderer can share
+        // built tiles among repeated instances of it. The key covers everything that determines
+        // the shape of the glyph up to translation: the font, the glyph ID, and the combined size
+        // and transform.
+        if can_cache_outline {
+            if let (TextRenderMode::Fill, Some(font_key)) =
+                    (render_options.render_mode, font_key) {
+                let mut hasher = DefaultHasher::new();
+                font_key.hash(&mut hasher);
+                glyph_id.hash(&mut hasher);
+                for column in 0..4 {
+                    render_transform.matrix.0[column].to_bits().hash(&mut hasher);
+                }
+                path.set_symbol_key(Some(SymbolRenderKey(hasher.finish())));
+            }
+        }
+
         scene.push_draw_path(path);
         Ok(())
     }